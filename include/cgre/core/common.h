@@ -35,41 +35,196 @@ SOFTWARE.
 
 #include <cgre/math/common.h>
 
+#ifndef CGRE_CACHE_LINE
+#define CGRE_CACHE_LINE 64
+#endif /* ifndef CGRE_CACHE_LINE */
+
+#ifndef CGRE_NODES_PREFETCH
+#define CGRE_NODES_PREFETCH 8
+#endif /* ifndef CGRE_NODES_PREFETCH */
+
+#ifndef CGRE_NODE_LOCKS
+#define CGRE_NODE_LOCKS 64
+#endif /* ifndef CGRE_NODE_LOCKS */
+
+#ifndef CGRE_NODE_POOL_SLAB
+#define CGRE_NODE_POOL_SLAB 1024
+#endif /* ifndef CGRE_NODE_POOL_SLAB */
+
+#ifndef CGRE_NODE_POOL_MAGAZINE
+#define CGRE_NODE_POOL_MAGAZINE 64
+#endif /* ifndef CGRE_NODE_POOL_MAGAZINE */
+
+#ifndef CGRE_NODE_POOL_CACHES
+#define CGRE_NODE_POOL_CACHES 4
+#endif /* ifndef CGRE_NODE_POOL_CACHES */
+
+#ifndef CGRE_EPOCH_BAG
+#define CGRE_EPOCH_BAG 64
+#endif /* ifndef CGRE_EPOCH_BAG */
+
+#ifndef CGRE_EPOCH_THRESHOLD
+#define CGRE_EPOCH_THRESHOLD 128
+#endif /* ifndef CGRE_EPOCH_THRESHOLD */
+
+#ifndef CGRE_EPOCH_CACHES
+#define CGRE_EPOCH_CACHES 4
+#endif /* ifndef CGRE_EPOCH_CACHES */
+
 #define CGRE_NODE(N) (N->value)
 #define CGRE_NODE_KEY_CMP(X, Y) ((X<Y)?-1:(X>Y))
 
 #define CGRE_NODES_MODE(N) (N & 3)
-#define CGRE_NODES_MODE_SET(N, M) ((N & !3) | M)
+#define CGRE_NODES_MODE_SET(N, M) ((N & ~3) | M)
 #define CGRE_NODES_MODE_SET_VALUE(N, M) N = CGRE_NODES_MODE_SET(N, M)
 
 #define CGRE_NODES_LOCK(L) (L & 4)
-#define CGRE_NODES_LOCK_SET(L, R) ((L & !4) | R)
+#define CGRE_NODES_LOCK_SET(L, R) ((L & ~4) | R)
 #define CGRE_NODES_LOCK_FAIL 4
 #define CGRE_NODES_LOCK_SET_FAIL(N) N = CGRE_NODES_LOCK_SET(N, CGRE_NODES_LOCK_FAIL)
 
+#define CGRE_LOCK_MUTEX 0
+#define CGRE_LOCK_FUTEX 16
+#define CGRE_LOCK_SPIN 32
+#define CGRE_LOCK_NONE 48
+
+#ifndef CGRE_LOCK_DEFAULT
+#define CGRE_LOCK_DEFAULT CGRE_LOCK_MUTEX
+#endif /* ifndef CGRE_LOCK_DEFAULT */
+
+#ifndef CGRE_LOCK_SPINS
+#define CGRE_LOCK_SPINS 100
+#endif /* ifndef CGRE_LOCK_SPINS */
+
+#define CGRE_NODES_LOCK_POLICY(N) (N & 48)
+
 struct cgre_node {
     void* value;
     struct cgre_node* link[3];
     cgre_uint_t key;
+#ifdef CGRE_NODE_COMPACT
+    cgre_uint_t dir;
+#else
     cgre_uint_t mode;
     cgre_uint_t state;
     cgre_uint_t dir;
     pthread_mutex_t lock;
+#endif /* ifdef CGRE_NODE_COMPACT */
 };
 
 #define CGRE_NODE_HEAD 0
 #define CGRE_NODE_MIDDLE 1
 #define CGRE_NODE_TAIL 2
 
+struct cgre_node_store {
+    struct cgre_node_store* next;
+    cgre_uint_t size;
+    cgre_uint_t used;
+};
+
+union cgre_lock {
+#if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX
+    pthread_mutex_t mutex;
+#endif /* if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX */
+    uint32_t word;
+};
+
 struct cgre_node_set {
     struct cgre_node* link[3];
+    struct cgre_node_store* store;
+    struct cgre_node* finger;
     cgre_uint_t count;
     cgre_uint_t state;
+    cgre_uint_t sequence;
+    union cgre_lock lock;
+};
+
+struct cgre_array_cursor {
+    struct cgre_node_set* array;
+    struct cgre_node* node;
+    cgre_uint_t index;
+};
+
+struct cgre_node_pool {
+    struct cgre_node_store* store;
+    struct cgre_node* free;
+    cgre_uint_t state;
+    cgre_uint_t sequence;
     pthread_mutex_t lock;
 };
 
+struct cgre_epoch_record;
+
+struct cgre_epoch {
+    cgre_uint_t epoch;
+    struct cgre_epoch_record* records;
+    void (*release)(void* context, struct cgre_node* node);
+    void* context;
+    cgre_uint_t state;
+    cgre_uint_t sequence;
+};
+
+struct cgre_shard;
+
+struct cgre_shard_map {
+    struct cgre_shard* shard;
+    cgre_uint_t size;
+    cgre_uint_t state;
+};
+
+cgre_uint_t cgre_epoch_collect(
+        struct cgre_epoch* epoch);
+
+struct cgre_epoch* cgre_epoch_enter(
+        struct cgre_epoch* epoch);
+
+struct cgre_epoch* cgre_epoch_initialize(
+        struct cgre_epoch* epoch,
+        void (*release)(void* context, struct cgre_node* node),
+        void* context);
+
+void cgre_epoch_leave(
+        struct cgre_epoch* epoch);
+
+struct cgre_node* cgre_epoch_retire(
+        struct cgre_epoch* epoch,
+        struct cgre_node* node);
+
+struct cgre_epoch* cgre_epoch_uninitialize(
+        struct cgre_epoch* epoch);
+
 cgre_uint_t cgre_hash(void* key);
 
+uint64_t cgre_hash_bytes(
+        const void* data,
+        size_t length,
+        uint64_t seed);
+
+cgre_int_t cgre_lock_wait(
+        uint32_t* word,
+        cgre_uint_t policy);
+
+void cgre_lock_wake(
+        uint32_t* word);
+
+pthread_mutex_t* cgre_node_lock(
+        struct cgre_node* node);
+
+struct cgre_node* cgre_node_pool_alloc(
+        struct cgre_node_pool* pool,
+        cgre_uint_t key,
+        void* value);
+
+void cgre_node_pool_free(
+        struct cgre_node_pool* pool,
+        struct cgre_node* node);
+
+struct cgre_node_pool* cgre_node_pool_initialize(
+        struct cgre_node_pool* pool);
+
+struct cgre_node_pool* cgre_node_pool_uninitialize(
+        struct cgre_node_pool* pool);
+
 struct cgre_node* cgre_node_initialize(
         struct cgre_node* node,
         cgre_uint_t key,
@@ -78,9 +233,54 @@ struct cgre_node* cgre_node_initialize(
 struct cgre_node_set* cgre_node_set_initialize(
         struct cgre_node_set* set);
 
+struct cgre_node_set* cgre_node_set_initialize_lock(
+        struct cgre_node_set* set,
+        cgre_uint_t policy);
+
 struct cgre_node_set* cgre_node_set_uninitialize(
         struct cgre_node_set* set);
 
+static inline cgre_int_t cgre_node_set_lock(
+        struct cgre_node_set* set)
+{
+    cgre_uint_t policy = CGRE_NODES_LOCK_POLICY(set->state);
+    if (policy == CGRE_LOCK_NONE) {
+        return 0;
+    }
+#if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX
+    if (policy == CGRE_LOCK_MUTEX) {
+        return pthread_mutex_lock(&(set->lock.mutex));
+    }
+#endif /* if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX */
+    uint32_t unlocked = 0;
+    if (__atomic_compare_exchange_n(&(set->lock.word), &unlocked, 1, 0,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    return cgre_lock_wait(&(set->lock.word), policy);
+}
+
+static inline cgre_int_t cgre_node_set_unlock(
+        struct cgre_node_set* set)
+{
+    cgre_uint_t policy = CGRE_NODES_LOCK_POLICY(set->state);
+    if (policy == CGRE_LOCK_NONE) {
+        return 0;
+    }
+#if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX
+    if (policy == CGRE_LOCK_MUTEX) {
+        return pthread_mutex_unlock(&(set->lock.mutex));
+    }
+#endif /* if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX */
+    if (policy == CGRE_LOCK_SPIN) {
+        __atomic_store_n(&(set->lock.word), 0, __ATOMIC_RELEASE);
+    } else if (__atomic_exchange_n(&(set->lock.word), 0,
+                __ATOMIC_RELEASE) == 2) {
+        cgre_lock_wake(&(set->lock.word));
+    }
+    return 0;
+}
+
 void* cgre_node_uninitialize(
         struct cgre_node* node);
 
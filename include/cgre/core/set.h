@@ -37,9 +37,98 @@ SOFTWARE.
 #define CGRE_LIST_MODE_DEFAULT 1
 #endif /* ifndef CGRE_LIST_MODE_DEFAULT */
 
-#ifndef CGRE_TREE_MAX_HEIGHT
-#define CGRE_TREE_MAX_HEIGHT 18
-#endif /* ifndef CGRE_TREE_MAX_HEIGHT */
+#define CGRE_ARRAY_LINKED 1
+#define CGRE_ARRAY_VECTOR 2
+
+#ifndef CGRE_ARRAY_MODE_DEFAULT
+#define CGRE_ARRAY_MODE_DEFAULT CGRE_ARRAY_LINKED
+#endif /* ifndef CGRE_ARRAY_MODE_DEFAULT */
+
+#define CGRE_ARRAY_MODE(N) (CGRE_NODES_MODE(N) ? \
+        CGRE_NODES_MODE(N) : CGRE_ARRAY_MODE_DEFAULT)
+
+#ifndef CGRE_ARRAY_VECTOR_MIN_SIZE
+#define CGRE_ARRAY_VECTOR_MIN_SIZE 16
+#endif /* ifndef CGRE_ARRAY_VECTOR_MIN_SIZE */
+
+#define CGRE_ARRAY_CURSOR_BEFORE ((cgre_uint_t) -1)
+
+#define CGRE_HASH_LIST_SORTED 1
+#define CGRE_HASH_LIST_TABLE 2
+#define CGRE_HASH_LIST_SKIP 3
+
+#ifndef CGRE_HASH_LIST_MODE_DEFAULT
+#define CGRE_HASH_LIST_MODE_DEFAULT CGRE_HASH_LIST_SORTED
+#endif /* ifndef CGRE_HASH_LIST_MODE_DEFAULT */
+
+#define CGRE_HASH_LIST_MODE(N) (CGRE_NODES_MODE(N) ? \
+        CGRE_NODES_MODE(N) : CGRE_HASH_LIST_MODE_DEFAULT)
+
+#ifndef CGRE_HASH_SKIP_LEVELS
+#define CGRE_HASH_SKIP_LEVELS 16
+#endif /* ifndef CGRE_HASH_SKIP_LEVELS */
+
+#ifndef CGRE_HASH_TABLE_MIN_SIZE
+#define CGRE_HASH_TABLE_MIN_SIZE 16
+#endif /* ifndef CGRE_HASH_TABLE_MIN_SIZE */
+
+#ifndef CGRE_HASH_TABLE_DRAIN
+#define CGRE_HASH_TABLE_DRAIN 8
+#endif /* ifndef CGRE_HASH_TABLE_DRAIN */
+
+#ifndef CGRE_HEAP_ARITY
+#define CGRE_HEAP_ARITY 4
+#endif /* ifndef CGRE_HEAP_ARITY */
+
+#ifndef CGRE_HEAP_MIN_SIZE
+#define CGRE_HEAP_MIN_SIZE 16
+#endif /* ifndef CGRE_HEAP_MIN_SIZE */
+
+#define CGRE_QUEUE_LOCKED 1
+#define CGRE_QUEUE_RING 2
+#define CGRE_QUEUE_SPSC 3
+
+#define CGRE_QUEUE_MODE(N) (CGRE_NODES_MODE(N) ? \
+        CGRE_NODES_MODE(N) : CGRE_QUEUE_LOCKED)
+
+#ifndef CGRE_SHARD_MAP_SIZE
+#define CGRE_SHARD_MAP_SIZE 64
+#endif /* ifndef CGRE_SHARD_MAP_SIZE */
+
+#define CGRE_STACK_LOCKED 1
+#define CGRE_STACK_TREIBER 2
+
+#define CGRE_STACK_MODE(N) (CGRE_NODES_MODE(N) ? \
+        CGRE_NODES_MODE(N) : CGRE_STACK_LOCKED)
+
+#define CGRE_TREE_MAX_HEIGHT (16 * sizeof(cgre_uint_t) + 2)
+
+#define CGRE_TREE_LOCKED 1
+#define CGRE_TREE_OPTIMISTIC 2
+#define CGRE_TREE_BTREE 3
+
+#define CGRE_TREE_MODE(N) (CGRE_NODES_MODE(N) ? \
+        CGRE_NODES_MODE(N) : CGRE_TREE_LOCKED)
+
+#ifndef CGRE_TREE_OPTIMISTIC_RETRIES
+#define CGRE_TREE_OPTIMISTIC_RETRIES 8
+#endif /* ifndef CGRE_TREE_OPTIMISTIC_RETRIES */
+
+#ifndef CGRE_TREE_BTREE_ORDER
+#define CGRE_TREE_BTREE_ORDER 32
+#endif /* ifndef CGRE_TREE_BTREE_ORDER */
+
+#ifndef CGRE_TREE_BUILD_PARALLEL
+#define CGRE_TREE_BUILD_PARALLEL 65536
+#endif /* ifndef CGRE_TREE_BUILD_PARALLEL */
+
+#ifndef CGRE_TREE_BUILD_THREADS
+#define CGRE_TREE_BUILD_THREADS 8
+#endif /* ifndef CGRE_TREE_BUILD_THREADS */
+
+#define CGRE_TREE_RANKED 8
+
+#define CGRE_TREE_BTREE_MAX_HEIGHT (8 * sizeof(cgre_uint_t) + 1)
 
 #define CGRE_TREE_RED 1
 #define CGRE_TREE_BLACK 2
@@ -53,6 +142,16 @@ struct cgre_node* cgre_array_add(
         struct cgre_node_set* array,
         struct cgre_node* node);
 
+struct cgre_node* cgre_array_cursor_begin(
+        struct cgre_array_cursor* cursor,
+        struct cgre_node_set* array);
+
+struct cgre_node* cgre_array_cursor_next(
+        struct cgre_array_cursor* cursor);
+
+struct cgre_node* cgre_array_cursor_prev(
+        struct cgre_array_cursor* cursor);
+
 struct cgre_node* cgre_array_delete(
         struct cgre_node_set* array,
         cgre_uint_t index);
@@ -66,6 +165,20 @@ struct cgre_node* cgre_array_set(
         struct cgre_node* node,
         cgre_uint_t index);
 
+struct cgre_node* cgre_deque_pop(
+        struct cgre_node_set* deque);
+
+struct cgre_node* cgre_deque_push(
+        struct cgre_node_set* deque,
+        struct cgre_node* node);
+
+struct cgre_node_set* cgre_deque_reserve(
+        struct cgre_node_set* deque,
+        cgre_uint_t size);
+
+struct cgre_node* cgre_deque_steal(
+        struct cgre_node_set* deque);
+
 struct cgre_node* cgre_hash_list_delete(
         struct cgre_node_set* list,
         cgre_uint_t key);
@@ -74,6 +187,11 @@ struct cgre_node* cgre_hash_list_insert(
         struct cgre_node_set* list,
         struct cgre_node* node);
 
+cgre_uint_t cgre_hash_list_insert_many(
+        struct cgre_node_set* list,
+        struct cgre_node** nodes,
+        cgre_uint_t count);
+
 struct cgre_node* cgre_hash_list_replace(
         struct cgre_node_set* list,
         struct cgre_node* node);
@@ -82,16 +200,73 @@ struct cgre_node* cgre_hash_list_search(
         struct cgre_node_set* list,
         cgre_uint_t key);
 
+struct cgre_node_set* cgre_heap_build(
+        struct cgre_node_set* heap,
+        struct cgre_node** nodes,
+        cgre_uint_t count);
+
+struct cgre_node* cgre_heap_decrease(
+        struct cgre_node_set* heap,
+        struct cgre_node* node,
+        cgre_uint_t key);
+
+struct cgre_node* cgre_heap_peek(
+        struct cgre_node_set* heap);
+
+struct cgre_node* cgre_heap_pop(
+        struct cgre_node_set* heap);
+
+struct cgre_node* cgre_heap_push(
+        struct cgre_node_set* heap,
+        struct cgre_node* node);
+
 struct cgre_node* cgre_queue_push(
         struct cgre_node_set* queue,
         struct cgre_node* node);
 
+cgre_uint_t cgre_queue_push_many(
+        struct cgre_node_set* queue,
+        struct cgre_node** nodes,
+        cgre_uint_t count);
+
 struct cgre_node* cgre_queue_pop(
         struct cgre_node_set* queue);
 
+cgre_uint_t cgre_queue_pop_many(
+        struct cgre_node_set* queue,
+        struct cgre_node** nodes,
+        cgre_uint_t count);
+
 struct cgre_node* cgre_queue_peek(
         struct cgre_node_set* queue);
 
+struct cgre_node_set* cgre_queue_reserve(
+        struct cgre_node_set* queue,
+        cgre_uint_t size);
+
+struct cgre_node* cgre_shard_map_delete(
+        struct cgre_shard_map* map,
+        cgre_uint_t key);
+
+struct cgre_shard_map* cgre_shard_map_initialize(
+        struct cgre_shard_map* map,
+        cgre_uint_t size);
+
+struct cgre_node* cgre_shard_map_insert(
+        struct cgre_shard_map* map,
+        struct cgre_node* node);
+
+struct cgre_node* cgre_shard_map_replace(
+        struct cgre_shard_map* map,
+        struct cgre_node* node);
+
+struct cgre_node* cgre_shard_map_search(
+        struct cgre_shard_map* map,
+        cgre_uint_t key);
+
+struct cgre_shard_map* cgre_shard_map_uninitialize(
+        struct cgre_shard_map* map);
+
 struct cgre_node* cgre_stack_push(
         struct cgre_node_set* stack,
         struct cgre_node* node);
@@ -102,6 +277,11 @@ struct cgre_node* cgre_stack_pop(
 struct cgre_node* cgre_stack_peek(
         struct cgre_node_set* stack);
 
+struct cgre_node_set* cgre_tree_build(
+        struct cgre_node_set* tree,
+        struct cgre_node** nodes,
+        cgre_uint_t count);
+
 struct cgre_node* cgre_tree_delete(
         struct cgre_node_set* tree,
         cgre_uint_t key);
@@ -110,6 +290,21 @@ struct cgre_node* cgre_tree_insert(
         struct cgre_node_set* tree,
         struct cgre_node* node);
 
+struct cgre_node* cgre_tree_lower_bound(
+        struct cgre_node_set* tree,
+        cgre_uint_t key);
+
+cgre_uint_t cgre_tree_range(
+        struct cgre_node_set* tree,
+        cgre_uint_t low,
+        cgre_uint_t high,
+        struct cgre_node** members,
+        cgre_uint_t size);
+
+cgre_uint_t cgre_tree_rank(
+        struct cgre_node_set* tree,
+        cgre_uint_t key);
+
 struct cgre_node* cgre_tree_replace(
         struct cgre_node_set* tree,
         struct cgre_node* node);
@@ -118,4 +313,18 @@ struct cgre_node* cgre_tree_search(
         struct cgre_node_set* tree,
         cgre_uint_t key);
 
+cgre_uint_t cgre_tree_search_many(
+        struct cgre_node_set* tree,
+        const cgre_uint_t* keys,
+        struct cgre_node** found,
+        cgre_uint_t count);
+
+struct cgre_node* cgre_tree_select(
+        struct cgre_node_set* tree,
+        cgre_uint_t index);
+
+struct cgre_node* cgre_tree_upper_bound(
+        struct cgre_node_set* tree,
+        cgre_uint_t key);
+
 #endif /* ifndef _CGRE_CORE_SET_H_ */
@@ -28,21 +28,564 @@ SOFTWARE.
 ===============================================================================
 */
 
+#include <getopt.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "cgre-clockperf.h"
 
+#define M CLOCKPERF_MATH
+#define C CLOCKPERF_CGRE
+#define N CLOCKPERF_NODE
+
+/*
+ * Every counter with the operations one call runs and the profiles it
+ * belongs to. The cgre profile samples the counters most often slow.
+ */
+static const struct clockperf_counter counters[] = {
+    TIMING (cgre_base_atan2_10k, 1e4, M),
+    TIMING (cgre_real_clamp_10k, 1e4, M),
+    TIMING (cgre_vec2_angle_between_10k, 1e4, M),
+    TIMING (cgre_vec2_oriented_angle_between_10k, 1e4, M),
+    TIMING (cgre_tree_insert_10k, 1e4, N),
+
+    TIMING (cgre_base_atan2_100k, 1e5, M | C),
+    TIMING (cgre_real_clamp_100k, 1e5, M),
+    TIMING (cgre_vec2_angle_between_100k, 1e5, M | C),
+    TIMING (cgre_vec2_oriented_angle_between_100k, 1e5, M | C),
+    TIMING (cgre_tree_insert_100k, 1e5, N),
+
+    TIMING (cgre_tree_insert_1m, 1e6, N | C),
+    TIMING (cgre_tree_insert_10m, 1e7, N),
+    TIMING (cgre_tree_delete_1m, 1e6, N | C),
+    TIMING (cgre_tree_delete_10m, 1e7, N),
+    TIMING (cgre_tree_build_1m, 1e6, N | C),
+    TIMING (cgre_tree_build_10m, 1e7, N),
+    TIMING (cgre_tree_insert_sorted_1m, 1e6, N),
+    TIMING (cgre_tree_build_sorted_1m, 1e6, N),
+
+    TIMING (cgre_queue_locked_contention_1t, 1e5, N),
+    TIMING (cgre_queue_locked_contention_2t, 2e5, N),
+    TIMING (cgre_queue_locked_contention_4t, 4e5, N | C),
+    TIMING (cgre_queue_locked_contention_8t, 8e5, N),
+    TIMING (cgre_queue_ring_contention_1t, 1e5, N),
+    TIMING (cgre_queue_ring_contention_2t, 2e5, N),
+    TIMING (cgre_queue_ring_contention_4t, 4e5, N | C),
+    TIMING (cgre_queue_ring_contention_8t, 8e5, N),
+
+    TIMING (cgre_tree_search_locked_1t, 1e5, N),
+    TIMING (cgre_tree_search_locked_2t, 2e5, N),
+    TIMING (cgre_tree_search_locked_4t, 4e5, N | C),
+    TIMING (cgre_tree_search_locked_8t, 8e5, N),
+    TIMING (cgre_tree_search_optimistic_1t, 1e5, N),
+    TIMING (cgre_tree_search_optimistic_2t, 2e5, N),
+    TIMING (cgre_tree_search_optimistic_4t, 4e5, N | C),
+    TIMING (cgre_tree_search_optimistic_8t, 8e5, N),
+    TIMING (cgre_tree_search_btree_1t, 1e5, N),
+    TIMING (cgre_tree_search_btree_2t, 2e5, N),
+    TIMING (cgre_tree_search_btree_4t, 4e5, N | C),
+    TIMING (cgre_tree_search_btree_8t, 8e5, N),
+    TIMING (cgre_tree_search_locked_1m, 1e5, N | C),
+    TIMING (cgre_tree_search_btree_1m, 1e5, N | C),
+
+    TIMING (cgre_tree_search_each_100k, 1e5, N),
+    TIMING (cgre_tree_search_many_100k, 1e5, N),
+    TIMING (cgre_hash_list_insert_each_100k, 1e5, N),
+    TIMING (cgre_hash_list_insert_many_100k, 1e5, N),
+    TIMING (cgre_queue_push_each_100k, 1e5, N),
+    TIMING (cgre_queue_push_many_100k, 1e5, N),
+
+    TIMING (cgre_hash_legacy_names_1m, 1e6, N),
+    TIMING (cgre_hash_names_1m, 1e6, N | C),
+    TIMING (cgre_hash_legacy_buffer_64m, 64.0 * 1024 * 1024, N),
+    TIMING (cgre_hash_bytes_buffer_64m, 64.0 * 1024 * 1024, N),
+    TALLY (cgre_hash_legacy_collisions_1m, N),
+    TALLY (cgre_hash_collisions_1m, N),
+
+    TIMING (cgre_hash_list_contention_1t, 2e5, N),
+    TIMING (cgre_hash_list_contention_2t, 4e5, N),
+    TIMING (cgre_hash_list_contention_4t, 8e5, N | C),
+    TIMING (cgre_hash_list_contention_8t, 1.6e6, N),
+    TIMING (cgre_shard_map_contention_1t, 2e5, N),
+    TIMING (cgre_shard_map_contention_2t, 4e5, N),
+    TIMING (cgre_shard_map_contention_4t, 8e5, N | C),
+    TIMING (cgre_shard_map_contention_8t, 1.6e6, N),
+
+    TALLY (cgre_node_footprint_1m, N),
+    TIMING (cgre_node_footprint_search_1m, 1e6, N),
+    TIMING (cgre_node_footprint_scan_1m, 1e6, N),
+
+    TIMING (cgre_node_malloc_1m, 1e6, N),
+    TIMING (cgre_node_pool_alloc_1m, 1e6, N | C),
+    TIMING (cgre_tree_search_malloc_1m, 1e6, N),
+    TIMING (cgre_tree_search_pool_1m, 1e6, N),
+
+    TIMING (cgre_array_iterate_legacy_10k, 1e4, N),
+    TIMING (cgre_array_iterate_get_10k, 1e4, N),
+    TIMING (cgre_array_iterate_cursor_10k, 1e4, N),
+    TIMING (cgre_array_iterate_legacy_100k, 1e5, N),
+    TIMING (cgre_array_iterate_get_100k, 1e5, N),
+    TIMING (cgre_array_iterate_cursor_100k, 1e5, N | C),
+
+    TIMING (cgre_queue_locked_transfer_1m, 1e6, N),
+    TIMING (cgre_queue_ring_transfer_1m, 1e6, N),
+    TIMING (cgre_queue_spsc_transfer_1m, 1e6, N | C),
+    TIMING (cgre_queue_locked_transfer_batch_1m, 1e6, N),
+    TIMING (cgre_queue_spsc_transfer_batch_1m, 1e6, N),
+
+    TIMING (cgre_lock_mutex_uncontended_10m, 1e7, N | C),
+    TIMING (cgre_lock_futex_uncontended_10m, 1e7, N),
+    TIMING (cgre_lock_spin_uncontended_10m, 1e7, N),
+    TIMING (cgre_lock_none_uncontended_10m, 1e7, N),
+    TIMING (cgre_lock_mutex_contended_4t, 4e6, N),
+    TIMING (cgre_lock_futex_contended_4t, 4e6, N),
+    TIMING (cgre_lock_spin_contended_4t, 4e6, N),
+
+    SCALING ("cgre_tree_insert", cgre_tree_insert_scaling,
+            CLOCKPERF_DISTINCT, 10000000, N),
+    SCALING ("cgre_tree_search", cgre_tree_search_scaling,
+            CLOCKPERF_PATTERNS, 10000000, N),
+    SCALING ("cgre_tree_delete", cgre_tree_delete_scaling,
+            CLOCKPERF_DISTINCT, 10000000, N),
+    SCALING ("cgre_hash_list_insert", cgre_hash_list_insert_scaling,
+            CLOCKPERF_DISTINCT, 10000000, N),
+    SCALING ("cgre_hash_list_search", cgre_hash_list_search_scaling,
+            CLOCKPERF_PATTERNS, 10000000, N),
+    SCALING ("cgre_shard_map_insert", cgre_shard_map_insert_scaling,
+            CLOCKPERF_DISTINCT, 10000000, N),
+    SCALING ("cgre_shard_map_search", cgre_shard_map_search_scaling,
+            CLOCKPERF_PATTERNS, 10000000, N),
+    // Gets walk the list, random ones past 10k take seconds each
+    SCALING ("cgre_array_get", cgre_array_get_scaling,
+            CLOCKPERF_PATTERNS, 10000, N),
+    SCALING ("cgre_array_vector_get", cgre_array_vector_get_scaling,
+            CLOCKPERF_PATTERNS, 10000000, N),
+    SCALING ("cgre_heap_push_pop", cgre_heap_scaling,
+            CLOCKPERF_PATTERNS, 10000000, N),
+    SCALING ("cgre_queue_push_pop", cgre_queue_scaling,
+            CLOCKPERF_SEQUENTIAL, 10000000, N),
+    SCALING ("cgre_stack_push_pop", cgre_stack_scaling,
+            CLOCKPERF_SEQUENTIAL, 10000000, N),
+    SCALING ("cgre_deque_push_pop", cgre_deque_scaling,
+            CLOCKPERF_SEQUENTIAL, 10000000, N),
+};
+
+#undef M
+#undef C
+#undef N
+
+static const struct {
+    const char* name;
+    unsigned int mask;
+} profiles[] = {
+    {"math", CLOCKPERF_MATH},
+    {"cgre", CLOCKPERF_CGRE},
+    {"scene", CLOCKPERF_SCENE},
+    {"node", CLOCKPERF_NODE},
+    {"render", CLOCKPERF_RENDER},
+    {"all", CLOCKPERF_ALL},
+};
+
+/* At least this many samples are taken, whatever the time budget */
+#define CLOCKPERF_MIN_SAMPLES 5
+
+/* Scaling counters start at this many members */
+#define CLOCKPERF_SMALLEST 1000
+
+struct clockperf_options {
+    int json;
+    const char* profile;
+    unsigned int mask;
+    unsigned int warmup;
+    unsigned int repetitions;
+    double budget;
+    cgre_uint_t largest;
+    int events;
+};
+
+struct clockperf_stats {
+    unsigned int samples;
+    double min;
+    double median;
+    double p95;
+    double p99;
+    double max;
+    double mean;
+    double stddev;
+    // Per operation, over every sample
+    double events[CLOCKPERF_EVENTS];
+};
+
+static int clockperf_compare(const void* first, const void* second)
+{
+    clock_t a = *(const clock_t*) first;
+    clock_t b = *(const clock_t*) second;
+    return (a > b) - (a < b);
+}
+
+/* Nearest rank, so every percentile is a time that was actually measured */
+static double clockperf_percentile(const clock_t* sorted, unsigned int count,
+        double percent)
+{
+    unsigned int rank = (unsigned int) ceil(percent / 100.0 * count);
+    return (double) sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void clockperf_summarize(clock_t* samples, unsigned int count,
+        struct clockperf_stats* stats)
+{
+    double sum = 0.0, squares = 0.0;
+    qsort(samples, count, sizeof(clock_t), clockperf_compare);
+    for (unsigned int idx = 0; idx < count; idx++) {
+        sum += (double) samples[idx];
+    }
+    stats->samples = count;
+    stats->mean = sum / count;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        double delta = (double) samples[idx] - stats->mean;
+        squares += delta * delta;
+    }
+    stats->stddev = count > 1 ? sqrt(squares / (count - 1)) : 0.0;
+    stats->min = (double) samples[0];
+    stats->max = (double) samples[count - 1];
+    stats->median = (count & 1) ? (double) samples[count / 2] :
+        ((double) samples[count / 2 - 1] + (double) samples[count / 2]) / 2;
+    stats->p95 = clockperf_percentile(samples, count, 95.0);
+    stats->p99 = clockperf_percentile(samples, count, 99.0);
+}
+
+/* Runs a counter once, sized or not */
+static clock_t clockperf_call(const struct clockperf_counter* counter)
+{
+    if (counter->scaled != NULL) {
+        return counter->scaled(counter->count, counter->patterns);
+    }
+    return counter->run();
+}
+
+/*
+ * Warms up, then samples until the repetitions are done or the time budget
+ * is spent, whichever comes first.
+ */
+static void clockperf_measure(const struct clockperf_counter* counter,
+        const struct clockperf_options* options, clock_t* samples,
+        struct clockperf_stats* stats)
+{
+    unsigned int count = 0;
+    for (unsigned int idx = 0; idx < options->warmup; idx++) {
+        clockperf_call(counter);
+    }
+    clock_t deadline = clockperf_now() +
+        (clock_t) (options->budget * 1000000000.0);
+    clockperf_events_reset();
+    clockperf_events_armed = options->events;
+    while (count < options->repetitions) {
+        samples[count++] = clockperf_call(counter);
+        clockperf_events_settle();
+        if (count >= CLOCKPERF_MIN_SAMPLES && clockperf_now() > deadline) {
+            break;
+        }
+    }
+    clockperf_events_armed = 0;
+    clockperf_summarize(samples, count, stats);
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        stats->events[event] = clockperf_events_total(event) /
+            (counter->ops * count);
+    }
+}
+
+/* Instructions per cycle, or 0 without both events */
+static double clockperf_ipc(const struct clockperf_stats* stats)
+{
+    if (!clockperf_event_available(0) || !clockperf_event_available(1) ||
+            stats->events[0] <= 0.0) {
+        return 0.0;
+    }
+    return stats->events[1] / stats->events[0];
+}
+
+static void clockperf_print_text(const struct clockperf_counter* counter,
+        const struct clockperf_stats* stats, clock_t tally)
+{
+    if (counter->kind == CLOCKPERF_TALLY) {
+        printf("%s : %ld\n", counter->name, (long) tally);
+        return;
+    }
+    printf("%s : %.2f ns/op, median %.0f ns, p95 %.0f ns, p99 %.0f ns, "
+            "stddev %.0f ns (%.1f%%), n %u\n", counter->name,
+            stats->median / counter->ops, stats->median, stats->p95,
+            stats->p99, stats->stddev,
+            stats->mean > 0 ? 100.0 * stats->stddev / stats->mean : 0.0,
+            stats->samples);
+    const char* separator = "   ";
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        if (clockperf_event_available(event)) {
+            printf("%s %s %.3f/op", separator, clockperf_event_name(event),
+                    stats->events[event]);
+            separator = ",";
+        }
+    }
+    if (clockperf_ipc(stats) > 0.0) {
+        printf(", ipc %.2f", clockperf_ipc(stats));
+    }
+    if (separator[0] == ',') {
+        printf("\n");
+    }
+}
+
+static void clockperf_print_json(const struct clockperf_counter* counter,
+        const struct clockperf_stats* stats, clock_t tally, int first)
+{
+    printf("%s\n    {" JSON_MAP_MEMBER("name", "%s") ",", first ? "" : ",",
+            counter->name);
+    if (counter->kind == CLOCKPERF_TALLY) {
+        printf(JSON_MAP_MEMBER("kind", "tally") ","
+                JSON_MAP_NUMBER("value", "%ld") "}", (long) tally);
+        return;
+    }
+    if (counter->scaled != NULL) {
+        printf(JSON_MAP_MEMBER("pattern", "%s") ","
+                JSON_MAP_NUMBER("members", "%lu") ",",
+                clockperf_pattern_name(counter->patterns),
+                (unsigned long) counter->count);
+    }
+    printf(JSON_MAP_MEMBER("kind", "timing") ","
+            JSON_MAP_NUMBER("ops", "%.0f") ","
+            JSON_MAP_NUMBER("samples", "%u") ","
+            JSON_MAP_NUMBER("ns_per_op", "%.4f") ","
+            JSON_MAP_NUMBER("min_ns", "%.0f") ","
+            JSON_MAP_NUMBER("median_ns", "%.0f") ","
+            JSON_MAP_NUMBER("p95_ns", "%.0f") ","
+            JSON_MAP_NUMBER("p99_ns", "%.0f") ","
+            JSON_MAP_NUMBER("max_ns", "%.0f") ","
+            JSON_MAP_NUMBER("mean_ns", "%.1f") ","
+            JSON_MAP_NUMBER("stddev_ns", "%.1f"),
+            counter->ops, stats->samples, stats->median / counter->ops,
+            stats->min, stats->median, stats->p95, stats->p99, stats->max,
+            stats->mean, stats->stddev);
+    int opened = 0;
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        if (!clockperf_event_available(event)) {
+            continue;
+        }
+        printf("%s\"%s_per_op\":%.4f", opened++ ? "," : ",\"events\":{",
+                clockperf_event_name(event), stats->events[event]);
+    }
+    if (opened) {
+        if (clockperf_ipc(stats) > 0.0) {
+            printf("," JSON_MAP_NUMBER("ipc", "%.4f"), clockperf_ipc(stats));
+        }
+        printf("}");
+    }
+    printf("}");
+}
+
+static void clockperf_report(const struct clockperf_counter* counter,
+        const struct clockperf_options* options, clock_t* samples,
+        int* first)
+{
+    struct clockperf_stats stats = {0};
+    clock_t tally = 0;
+    if (counter->kind == CLOCKPERF_TALLY) {
+        tally = counter->run();
+    } else {
+        clockperf_measure(counter, options, samples, &stats);
+    }
+    if (options->json) {
+        clockperf_print_json(counter, &stats, tally, *first);
+    } else {
+        clockperf_print_text(counter, &stats, tally);
+    }
+    fflush(stdout);
+    *first = 0;
+}
+
+/* Runs a scaling counter as a timing of one pattern and member count */
+static void clockperf_report_scaled(const struct clockperf_counter* counter,
+        int pattern, cgre_uint_t count,
+        const struct clockperf_options* options, clock_t* samples,
+        int* first)
+{
+    static const char* sizes[] = {"1k", "10k", "100k", "1m", "10m"};
+    char name[128];
+    int size = 0;
+    for (cgre_uint_t scale = CLOCKPERF_SMALLEST * 10; scale <= count;
+            scale *= 10) {
+        size++;
+    }
+    snprintf(name, sizeof(name), "%s_%s_%s", counter->name,
+            clockperf_pattern_name(pattern), sizes[size]);
+    struct clockperf_counter timing = *counter;
+    timing.name = name;
+    timing.ops = count;
+    timing.kind = CLOCKPERF_TIMING;
+    timing.patterns = pattern;
+    timing.count = count;
+    clockperf_report(&timing, options, samples, first);
+}
+
+static void clockperf_usage(FILE* stream)
+{
+    fprintf(stream,
+            "Usage: cgre-clockperf [OPTIONS]\n"
+            "  -j, --json             print the results in JSON\n"
+            "  -p, --pattern=PROFILE  math, cgre (default), scene, node, "
+            "render or all\n"
+            "  -r, --repetitions=N    samples per counter at most (20)\n"
+            "  -w, --warmup=N         discarded runs per counter (1)\n"
+            "  -t, --time=SECONDS     time budget per counter (2)\n"
+            "  -n, --size=N           largest member count of the scaling "
+            "counters (1e7)\n"
+            "  -E, --no-events        leave the hardware counters closed\n"
+            "  -h, --help             print this help\n");
+}
+
+static int clockperf_options(int argc, char** argv,
+        struct clockperf_options* options)
+{
+    static const struct option longs[] = {
+        {"json", no_argument, NULL, 'j'},
+        {"pattern", required_argument, NULL, 'p'},
+        {"profile", required_argument, NULL, 'p'},
+        {"repetitions", required_argument, NULL, 'r'},
+        {"warmup", required_argument, NULL, 'w'},
+        {"time", required_argument, NULL, 't'},
+        {"size", required_argument, NULL, 'n'},
+        {"no-events", no_argument, NULL, 'E'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    int option;
+    options->json = 0;
+    options->profile = "cgre";
+    options->warmup = 1;
+    options->repetitions = 20;
+    options->budget = 2.0;
+    options->largest = 10000000;
+    options->events = 1;
+    while ((option = getopt_long(argc, argv, "jp:r:w:t:n:Eh", longs, NULL))
+            != -1) {
+        switch (option) {
+        case 'j':
+            options->json = 1;
+            break;
+        case 'p':
+            options->profile = optarg;
+            break;
+        case 'r':
+            options->repetitions = (unsigned int) strtoul(optarg, NULL, 10);
+            break;
+        case 'w':
+            options->warmup = (unsigned int) strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            options->budget = strtod(optarg, NULL);
+            break;
+        case 'n':
+            options->largest = (cgre_uint_t) strtod(optarg, NULL);
+            break;
+        case 'E':
+            options->events = 0;
+            break;
+        case 'h':
+            clockperf_usage(stdout);
+            exit(0);
+        default:
+            clockperf_usage(stderr);
+            return 1;
+        }
+    }
+    if (options->repetitions == 0) {
+        options->repetitions = 1;
+    }
+    options->mask = 0;
+    for (size_t idx = 0; idx < sizeof(profiles) / sizeof(profiles[0]);
+            idx++) {
+        if (strcmp(profiles[idx].name, options->profile) == 0) {
+            options->mask = profiles[idx].mask;
+        }
+    }
+    if (options->mask == 0) {
+        fprintf(stderr, "cgre-clockperf: unknown profile '%s'\n",
+                options->profile);
+        return 1;
+    }
+    return 0;
+}
 
 int main(int argc, char** argv)
 {
-    RESULT (cgre_base_atan2_10k);
-    RESULT (cgre_real_clamp_10k);
-    RESULT (cgre_vec2_angle_between_10k);
-    RESULT (cgre_vec2_oriented_angle_between_10k);
-    RESULT (cgre_tree_insert_10k);
-
-    RESULT (cgre_base_atan2_100k);
-    RESULT (cgre_real_clamp_100k);
-    RESULT (cgre_vec2_angle_between_100k);
-    RESULT (cgre_vec2_oriented_angle_between_100k);
-    RESULT (cgre_tree_insert_100k);
+    struct clockperf_options options;
+    if (clockperf_options(argc, argv, &options)) {
+        return 2;
+    }
+    clock_t* samples = malloc(sizeof(clock_t) * options.repetitions);
+    if (samples == NULL) {
+        return 1;
+    }
+    int first = 1;
+    if (options.events) {
+        int opened = clockperf_events_open();
+        if (opened < CLOCKPERF_EVENTS) {
+            fprintf(stderr, "cgre-clockperf: counters unavailable (%s):",
+                    clockperf_events_why());
+            for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+                if (!clockperf_event_available(event)) {
+                    fprintf(stderr, " %s", clockperf_event_name(event));
+                }
+            }
+            fprintf(stderr, "\n");
+        }
+        if (opened == 0) {
+            options.events = 0;
+        }
+    }
+    if (options.json) {
+        printf("{" JSON_MAP_MEMBER("profile", "%s") ","
+                JSON_MAP_NUMBER("warmup", "%u") ","
+                JSON_MAP_NUMBER("repetitions", "%u") ","
+                JSON_MAP_NUMBER("budget_s", "%g") ","
+                "\"events\":[", options.profile, options.warmup,
+                options.repetitions, options.budget);
+        const char* separator = "";
+        for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+            if (clockperf_event_available(event)) {
+                printf("%s\"%s\"", separator, clockperf_event_name(event));
+                separator = ",";
+            }
+        }
+        printf("],\"counters\":[");
+    }
+    for (size_t idx = 0; idx < sizeof(counters) / sizeof(counters[0]);
+            idx++) {
+        const struct clockperf_counter* counter = &(counters[idx]);
+        if (!(counter->profiles & options.mask)) {
+            continue;
+        }
+        if (counter->kind != CLOCKPERF_SCALING) {
+            clockperf_report(counter, &options, samples, &first);
+            continue;
+        }
+        for (int pattern = 1; pattern <= CLOCKPERF_PATTERNS; pattern <<= 1) {
+            if (!(counter->patterns & pattern)) {
+                continue;
+            }
+            for (cgre_uint_t count = CLOCKPERF_SMALLEST;
+                    count <= counter->count && count <= options.largest;
+                    count *= 10) {
+                clockperf_report_scaled(counter, pattern, count, &options,
+                        samples, &first);
+            }
+        }
+    }
+    if (options.json) {
+        printf("%s]}\n", first ? "" : "\n");
+    } else if (first) {
+        fprintf(stderr, "cgre-clockperf: no %s counters yet\n",
+                options.profile);
+    }
+    clockperf_events_close();
+    free(samples);
+    return 0;
 }
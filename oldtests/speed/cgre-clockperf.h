@@ -28,11 +28,94 @@ SOFTWARE.
 ===============================================================================
 */
 
+#include <stdint.h>
 #include <time.h>
+#include <cgre/cgre.h>
 
-#define RESULT(FN) printf( #FN " : %ld clock_t\n", FN())
+#define CLOCKPERF_MATH 1
+#define CLOCKPERF_CGRE 2
+#define CLOCKPERF_SCENE 4
+#define CLOCKPERF_NODE 8
+#define CLOCKPERF_RENDER 16
+#define CLOCKPERF_ALL 31
+
+#define CLOCKPERF_TIMING 0
+#define CLOCKPERF_TALLY 1
+#define CLOCKPERF_SCALING 2
+
+#define CLOCKPERF_SEQUENTIAL 1
+#define CLOCKPERF_REVERSE 2
+#define CLOCKPERF_UNIFORM 4
+#define CLOCKPERF_ZIPFIAN 8
+#define CLOCKPERF_CLUSTERED 16
+#define CLOCKPERF_PATTERNS 31
+#define CLOCKPERF_DISTINCT (CLOCKPERF_PATTERNS & ~CLOCKPERF_ZIPFIAN)
+
+/*
+ * A timing runs `ops` operations per call and returns the nanoseconds they
+ * took, a tally returns a figure that is not a time and is reported as is.
+ */
+#define TIMING(FN, OPS, PROFILES) {#FN, FN, OPS, CLOCKPERF_TIMING, PROFILES}
+#define TALLY(FN, PROFILES) {#FN, FN, 1, CLOCKPERF_TALLY, PROFILES}
+
+/*
+ * A scaling counter takes the member count and key pattern, and is run for
+ * each pattern it lists at every power of ten from 1e3 up to `LARGEST`.
+ */
+#define SCALING(NAME, FN, PATTERNS, LARGEST, PROFILES) \
+    {NAME, NULL, 0, CLOCKPERF_SCALING, PROFILES, FN, PATTERNS, LARGEST}
 
 #define JSON_MAP_MEMBER( KEY, VALUE ) "\"" KEY "\":\"" VALUE "\""
+#define JSON_MAP_NUMBER( KEY, VALUE ) "\"" KEY "\":" VALUE
+
+struct clockperf_counter {
+    const char* name;
+    clock_t (*run)();
+    double ops;
+    int kind;
+    unsigned int profiles;
+    // Scaling counters only, the largest count until run for one pattern
+    clock_t (*scaled)(cgre_uint_t count, int pattern);
+    int patterns;
+    cgre_uint_t count;
+};
+
+#define CLOCKPERF_EVENTS 6
+
+extern int clockperf_events_armed;
+
+clock_t clockperf_events_wall();
+
+/* Monotonic nanoseconds, for the harness itself */
+static inline clock_t clockperf_now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (clock_t) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * Monotonic nanoseconds. Counters take it around the code they measure so
+ * their setup is left out, which also makes threaded counters report elapsed
+ * rather than CPU time. While the harness samples hardware events, the first
+ * call of a pair starts them and the second stops them.
+ */
+static inline clock_t clockperf_wall()
+{
+    return clockperf_events_armed ? clockperf_events_wall() : clockperf_now();
+}
+
+int clockperf_events_open();
+const char* clockperf_events_why();
+void clockperf_events_close();
+void clockperf_events_reset();
+void clockperf_events_settle();
+double clockperf_events_total(int event);
+int clockperf_event_available(int event);
+const char* clockperf_event_name(int event);
+
+cgre_uint_t* clockperf_keys(cgre_uint_t count, int pattern, uint64_t seed);
+const char* clockperf_pattern_name(int pattern);
 
 clock_t cgre_base_atan2_10k();
 clock_t cgre_real_clamp_10k();
@@ -45,3 +128,103 @@ clock_t cgre_real_clamp_100k();
 clock_t cgre_vec2_angle_between_100k();
 clock_t cgre_vec2_oriented_angle_between_100k();
 clock_t cgre_tree_insert_100k();
+
+clock_t cgre_tree_insert_1m();
+clock_t cgre_tree_insert_10m();
+clock_t cgre_tree_delete_1m();
+clock_t cgre_tree_delete_10m();
+clock_t cgre_tree_build_1m();
+clock_t cgre_tree_build_10m();
+clock_t cgre_tree_insert_sorted_1m();
+clock_t cgre_tree_build_sorted_1m();
+
+clock_t cgre_queue_locked_contention_1t();
+clock_t cgre_queue_locked_contention_2t();
+clock_t cgre_queue_locked_contention_4t();
+clock_t cgre_queue_locked_contention_8t();
+clock_t cgre_queue_ring_contention_1t();
+clock_t cgre_queue_ring_contention_2t();
+clock_t cgre_queue_ring_contention_4t();
+clock_t cgre_queue_ring_contention_8t();
+
+clock_t cgre_tree_search_locked_1t();
+clock_t cgre_tree_search_locked_2t();
+clock_t cgre_tree_search_locked_4t();
+clock_t cgre_tree_search_locked_8t();
+clock_t cgre_tree_search_optimistic_1t();
+clock_t cgre_tree_search_optimistic_2t();
+clock_t cgre_tree_search_optimistic_4t();
+clock_t cgre_tree_search_optimistic_8t();
+clock_t cgre_tree_search_btree_1t();
+clock_t cgre_tree_search_btree_2t();
+clock_t cgre_tree_search_btree_4t();
+clock_t cgre_tree_search_btree_8t();
+clock_t cgre_tree_search_locked_1m();
+clock_t cgre_tree_search_btree_1m();
+
+clock_t cgre_tree_search_each_100k();
+clock_t cgre_tree_search_many_100k();
+clock_t cgre_hash_list_insert_each_100k();
+clock_t cgre_hash_list_insert_many_100k();
+clock_t cgre_queue_push_each_100k();
+clock_t cgre_queue_push_many_100k();
+
+clock_t cgre_hash_legacy_names_1m();
+clock_t cgre_hash_names_1m();
+clock_t cgre_hash_legacy_buffer_64m();
+clock_t cgre_hash_bytes_buffer_64m();
+clock_t cgre_hash_legacy_collisions_1m();
+clock_t cgre_hash_collisions_1m();
+
+clock_t cgre_hash_list_contention_1t();
+clock_t cgre_hash_list_contention_2t();
+clock_t cgre_hash_list_contention_4t();
+clock_t cgre_hash_list_contention_8t();
+clock_t cgre_shard_map_contention_1t();
+clock_t cgre_shard_map_contention_2t();
+clock_t cgre_shard_map_contention_4t();
+clock_t cgre_shard_map_contention_8t();
+
+clock_t cgre_node_footprint_1m();
+clock_t cgre_node_footprint_search_1m();
+clock_t cgre_node_footprint_scan_1m();
+
+clock_t cgre_node_malloc_1m();
+clock_t cgre_node_pool_alloc_1m();
+clock_t cgre_tree_search_malloc_1m();
+clock_t cgre_tree_search_pool_1m();
+
+clock_t cgre_array_iterate_legacy_10k();
+clock_t cgre_array_iterate_get_10k();
+clock_t cgre_array_iterate_cursor_10k();
+clock_t cgre_array_iterate_legacy_100k();
+clock_t cgre_array_iterate_get_100k();
+clock_t cgre_array_iterate_cursor_100k();
+
+clock_t cgre_queue_locked_transfer_1m();
+clock_t cgre_queue_ring_transfer_1m();
+clock_t cgre_queue_spsc_transfer_1m();
+clock_t cgre_queue_locked_transfer_batch_1m();
+clock_t cgre_queue_spsc_transfer_batch_1m();
+
+clock_t cgre_lock_mutex_uncontended_10m();
+clock_t cgre_lock_futex_uncontended_10m();
+clock_t cgre_lock_spin_uncontended_10m();
+clock_t cgre_lock_none_uncontended_10m();
+clock_t cgre_lock_mutex_contended_4t();
+clock_t cgre_lock_futex_contended_4t();
+clock_t cgre_lock_spin_contended_4t();
+
+clock_t cgre_tree_insert_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_tree_search_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_tree_delete_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_hash_list_insert_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_hash_list_search_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_shard_map_insert_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_shard_map_search_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_array_get_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_array_vector_get_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_heap_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_queue_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_stack_scaling(cgre_uint_t count, int pattern);
+clock_t cgre_deque_scaling(cgre_uint_t count, int pattern);
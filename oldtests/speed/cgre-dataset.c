@@ -0,0 +1,187 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+/* Consecutive keys per cluster of the clustered pattern */
+#define DATASET_CLUSTER 64
+
+/* Skew of the Zipfian pattern, as in YCSB */
+#define DATASET_ZIPF_THETA 0.99
+
+static uint64_t dataset_next(uint64_t* state)
+{
+    // splitmix64
+    uint64_t mixed = (*state += 0x9e3779b97f4a7c15ull);
+    mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ull;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebull;
+    return mixed ^ (mixed >> 31);
+}
+
+static double dataset_uniform(uint64_t* state)
+{
+    return (double) (dataset_next(state) >> 11) / (double) (1ull << 53);
+}
+
+static void dataset_shuffle(cgre_uint_t* keys, cgre_uint_t count,
+        uint64_t* state)
+{
+    for (cgre_uint_t idx = count; idx > 1; idx--) {
+        cgre_uint_t other = (cgre_uint_t) (dataset_next(state) % idx);
+        cgre_uint_t key = keys[idx - 1];
+        keys[idx - 1] = keys[other];
+        keys[other] = key;
+    }
+}
+
+/*
+ * Ranks drawn with the method of Gray et al., "Quickly Generating
+ * Billion-Record Synthetic Databases". The zeta sum is the slow part and is
+ * kept for the last count asked for.
+ */
+static void dataset_zipfian(cgre_uint_t* keys, cgre_uint_t count,
+        uint64_t* state)
+{
+    static cgre_uint_t zeta_count = 0;
+    static double zeta_n = 0.0;
+    const double theta = DATASET_ZIPF_THETA;
+    if (zeta_count != count) {
+        zeta_n = 0.0;
+        for (cgre_uint_t idx = 1; idx <= count; idx++) {
+            zeta_n += 1.0 / pow((double) idx, theta);
+        }
+        zeta_count = count;
+    }
+    double zeta_2 = 1.0 + 1.0 / pow(2.0, theta);
+    double alpha = 1.0 / (1.0 - theta);
+    double eta = (1.0 - pow(2.0 / count, 1.0 - theta)) /
+        (1.0 - zeta_2 / zeta_n);
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        double u = dataset_uniform(state);
+        double uz = u * zeta_n;
+        uint64_t rank;
+        if (uz < 1.0) {
+            rank = 0;
+        } else if (uz < zeta_2) {
+            rank = 1;
+        } else {
+            rank = (uint64_t) (count * pow(eta * u - eta + 1.0, alpha));
+        }
+        if (rank >= count) {
+            rank = count - 1;
+        }
+        // Scatter the popular ranks over the key space, the step is odd and
+        // not a multiple of 5 so it is a bijection for every power of ten
+        keys[idx] = (cgre_uint_t) ((rank * 2654435761ull) % count);
+    }
+}
+
+/*
+ * Keys from 0 to count - 1. Every pattern but the Zipfian one is a
+ * permutation, so each key shows up once; the Zipfian one repeats popular
+ * keys as a real lookup stream does.
+ *
+ * Returns a malloc'd array the caller frees, or NULL.
+ */
+cgre_uint_t* clockperf_keys(cgre_uint_t count, int pattern, uint64_t seed)
+{
+    uint64_t state = seed;
+    cgre_uint_t* keys = malloc(sizeof(cgre_uint_t) * (count ? count : 1));
+    if (keys == NULL) {
+        return NULL;
+    }
+    switch (pattern) {
+    case CLOCKPERF_REVERSE:
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            keys[idx] = count - 1 - idx;
+        }
+        break;
+    case CLOCKPERF_UNIFORM:
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            keys[idx] = idx;
+        }
+        dataset_shuffle(keys, count, &state);
+        break;
+    case CLOCKPERF_ZIPFIAN:
+        dataset_zipfian(keys, count, &state);
+        break;
+    case CLOCKPERF_CLUSTERED: {
+        // Runs of consecutive keys, the runs in random order
+        cgre_uint_t clusters = (count + DATASET_CLUSTER - 1) / DATASET_CLUSTER;
+        cgre_uint_t* order = malloc(sizeof(cgre_uint_t) *
+                (clusters ? clusters : 1));
+        if (order == NULL) {
+            free(keys);
+            return NULL;
+        }
+        for (cgre_uint_t idx = 0; idx < clusters; idx++) {
+            order[idx] = idx;
+        }
+        dataset_shuffle(order, clusters, &state);
+        cgre_uint_t next = 0;
+        for (cgre_uint_t cluster = 0; cluster < clusters; cluster++) {
+            cgre_uint_t first = order[cluster] * DATASET_CLUSTER;
+            for (cgre_uint_t key = first;
+                    key < first + DATASET_CLUSTER && key < count; key++) {
+                keys[next++] = key;
+            }
+        }
+        free(order);
+        break;
+    }
+    default:
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            keys[idx] = idx;
+        }
+        break;
+    }
+    return keys;
+}
+
+const char* clockperf_pattern_name(int pattern)
+{
+    switch (pattern) {
+    case CLOCKPERF_SEQUENTIAL:
+        return "sequential";
+    case CLOCKPERF_REVERSE:
+        return "reverse";
+    case CLOCKPERF_UNIFORM:
+        return "uniform";
+    case CLOCKPERF_ZIPFIAN:
+        return "zipfian";
+    case CLOCKPERF_CLUSTERED:
+        return "clustered";
+    }
+    return "unknown";
+}
@@ -0,0 +1,250 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include "cgre-clockperf.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /* ifdef __linux__ */
+
+/*
+ * Hardware counters read through perf_event_open around the timed region of
+ * each counter. clockperf_wall() starts them on its first call and stops
+ * them on its second, so they cover exactly what the timing covers. Each
+ * event has a descriptor of its own, so an event the processor or the
+ * kernel does not offer only leaves that one out.
+ */
+
+int clockperf_events_armed = 0;
+
+static const char* event_names[CLOCKPERF_EVENTS] = {
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "branch_misses",
+    "page_faults",
+};
+
+static int event_fds[CLOCKPERF_EVENTS] = {-1, -1, -1, -1, -1, -1};
+static double event_totals[CLOCKPERF_EVENTS];
+static int events_running = 0;
+
+const char* clockperf_event_name(int event)
+{
+    return event_names[event];
+}
+
+int clockperf_event_available(int event)
+{
+    return event_fds[event] >= 0;
+}
+
+#ifdef __linux__
+
+static int events_error = 0;
+
+static void event_attr(int event, struct perf_event_attr* attr)
+{
+    const uint64_t read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    memset(attr, 0, sizeof(struct perf_event_attr));
+    attr->size = sizeof(struct perf_event_attr);
+    attr->type = PERF_TYPE_HARDWARE;
+    switch (event) {
+    case 0:
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case 1:
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case 2:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+        break;
+    case 3:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_LL | read_miss;
+        break;
+    case 4:
+        attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    default:
+        attr->type = PERF_TYPE_SOFTWARE;
+        attr->config = PERF_COUNT_SW_PAGE_FAULTS;
+        break;
+    }
+    attr->disabled = 1;
+    // Threads the counter starts are counted too, once they are joined
+    attr->inherit = 1;
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+        PERF_FORMAT_TOTAL_TIME_RUNNING;
+}
+
+/*
+ * Returns the number of events opened. When none is, `clockperf_events_why()`
+ * tells why and the harness reports timings alone.
+ */
+int clockperf_events_open()
+{
+    struct perf_event_attr attr;
+    int opened = 0;
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        event_attr(event, &attr);
+        event_fds[event] = (int) syscall(SYS_perf_event_open, &attr, 0, -1,
+                -1, 0);
+        if (event_fds[event] >= 0) {
+            opened++;
+        } else if (events_error == 0) {
+            events_error = errno;
+        }
+    }
+    return opened;
+}
+
+const char* clockperf_events_why()
+{
+    return events_error ? strerror(events_error) : "not opened";
+}
+
+void clockperf_events_close()
+{
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        if (event_fds[event] >= 0) {
+            close(event_fds[event]);
+            event_fds[event] = -1;
+        }
+    }
+}
+
+static void events_start()
+{
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        if (event_fds[event] >= 0) {
+            ioctl(event_fds[event], PERF_EVENT_IOC_RESET, 0);
+            ioctl(event_fds[event], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+static void events_stop()
+{
+    // value, time enabled, time running
+    uint64_t values[3];
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        if (event_fds[event] < 0) {
+            continue;
+        }
+        ioctl(event_fds[event], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(event_fds[event], values, sizeof(values)) !=
+                sizeof(values) || values[2] == 0) {
+            continue;
+        }
+        // Scale up for the time the kernel had the event multiplexed out
+        event_totals[event] += (double) values[0] *
+            ((double) values[1] / (double) values[2]);
+    }
+}
+
+#else /* ifdef __linux__ */
+
+int clockperf_events_open()
+{
+    return 0;
+}
+
+const char* clockperf_events_why()
+{
+    return "perf_event_open is Linux only";
+}
+
+void clockperf_events_close()
+{
+}
+
+static void events_start()
+{
+}
+
+static void events_stop()
+{
+}
+
+#endif /* ifdef __linux__ */
+
+void clockperf_events_reset()
+{
+    for (int event = 0; event < CLOCKPERF_EVENTS; event++) {
+        event_totals[event] = 0.0;
+    }
+}
+
+double clockperf_events_total(int event)
+{
+    return event_totals[event];
+}
+
+/*
+ * Starting the events before taking the time, and stopping them after,
+ * keeps the system calls out of the timing.
+ */
+clock_t clockperf_events_wall()
+{
+    clock_t now;
+    if (!events_running) {
+        events_start();
+        events_running = 1;
+        return clockperf_now();
+    }
+    now = clockperf_now();
+    events_stop();
+    events_running = 0;
+    return now;
+}
+
+/*
+ * Stops the events a counter left running by taking the time an odd number
+ * of times.
+ */
+void clockperf_events_settle()
+{
+    if (events_running) {
+        events_stop();
+        events_running = 0;
+    }
+}
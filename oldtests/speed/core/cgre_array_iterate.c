@@ -0,0 +1,129 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+/*
+ * Indexed access as it was before the array kept a finger, every lookup
+ * walks from the head or the middle.
+ */
+static struct cgre_node* array_get_legacy(
+        struct cgre_node_set* array,
+        cgre_uint_t index)
+{
+    struct cgre_node* found = NULL;
+    cgre_node_set_lock(array);
+    if (index < array->count) {
+        cgre_uint_t middle = (array->count - 1) >> 1;
+        cgre_uint_t at = 0;
+        found = array->link[CGRE_NODE_HEAD];
+        if (index >= middle) {
+            found = array->link[CGRE_NODE_MIDDLE];
+            at = middle;
+        }
+        for (; at < index; at++) {
+            found = found->link[CGRE_NODE_TAIL];
+        }
+    }
+    cgre_node_set_unlock(array);
+    return found;
+}
+
+#define ITERATE_LEGACY 0
+#define ITERATE_GET 1
+#define ITERATE_CURSOR 2
+
+static clock_t array_iterate(
+        cgre_uint_t total,
+        int method)
+{
+    struct cgre_node_set array;
+    struct cgre_array_cursor cursor;
+    struct cgre_node* nodes = malloc(sizeof(struct cgre_node) * total);
+    if (nodes == NULL) {
+        return 0;
+    }
+    cgre_node_set_initialize(&array);
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        cgre_array_add(&array, cgre_node_initialize(&(nodes[idx]), idx, NULL));
+    }
+    volatile cgre_uint_t sum = 0;
+    clock_t start = clockperf_wall();
+    if (method == ITERATE_CURSOR) {
+        for (struct cgre_node* node = cgre_array_cursor_begin(&cursor, &array);
+                node != NULL;
+                node = cgre_array_cursor_next(&cursor)) {
+            sum += node->key;
+        }
+    } else {
+        for (cgre_uint_t idx = 0; idx < total; idx++) {
+            sum += (method == ITERATE_GET) ?
+                cgre_array_get(&array, idx)->key :
+                array_get_legacy(&array, idx)->key;
+        }
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&array);
+    free(nodes);
+    return (end - start);
+}
+
+clock_t cgre_array_iterate_legacy_10k()
+{
+    return array_iterate(10000, ITERATE_LEGACY);
+}
+
+clock_t cgre_array_iterate_get_10k()
+{
+    return array_iterate(10000, ITERATE_GET);
+}
+
+clock_t cgre_array_iterate_cursor_10k()
+{
+    return array_iterate(10000, ITERATE_CURSOR);
+}
+
+clock_t cgre_array_iterate_legacy_100k()
+{
+    return array_iterate(100000, ITERATE_LEGACY);
+}
+
+clock_t cgre_array_iterate_get_100k()
+{
+    return array_iterate(100000, ITERATE_GET);
+}
+
+clock_t cgre_array_iterate_cursor_100k()
+{
+    return array_iterate(100000, ITERATE_CURSOR);
+}
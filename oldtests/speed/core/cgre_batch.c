@@ -0,0 +1,187 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define BATCH_MEMBERS 1000000
+#define BATCH_OPS 100000
+#define BATCH_SIZE 256
+
+static struct cgre_node* batch_members(cgre_uint_t count)
+{
+    struct cgre_node* members = malloc(sizeof(struct cgre_node) * count);
+    if (members == NULL) {
+        return NULL;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_node_initialize(&(members[idx]), idx * 2654435761u, NULL);
+    }
+    return members;
+}
+
+static clock_t tree_search_batched(cgre_uint_t batch)
+{
+    struct cgre_node_set tree;
+    struct cgre_node* members = batch_members(BATCH_MEMBERS);
+    cgre_uint_t* keys = malloc(sizeof(cgre_uint_t) * BATCH_OPS);
+    struct cgre_node** found = malloc(sizeof(struct cgre_node*) * BATCH_OPS);
+    if (members == NULL || keys == NULL || found == NULL) {
+        free(members);
+        free(keys);
+        free(found);
+        return 0;
+    }
+    cgre_node_set_initialize(&tree);
+    for (cgre_uint_t idx = 0; idx < BATCH_MEMBERS; idx++) {
+        cgre_tree_insert(&tree, &(members[idx]));
+    }
+    unsigned int seed = 1;
+    for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx++) {
+        keys[idx] = members[rand_r(&seed) % BATCH_MEMBERS].key;
+    }
+    clock_t start, end;
+    start = clockperf_wall();
+    if (batch == 1) {
+        for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx++) {
+            found[idx] = cgre_tree_search(&tree, keys[idx]);
+        }
+    } else {
+        for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx += batch) {
+            cgre_tree_search_many(&tree, &(keys[idx]), &(found[idx]),
+                    BATCH_OPS - idx < batch ? BATCH_OPS - idx : batch);
+        }
+    }
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    free(members);
+    free(keys);
+    free(found);
+    return (end - start);
+}
+
+static clock_t hash_list_insert_batched(cgre_uint_t batch)
+{
+    struct cgre_node_set list;
+    struct cgre_node* members = batch_members(BATCH_OPS);
+    struct cgre_node** nodes = malloc(sizeof(struct cgre_node*) * BATCH_OPS);
+    if (members == NULL || nodes == NULL) {
+        free(members);
+        free(nodes);
+        return 0;
+    }
+    cgre_node_set_initialize(&list);
+    CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_TABLE);
+    for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx++) {
+        nodes[idx] = &(members[idx]);
+    }
+    clock_t start, end;
+    start = clockperf_wall();
+    if (batch == 1) {
+        for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx++) {
+            cgre_hash_list_insert(&list, nodes[idx]);
+        }
+    } else {
+        for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx += batch) {
+            cgre_hash_list_insert_many(&list, &(nodes[idx]),
+                    BATCH_OPS - idx < batch ? BATCH_OPS - idx : batch);
+        }
+    }
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&list);
+    free(members);
+    free(nodes);
+    return (end - start);
+}
+
+static clock_t queue_push_batched(cgre_uint_t batch)
+{
+    struct cgre_node_set queue;
+    struct cgre_node* members = batch_members(BATCH_OPS);
+    struct cgre_node** nodes = malloc(sizeof(struct cgre_node*) * BATCH_OPS);
+    if (members == NULL || nodes == NULL) {
+        free(members);
+        free(nodes);
+        return 0;
+    }
+    cgre_node_set_initialize(&queue);
+    for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx++) {
+        nodes[idx] = &(members[idx]);
+    }
+    clock_t start, end;
+    start = clockperf_wall();
+    if (batch == 1) {
+        for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx++) {
+            cgre_queue_push(&queue, nodes[idx]);
+        }
+    } else {
+        for (cgre_uint_t idx = 0; idx < BATCH_OPS; idx += batch) {
+            cgre_queue_push_many(&queue, &(nodes[idx]),
+                    BATCH_OPS - idx < batch ? BATCH_OPS - idx : batch);
+        }
+    }
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&queue);
+    free(members);
+    free(nodes);
+    return (end - start);
+}
+
+clock_t cgre_tree_search_each_100k()
+{
+    return tree_search_batched(1);
+}
+
+clock_t cgre_tree_search_many_100k()
+{
+    return tree_search_batched(BATCH_SIZE);
+}
+
+clock_t cgre_hash_list_insert_each_100k()
+{
+    return hash_list_insert_batched(1);
+}
+
+clock_t cgre_hash_list_insert_many_100k()
+{
+    return hash_list_insert_batched(BATCH_SIZE);
+}
+
+clock_t cgre_queue_push_each_100k()
+{
+    return queue_push_batched(1);
+}
+
+clock_t cgre_queue_push_many_100k()
+{
+    return queue_push_batched(BATCH_SIZE);
+}
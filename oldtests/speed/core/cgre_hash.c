@@ -0,0 +1,149 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define HASH_NAMES 1000000
+#define HASH_BUFFER (64 * 1024 * 1024)
+
+// The XOR/shift sum cgre_hash used before cgre_hash_bytes, kept to compare
+static cgre_uint_t hash_legacy(const void* key)
+{
+    const char* s = (const char*) key;
+    cgre_uint_t sum = 0;
+    cgre_int_t interval = 0;
+    for (cgre_int_t idx = 0; s[idx] != 0; idx++) {
+        if (interval == 1) {
+            sum <<= sizeof(char);
+            interval--;
+        }
+        sum ^= (cgre_int_t) s[idx];
+        interval++;
+    }
+    return sum;
+}
+
+static clock_t hash_names(int legacy)
+{
+    char name[32];
+    volatile cgre_uint_t sink = 0;
+    clock_t start = clockperf_wall();
+    for (int idx = 0; idx < HASH_NAMES; idx++) {
+        snprintf(name, sizeof(name), "node%d", idx);
+        sink ^= legacy ? hash_legacy(name) : cgre_hash(name);
+    }
+    return clockperf_wall() - start;
+}
+
+clock_t cgre_hash_legacy_names_1m()
+{
+    return hash_names(1);
+}
+
+clock_t cgre_hash_names_1m()
+{
+    return hash_names(0);
+}
+
+static clock_t hash_buffer(int legacy)
+{
+    char* buffer = malloc(HASH_BUFFER + 1);
+    volatile uint64_t sink = 0;
+    clock_t start;
+    if (buffer == NULL) {
+        return 0;
+    }
+    for (int idx = 0; idx < HASH_BUFFER; idx++) {
+        buffer[idx] = (char) ('a' + idx % 26);
+    }
+    buffer[HASH_BUFFER] = 0;
+    start = clockperf_wall();
+    sink ^= legacy ? hash_legacy(buffer) :
+        cgre_hash_bytes(buffer, HASH_BUFFER, 0);
+    start = clockperf_wall() - start;
+    free(buffer);
+    return start;
+}
+
+clock_t cgre_hash_legacy_buffer_64m()
+{
+    return hash_buffer(1);
+}
+
+clock_t cgre_hash_bytes_buffer_64m()
+{
+    return hash_buffer(0);
+}
+
+static int hash_compare(const void* first, const void* second)
+{
+    cgre_uint_t a = *(const cgre_uint_t*) first;
+    cgre_uint_t b = *(const cgre_uint_t*) second;
+    return (a > b) - (a < b);
+}
+
+/*
+ * Not a timing: the number of colliding hashes over a million similar names,
+ * registered as a tally so it is reported once and as is.
+ */
+static clock_t hash_collisions(int legacy)
+{
+    char name[32];
+    clock_t collisions = 0;
+    cgre_uint_t* hashes = malloc(sizeof(cgre_uint_t) * HASH_NAMES);
+    if (hashes == NULL) {
+        return 0;
+    }
+    for (int idx = 0; idx < HASH_NAMES; idx++) {
+        snprintf(name, sizeof(name), "node%d", idx);
+        hashes[idx] = legacy ? hash_legacy(name) : cgre_hash(name);
+    }
+    qsort(hashes, HASH_NAMES, sizeof(cgre_uint_t), hash_compare);
+    for (int idx = 1; idx < HASH_NAMES; idx++) {
+        collisions += hashes[idx] == hashes[idx - 1];
+    }
+    free(hashes);
+    return collisions;
+}
+
+clock_t cgre_hash_legacy_collisions_1m()
+{
+    return hash_collisions(1);
+}
+
+clock_t cgre_hash_collisions_1m()
+{
+    return hash_collisions(0);
+}
@@ -0,0 +1,140 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <pthread.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define LOCK_UNCONTENDED_OPS 10000000
+#define LOCK_CONTENDED_OPS 1000000
+#define LOCK_CONTENDED_THREADS 4
+
+struct lock_contention_worker {
+    struct cgre_node_set* set;
+    volatile cgre_uint_t* counter;
+};
+
+static void* lock_contention_run(void* arg)
+{
+    struct lock_contention_worker* worker =
+        (struct lock_contention_worker*) arg;
+    for (cgre_int_t idx = 0; idx < LOCK_CONTENDED_OPS; idx++) {
+        cgre_node_set_lock(worker->set);
+        *(worker->counter) = *(worker->counter) + 1;
+        cgre_node_set_unlock(worker->set);
+    }
+    return NULL;
+}
+
+static void* lock_idle(void* arg)
+{
+    return arg;
+}
+
+static clock_t lock_uncontended(cgre_uint_t policy)
+{
+    struct cgre_node_set set;
+    volatile cgre_uint_t counter = 0;
+    // glibc skips the atomics of a mutex until a second thread exists
+    pthread_t idle;
+    pthread_create(&idle, NULL, lock_idle, NULL);
+    pthread_join(idle, NULL);
+    cgre_node_set_initialize_lock(&set, policy);
+    clock_t start = clockperf_wall();
+    for (cgre_int_t idx = 0; idx < LOCK_UNCONTENDED_OPS; idx++) {
+        cgre_node_set_lock(&set);
+        counter = counter + 1;
+        cgre_node_set_unlock(&set);
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&set);
+    return (end - start);
+}
+
+static clock_t lock_contended(cgre_uint_t policy)
+{
+    struct cgre_node_set set;
+    volatile cgre_uint_t counter = 0;
+    struct lock_contention_worker worker = {&set, &counter};
+    pthread_t handles[LOCK_CONTENDED_THREADS];
+    cgre_node_set_initialize_lock(&set, policy);
+    clock_t start = clockperf_wall();
+    for (int thread = 0; thread < LOCK_CONTENDED_THREADS; thread++) {
+        pthread_create(&(handles[thread]), NULL, lock_contention_run,
+                &worker);
+    }
+    for (int thread = 0; thread < LOCK_CONTENDED_THREADS; thread++) {
+        pthread_join(handles[thread], NULL);
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&set);
+    return (end - start);
+}
+
+/*
+ * Lock and unlock pairs around a one word critical section, first from a
+ * single thread then from several threads on the same set. Without a lock
+ * the threads would only race, so there is no contended counter for it.
+ */
+clock_t cgre_lock_mutex_uncontended_10m()
+{
+    return lock_uncontended(CGRE_LOCK_MUTEX);
+}
+
+clock_t cgre_lock_futex_uncontended_10m()
+{
+    return lock_uncontended(CGRE_LOCK_FUTEX);
+}
+
+clock_t cgre_lock_spin_uncontended_10m()
+{
+    return lock_uncontended(CGRE_LOCK_SPIN);
+}
+
+clock_t cgre_lock_none_uncontended_10m()
+{
+    return lock_uncontended(CGRE_LOCK_NONE);
+}
+
+clock_t cgre_lock_mutex_contended_4t()
+{
+    return lock_contended(CGRE_LOCK_MUTEX);
+}
+
+clock_t cgre_lock_futex_contended_4t()
+{
+    return lock_contended(CGRE_LOCK_FUTEX);
+}
+
+clock_t cgre_lock_spin_contended_4t()
+{
+    return lock_contended(CGRE_LOCK_SPIN);
+}
@@ -0,0 +1,98 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define FOOTPRINT_MEMBERS 1000000
+
+/*
+ * Configure with and without --enable-compact-node to compare layouts. The
+ * members sit in one array, so the walks below touch as many cache lines as
+ * the node size dictates.
+ */
+
+/*
+ * Not a timing: the bytes taken by a million members, registered as a tally
+ * so it is reported once and as is.
+ */
+clock_t cgre_node_footprint_1m()
+{
+    return (clock_t) (sizeof(struct cgre_node) * FOOTPRINT_MEMBERS);
+}
+
+static clock_t footprint_walk(int scan)
+{
+    struct cgre_node_set tree;
+    struct cgre_node* members = malloc(
+            sizeof(struct cgre_node) * FOOTPRINT_MEMBERS);
+    struct cgre_node** nodes = malloc(
+            sizeof(struct cgre_node*) * FOOTPRINT_MEMBERS);
+    if (members == NULL || nodes == NULL) {
+        free(members);
+        free(nodes);
+        return 0;
+    }
+    for (cgre_uint_t idx = 0; idx < FOOTPRINT_MEMBERS; idx++) {
+        cgre_node_initialize(&(members[idx]), idx, NULL);
+        nodes[idx] = &(members[idx]);
+    }
+    cgre_node_set_initialize(&tree);
+    cgre_tree_build(&tree, nodes, FOOTPRINT_MEMBERS);
+    clock_t start = clockperf_wall();
+    if (scan) {
+        // In order, as a range scan does
+        cgre_tree_range(&tree, 0, FOOTPRINT_MEMBERS, nodes, FOOTPRINT_MEMBERS);
+    } else {
+        // Scattered lookups, one root to leaf path each
+        cgre_uint_t key = 0;
+        for (cgre_uint_t idx = 0; idx < FOOTPRINT_MEMBERS; idx++) {
+            key = (key + 2654435761u) % FOOTPRINT_MEMBERS;
+            cgre_tree_search(&tree, key);
+        }
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    free(members);
+    free(nodes);
+    return (end - start);
+}
+
+clock_t cgre_node_footprint_search_1m()
+{
+    return footprint_walk(0);
+}
+
+clock_t cgre_node_footprint_scan_1m()
+{
+    return footprint_walk(1);
+}
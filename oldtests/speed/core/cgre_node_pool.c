@@ -0,0 +1,127 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define POOL_MEMBERS 1000000
+
+static clock_t pool_alloc(int pooled)
+{
+    struct cgre_node_pool pool;
+    struct cgre_node** nodes = malloc(sizeof(struct cgre_node*) * POOL_MEMBERS);
+    if (nodes == NULL) {
+        return 0;
+    }
+    cgre_node_pool_initialize(&pool);
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < POOL_MEMBERS; idx++) {
+        nodes[idx] = pooled ? cgre_node_pool_alloc(&pool, idx, NULL) :
+            cgre_node_initialize(malloc(sizeof(struct cgre_node)), idx, NULL);
+    }
+    for (cgre_uint_t idx = 0; idx < POOL_MEMBERS; idx++) {
+        if (pooled) {
+            cgre_node_pool_free(&pool, nodes[idx]);
+        } else {
+            free(nodes[idx]);
+        }
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_pool_uninitialize(&pool);
+    free(nodes);
+    return (end - start);
+}
+
+clock_t cgre_node_malloc_1m()
+{
+    return pool_alloc(0);
+}
+
+clock_t cgre_node_pool_alloc_1m()
+{
+    return pool_alloc(1);
+}
+
+/*
+ * Members are allocated alongside values of varying size, as a registry
+ * does, then searched in key order. Malloc interleaves the two, the pool
+ * keeps the nodes together.
+ */
+static clock_t pool_search(int pooled)
+{
+    struct cgre_node_pool pool;
+    struct cgre_node_set tree;
+    void** values = malloc(sizeof(void*) * POOL_MEMBERS);
+    struct cgre_node** nodes = malloc(sizeof(struct cgre_node*) * POOL_MEMBERS);
+    if (values == NULL || nodes == NULL) {
+        free(values);
+        free(nodes);
+        return 0;
+    }
+    cgre_node_pool_initialize(&pool);
+    cgre_node_set_initialize(&tree);
+    cgre_uint_t key = 0;
+    for (cgre_uint_t idx = 0; idx < POOL_MEMBERS; idx++) {
+        key += 2654435761u;
+        values[idx] = malloc(16 + (key >> 26));
+        nodes[idx] = pooled ? cgre_node_pool_alloc(&pool, key, values[idx]) :
+            cgre_node_initialize(malloc(sizeof(struct cgre_node)), key,
+                    values[idx]);
+        cgre_tree_insert(&tree, nodes[idx]);
+    }
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < POOL_MEMBERS; idx++) {
+        cgre_tree_search(&tree, nodes[idx]->key);
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    for (cgre_uint_t idx = 0; idx < POOL_MEMBERS; idx++) {
+        if (!pooled) {
+            free(nodes[idx]);
+        }
+        free(values[idx]);
+    }
+    cgre_node_pool_uninitialize(&pool);
+    free(values);
+    free(nodes);
+    return (end - start);
+}
+
+clock_t cgre_tree_search_malloc_1m()
+{
+    return pool_search(0);
+}
+
+clock_t cgre_tree_search_pool_1m()
+{
+    return pool_search(1);
+}
@@ -0,0 +1,127 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define QUEUE_CONTENTION_OPS 100000
+
+struct queue_contention_worker {
+    struct cgre_node_set* queue;
+    struct cgre_node* items;
+};
+
+static void* queue_contention_run(void* arg)
+{
+    struct queue_contention_worker* worker =
+        (struct queue_contention_worker*) arg;
+    // Every thread pushes then pops, keeping the queue shallow and hot
+    for (cgre_int_t idx = 0; idx < QUEUE_CONTENTION_OPS; idx++) {
+        cgre_queue_push(worker->queue, &(worker->items[idx & 63]));
+        cgre_queue_pop(worker->queue);
+    }
+    return NULL;
+}
+
+static clock_t queue_contention(cgre_uint_t mode, int threads)
+{
+    struct cgre_node_set queue;
+    struct queue_contention_worker workers[threads];
+    pthread_t handles[threads];
+    cgre_node_set_initialize(&queue);
+    if (mode == CGRE_QUEUE_RING) {
+        cgre_queue_reserve(&queue, 64 * threads);
+    }
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * 64 * threads);
+    if (items == NULL) {
+        return 0;
+    }
+    for (cgre_int_t idx = 0; idx < 64 * threads; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+    }
+    clock_t start, end;
+    start = clockperf_wall();
+    for (int thread = 0; thread < threads; thread++) {
+        workers[thread].queue = &queue;
+        workers[thread].items = &(items[64 * thread]);
+        pthread_create(&(handles[thread]), NULL, queue_contention_run,
+                &(workers[thread]));
+    }
+    for (int thread = 0; thread < threads; thread++) {
+        pthread_join(handles[thread], NULL);
+    }
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&queue);
+    free(items);
+    return (end - start);
+}
+
+clock_t cgre_queue_locked_contention_1t()
+{
+    return queue_contention(CGRE_QUEUE_LOCKED, 1);
+}
+
+clock_t cgre_queue_locked_contention_2t()
+{
+    return queue_contention(CGRE_QUEUE_LOCKED, 2);
+}
+
+clock_t cgre_queue_locked_contention_4t()
+{
+    return queue_contention(CGRE_QUEUE_LOCKED, 4);
+}
+
+clock_t cgre_queue_locked_contention_8t()
+{
+    return queue_contention(CGRE_QUEUE_LOCKED, 8);
+}
+
+clock_t cgre_queue_ring_contention_1t()
+{
+    return queue_contention(CGRE_QUEUE_RING, 1);
+}
+
+clock_t cgre_queue_ring_contention_2t()
+{
+    return queue_contention(CGRE_QUEUE_RING, 2);
+}
+
+clock_t cgre_queue_ring_contention_4t()
+{
+    return queue_contention(CGRE_QUEUE_RING, 4);
+}
+
+clock_t cgre_queue_ring_contention_8t()
+{
+    return queue_contention(CGRE_QUEUE_RING, 8);
+}
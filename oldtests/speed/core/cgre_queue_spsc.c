@@ -0,0 +1,150 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define SPSC_MESSAGES 1000000
+#define SPSC_BATCH 32
+
+struct spsc_transfer {
+    struct cgre_node_set* queue;
+    struct cgre_node* items;
+    cgre_uint_t batch;
+};
+
+static void* spsc_transfer_produce(void* arg)
+{
+    struct spsc_transfer* transfer = (struct spsc_transfer*) arg;
+    struct cgre_node* batch[SPSC_BATCH];
+    for (cgre_uint_t idx = 0; idx < SPSC_MESSAGES;) {
+        cgre_uint_t pushed;
+        if (transfer->batch > 1) {
+            cgre_uint_t count = 0;
+            for (; count < transfer->batch && idx + count < SPSC_MESSAGES;
+                    count++) {
+                batch[count] = &(transfer->items[idx + count]);
+            }
+            pushed = cgre_queue_push_many(transfer->queue, batch, count);
+        } else {
+            pushed = cgre_queue_push(transfer->queue,
+                    &(transfer->items[idx])) != NULL;
+        }
+        if (pushed == 0) {
+            sched_yield();
+        }
+        idx += pushed;
+    }
+    return NULL;
+}
+
+static void* spsc_transfer_consume(void* arg)
+{
+    struct spsc_transfer* transfer = (struct spsc_transfer*) arg;
+    struct cgre_node* batch[SPSC_BATCH];
+    for (cgre_uint_t idx = 0; idx < SPSC_MESSAGES;) {
+        cgre_uint_t popped;
+        if (transfer->batch > 1) {
+            popped = cgre_queue_pop_many(transfer->queue, batch,
+                    transfer->batch);
+        } else {
+            popped = cgre_queue_pop(transfer->queue) != NULL;
+        }
+        if (popped == 0) {
+            sched_yield();
+        }
+        idx += popped;
+    }
+    return NULL;
+}
+
+/*
+ * A producer thread hands every message to a consumer thread, as the game
+ * thread feeds render prep.
+ */
+static clock_t spsc_transfer(cgre_uint_t mode, cgre_uint_t batch)
+{
+    struct cgre_node_set queue;
+    struct spsc_transfer transfer;
+    pthread_t producer, consumer;
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * SPSC_MESSAGES);
+    if (items == NULL) {
+        return 0;
+    }
+    for (cgre_uint_t idx = 0; idx < SPSC_MESSAGES; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+    }
+    cgre_node_set_initialize(&queue);
+    if (mode != CGRE_QUEUE_LOCKED) {
+        CGRE_NODES_MODE_SET_VALUE(queue.state, mode);
+        cgre_queue_reserve(&queue, 1024);
+    }
+    transfer.queue = &queue;
+    transfer.items = items;
+    transfer.batch = batch;
+    clock_t start = clockperf_wall();
+    pthread_create(&consumer, NULL, spsc_transfer_consume, &transfer);
+    pthread_create(&producer, NULL, spsc_transfer_produce, &transfer);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&queue);
+    free(items);
+    return (end - start);
+}
+
+clock_t cgre_queue_locked_transfer_1m()
+{
+    return spsc_transfer(CGRE_QUEUE_LOCKED, 1);
+}
+
+clock_t cgre_queue_ring_transfer_1m()
+{
+    return spsc_transfer(CGRE_QUEUE_RING, 1);
+}
+
+clock_t cgre_queue_spsc_transfer_1m()
+{
+    return spsc_transfer(CGRE_QUEUE_SPSC, 1);
+}
+
+clock_t cgre_queue_locked_transfer_batch_1m()
+{
+    return spsc_transfer(CGRE_QUEUE_LOCKED, SPSC_BATCH);
+}
+
+clock_t cgre_queue_spsc_transfer_batch_1m()
+{
+    return spsc_transfer(CGRE_QUEUE_SPSC, SPSC_BATCH);
+}
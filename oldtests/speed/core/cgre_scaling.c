@@ -0,0 +1,323 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+/*
+ * Every collection driven with the same keys at sizes from a thousand to ten
+ * million members, so their timings line up into scaling curves. Members are
+ * keyed 0 to count - 1, the pattern orders the inserts, or the lookups and
+ * deletes once the collection is filled.
+ */
+
+#define SCALING_SEED 0x5ca1ab1eu
+
+#define SCALING_INSERT 0
+#define SCALING_SEARCH 1
+#define SCALING_DELETE 2
+
+struct scaling_data {
+    struct cgre_node* members;
+    cgre_uint_t* keys;
+};
+
+static int scaling_prepare(struct scaling_data* data, cgre_uint_t count,
+        int pattern)
+{
+    data->members = malloc(sizeof(struct cgre_node) * (count ? count : 1));
+    data->keys = clockperf_keys(count, pattern, SCALING_SEED);
+    if (data->members == NULL || data->keys == NULL) {
+        free(data->members);
+        free(data->keys);
+        return 0;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_node_initialize(&(data->members[idx]), idx, NULL);
+    }
+    return 1;
+}
+
+static void scaling_release(struct scaling_data* data)
+{
+    free(data->members);
+    free(data->keys);
+}
+
+static clock_t tree_scaling(cgre_uint_t count, int pattern, int operation)
+{
+    struct cgre_node_set tree;
+    struct scaling_data data;
+    if (!scaling_prepare(&data, count, pattern)) {
+        return 0;
+    }
+    cgre_node_set_initialize(&tree);
+    if (operation != SCALING_INSERT) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            cgre_tree_insert(&tree, &(data.members[idx]));
+        }
+    }
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        if (operation == SCALING_INSERT) {
+            cgre_tree_insert(&tree, &(data.members[data.keys[idx]]));
+        } else if (operation == SCALING_SEARCH) {
+            cgre_tree_search(&tree, data.keys[idx]);
+        } else {
+            cgre_tree_delete(&tree, data.keys[idx]);
+        }
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    scaling_release(&data);
+    return (end - start);
+}
+
+clock_t cgre_tree_insert_scaling(cgre_uint_t count, int pattern)
+{
+    return tree_scaling(count, pattern, SCALING_INSERT);
+}
+
+clock_t cgre_tree_search_scaling(cgre_uint_t count, int pattern)
+{
+    return tree_scaling(count, pattern, SCALING_SEARCH);
+}
+
+clock_t cgre_tree_delete_scaling(cgre_uint_t count, int pattern)
+{
+    return tree_scaling(count, pattern, SCALING_DELETE);
+}
+
+static clock_t hash_list_scaling(cgre_uint_t count, int pattern,
+        int operation)
+{
+    struct cgre_node_set list;
+    struct scaling_data data;
+    if (!scaling_prepare(&data, count, pattern)) {
+        return 0;
+    }
+    cgre_node_set_initialize(&list);
+    // The sorted list is linear per insert and would not finish at 10m
+    CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_TABLE);
+    if (operation != SCALING_INSERT) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            cgre_hash_list_insert(&list, &(data.members[idx]));
+        }
+    }
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        if (operation == SCALING_INSERT) {
+            cgre_hash_list_insert(&list, &(data.members[data.keys[idx]]));
+        } else {
+            cgre_hash_list_search(&list, data.keys[idx]);
+        }
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&list);
+    scaling_release(&data);
+    return (end - start);
+}
+
+clock_t cgre_hash_list_insert_scaling(cgre_uint_t count, int pattern)
+{
+    return hash_list_scaling(count, pattern, SCALING_INSERT);
+}
+
+clock_t cgre_hash_list_search_scaling(cgre_uint_t count, int pattern)
+{
+    return hash_list_scaling(count, pattern, SCALING_SEARCH);
+}
+
+static clock_t shard_map_scaling(cgre_uint_t count, int pattern,
+        int operation)
+{
+    struct cgre_shard_map map;
+    struct scaling_data data;
+    if (!scaling_prepare(&data, count, pattern)) {
+        return 0;
+    }
+    cgre_shard_map_initialize(&map, 0);
+    if (operation != SCALING_INSERT) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            cgre_shard_map_insert(&map, &(data.members[idx]));
+        }
+    }
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        if (operation == SCALING_INSERT) {
+            cgre_shard_map_insert(&map, &(data.members[data.keys[idx]]));
+        } else {
+            cgre_shard_map_search(&map, data.keys[idx]);
+        }
+    }
+    clock_t end = clockperf_wall();
+    cgre_shard_map_uninitialize(&map);
+    scaling_release(&data);
+    return (end - start);
+}
+
+clock_t cgre_shard_map_insert_scaling(cgre_uint_t count, int pattern)
+{
+    return shard_map_scaling(count, pattern, SCALING_INSERT);
+}
+
+clock_t cgre_shard_map_search_scaling(cgre_uint_t count, int pattern)
+{
+    return shard_map_scaling(count, pattern, SCALING_SEARCH);
+}
+
+/*
+ * Indexed gets in linked mode walk from the closest of the head, middle, tail
+ * or last position, so the pattern decides how far each one goes. Vector
+ * gets are a slot read whatever the pattern.
+ */
+static clock_t array_scaling(cgre_uint_t count, int pattern, cgre_uint_t mode)
+{
+    struct cgre_node_set array;
+    struct scaling_data data;
+    if (!scaling_prepare(&data, count, pattern)) {
+        return 0;
+    }
+    cgre_node_set_initialize(&array);
+    CGRE_NODES_MODE_SET_VALUE(array.state, mode);
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_array_add(&array, &(data.members[idx]));
+    }
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_array_get(&array, data.keys[idx]);
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&array);
+    scaling_release(&data);
+    return (end - start);
+}
+
+clock_t cgre_array_get_scaling(cgre_uint_t count, int pattern)
+{
+    return array_scaling(count, pattern, CGRE_ARRAY_LINKED);
+}
+
+clock_t cgre_array_vector_get_scaling(cgre_uint_t count, int pattern)
+{
+    return array_scaling(count, pattern, CGRE_ARRAY_VECTOR);
+}
+
+/*
+ * Pushes in pattern order then pops everything, the heap keys decide how far
+ * each push sifts up.
+ */
+clock_t cgre_heap_scaling(cgre_uint_t count, int pattern)
+{
+    struct cgre_node_set heap;
+    struct scaling_data data;
+    if (!scaling_prepare(&data, count, pattern)) {
+        return 0;
+    }
+    // Keyed by the pattern itself, so the Zipfian one pushes duplicates
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        data.members[idx].key = data.keys[idx];
+    }
+    cgre_node_set_initialize(&heap);
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_heap_push(&heap, &(data.members[idx]));
+    }
+    while (cgre_heap_pop(&heap) != NULL) {
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&heap);
+    scaling_release(&data);
+    return (end - start);
+}
+
+#define SCALING_QUEUE 0
+#define SCALING_STACK 1
+#define SCALING_DEQUE 2
+
+/*
+ * Pushes every member then pops them all. Keys play no part, so only the
+ * sequential pattern is registered.
+ */
+static clock_t sequence_scaling(cgre_uint_t count, int collection)
+{
+    struct cgre_node_set set;
+    struct scaling_data data;
+    if (!scaling_prepare(&data, count, CLOCKPERF_SEQUENTIAL)) {
+        return 0;
+    }
+    cgre_node_set_initialize(&set);
+    if (collection == SCALING_DEQUE) {
+        cgre_deque_reserve(&set, 64);
+    }
+    clock_t start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        if (collection == SCALING_QUEUE) {
+            cgre_queue_push(&set, &(data.members[idx]));
+        } else if (collection == SCALING_STACK) {
+            cgre_stack_push(&set, &(data.members[idx]));
+        } else {
+            cgre_deque_push(&set, &(data.members[idx]));
+        }
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        if (collection == SCALING_QUEUE) {
+            cgre_queue_pop(&set);
+        } else if (collection == SCALING_STACK) {
+            cgre_stack_pop(&set);
+        } else {
+            cgre_deque_pop(&set);
+        }
+    }
+    clock_t end = clockperf_wall();
+    cgre_node_set_uninitialize(&set);
+    scaling_release(&data);
+    return (end - start);
+}
+
+clock_t cgre_queue_scaling(cgre_uint_t count, int pattern)
+{
+    (void) pattern;
+    return sequence_scaling(count, SCALING_QUEUE);
+}
+
+clock_t cgre_stack_scaling(cgre_uint_t count, int pattern)
+{
+    (void) pattern;
+    return sequence_scaling(count, SCALING_STACK);
+}
+
+clock_t cgre_deque_scaling(cgre_uint_t count, int pattern)
+{
+    (void) pattern;
+    return sequence_scaling(count, SCALING_DEQUE);
+}
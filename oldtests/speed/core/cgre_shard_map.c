@@ -0,0 +1,165 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define SHARD_CONTENTION_OPS 200000
+#define SHARD_CONTENTION_MEMBERS 4096
+
+struct shard_contention_worker {
+    struct cgre_shard_map* map;
+    struct cgre_node_set* list;
+    struct cgre_node* items;
+    cgre_uint_t seed;
+};
+
+static void* shard_contention_run(void* arg)
+{
+    struct shard_contention_worker* worker =
+        (struct shard_contention_worker*) arg;
+    cgre_uint_t seed = worker->seed;
+    // Mostly lookups of shared keys, with some churn on keys of our own
+    for (cgre_int_t idx = 0; idx < SHARD_CONTENTION_OPS; idx++) {
+        seed = seed * 1664525u + 1013904223u;
+        cgre_uint_t key = (seed >> 8) % SHARD_CONTENTION_MEMBERS;
+        if ((idx & 7) != 7) {
+            if (worker->map != NULL) {
+                cgre_shard_map_search(worker->map, key);
+            } else {
+                cgre_hash_list_search(worker->list, key);
+            }
+        } else {
+            struct cgre_node* node = &(worker->items[(idx >> 3) & 63]);
+            if (worker->map != NULL) {
+                if (cgre_shard_map_insert(worker->map, node) == NULL) {
+                    cgre_shard_map_delete(worker->map, node->key);
+                }
+            } else {
+                if (cgre_hash_list_insert(worker->list, node) == NULL) {
+                    cgre_hash_list_delete(worker->list, node->key);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+static clock_t shard_contention(int sharded, int threads)
+{
+    struct cgre_shard_map map;
+    struct cgre_node_set list;
+    struct shard_contention_worker workers[threads];
+    pthread_t handles[threads];
+    cgre_uint_t total = SHARD_CONTENTION_MEMBERS + 64 * threads;
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * total);
+    if (items == NULL) {
+        return 0;
+    }
+    cgre_shard_map_initialize(&map, 0);
+    cgre_node_set_initialize(&list);
+    CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_TABLE);
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+        if (idx < SHARD_CONTENTION_MEMBERS) {
+            if (sharded) {
+                cgre_shard_map_insert(&map, &(items[idx]));
+            } else {
+                cgre_hash_list_insert(&list, &(items[idx]));
+            }
+        }
+    }
+    clock_t start, end;
+    start = clockperf_wall();
+    for (int thread = 0; thread < threads; thread++) {
+        workers[thread].map = sharded ? &map : NULL;
+        workers[thread].list = &list;
+        workers[thread].items =
+            &(items[SHARD_CONTENTION_MEMBERS + 64 * thread]);
+        workers[thread].seed = thread + 1;
+        pthread_create(&(handles[thread]), NULL, shard_contention_run,
+                &(workers[thread]));
+    }
+    for (int thread = 0; thread < threads; thread++) {
+        pthread_join(handles[thread], NULL);
+    }
+    end = clockperf_wall();
+    cgre_shard_map_uninitialize(&map);
+    cgre_node_set_uninitialize(&list);
+    free(items);
+    return (end - start);
+}
+
+/*
+ * Every thread does the same amount of work, so flat timings mean linear
+ * scaling. Counts beyond the online cores only measure oversubscription.
+ */
+clock_t cgre_hash_list_contention_1t()
+{
+    return shard_contention(0, 1);
+}
+
+clock_t cgre_hash_list_contention_2t()
+{
+    return shard_contention(0, 2);
+}
+
+clock_t cgre_hash_list_contention_4t()
+{
+    return shard_contention(0, 4);
+}
+
+clock_t cgre_hash_list_contention_8t()
+{
+    return shard_contention(0, 8);
+}
+
+clock_t cgre_shard_map_contention_1t()
+{
+    return shard_contention(1, 1);
+}
+
+clock_t cgre_shard_map_contention_2t()
+{
+    return shard_contention(1, 2);
+}
+
+clock_t cgre_shard_map_contention_4t()
+{
+    return shard_contention(1, 4);
+}
+
+clock_t cgre_shard_map_contention_8t()
+{
+    return shard_contention(1, 8);
+}
@@ -31,1059 +31,165 @@ SOFTWARE.
 #include <stdlib.h>
 #include <time.h>
 #include <cgre/cgre.h>
+#include "cgre-clockperf.h"
 
-struct cgre_node* init_members();
+/*
+ * Distinct keys in random order, so every call is a real insert rather than
+ * the early exit of a duplicate key.
+ */
+static clock_t tree_insert_uniform(cgre_uint_t count)
+{
+    struct cgre_node* members = malloc(sizeof(struct cgre_node) * count);
+    cgre_uint_t* keys = clockperf_keys(count, CLOCKPERF_UNIFORM, count);
+    if ( members == NULL || keys == NULL ) {
+        free(members);
+        free(keys);
+        return 0;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_node_initialize(&(members[idx]), keys[idx], NULL);
+    }
+    clock_t start, end;
+    struct cgre_node_set tree;
+    cgre_node_set_initialize(&tree);
+    start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_tree_insert(&tree, &(members[idx]));
+    }
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    free(members);
+    free(keys);
+    return (end - start);
+}
 
 clock_t cgre_tree_insert_10k()
+{
+    return tree_insert_uniform(10000);
+}
+
+clock_t cgre_tree_insert_100k()
+{
+    return tree_insert_uniform(100000);
+}
+
+static struct cgre_node* stepped_members(cgre_uint_t count, cgre_uint_t step)
 {
     struct cgre_node* members;
-    members = init_members();
+    members = (struct cgre_node*) malloc(sizeof(struct cgre_node) * count);
+    if ( members == NULL ) {
+        return members;
+    }
+    // Odd steps are a bijection, so keys are distinct and only sorted for 1
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_node_initialize(&(members[idx]), (cgre_uint_t) (idx * step),
+                NULL);
+    }
+    return members;
+}
+
+static clock_t tree_insert_stepped(cgre_uint_t count, cgre_uint_t step)
+{
+    struct cgre_node* members = stepped_members(count, step);
     if ( members == NULL ) {
         return 0;
     }
-    init_members();
     clock_t start, end;
-    struct cgre_node_tree tree;
-    cgre_tree_initialize(&tree, NULL);
-    struct cgre_node* inserted;
-    start = clock();
-    for (cgre_int_t counter = 0; counter < 10; counter++) {
-        for (cgre_int_t idx = 0; idx < 1000; idx++) {
-            inserted = cgre_tree_insert(&tree, &(members[counter]));
-        }
+    struct cgre_node_set tree;
+    cgre_node_set_initialize(&tree);
+    start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_tree_insert(&tree, &(members[idx]));
     }
-    end = clock();
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    free(members);
     return (end - start);
 }
 
-clock_t cgre_tree_insert_100k()
+static clock_t tree_delete_stepped(cgre_uint_t count, cgre_uint_t step)
 {
-    struct cgre_node* members;
-    members = init_members();
+    struct cgre_node* members = stepped_members(count, step);
     if ( members == NULL ) {
         return 0;
     }
     clock_t start, end;
-    struct cgre_node_tree tree;
-    cgre_tree_initialize(&tree, NULL);
-    struct cgre_node* inserted;
-    start = clock();
-    volatile cgre_real_t result;
-    for (int counter = 0; counter < 100; counter++) {
-        for (cgre_int_t idx = 0; idx < 1000; idx++) {
-            inserted = cgre_tree_insert(&tree, &(members[counter]));
-        }
+    struct cgre_node_set tree;
+    cgre_node_set_initialize(&tree);
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_tree_insert(&tree, &(members[idx]));
+    }
+    start = clockperf_wall();
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_tree_delete(&tree, members[idx].key);
     }
-    end = clock();
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    free(members);
     return (end - start);
 }
 
-struct cgre_node* init_members()
+static clock_t tree_build_stepped(cgre_uint_t count, cgre_uint_t step)
 {
-    struct cgre_node* members;
-    members = (struct cgre_node*) malloc(sizeof(struct cgre_node) * 1000);
-    if ( members == NULL ) {
-        return members;
+    struct cgre_node* members = stepped_members(count, step);
+    struct cgre_node** order = (struct cgre_node**) malloc(
+            sizeof(struct cgre_node*) * count);
+    if ( members == NULL || order == NULL ) {
+        free(members);
+        free(order);
+        return 0;
     }
-    cgre_node_initialize(&(members[0]), 91675, NULL);
-    cgre_node_initialize(&(members[1]), 98563, NULL);
-    cgre_node_initialize(&(members[2]), 81880, NULL);
-    cgre_node_initialize(&(members[3]), 16966, NULL);
-    cgre_node_initialize(&(members[4]), 50039, NULL);
-    cgre_node_initialize(&(members[5]), 63694, NULL);
-    cgre_node_initialize(&(members[6]), 60219, NULL);
-    cgre_node_initialize(&(members[7]), 10047, NULL);
-    cgre_node_initialize(&(members[8]), 69853, NULL);
-    cgre_node_initialize(&(members[9]), 35986, NULL);
-    cgre_node_initialize(&(members[10]), 39522, NULL);
-    cgre_node_initialize(&(members[11]), 18027, NULL);
-    cgre_node_initialize(&(members[12]), 98208, NULL);
-    cgre_node_initialize(&(members[13]), 92344, NULL);
-    cgre_node_initialize(&(members[14]), 61545, NULL);
-    cgre_node_initialize(&(members[15]), 43316, NULL);
-    cgre_node_initialize(&(members[16]), 71320, NULL);
-    cgre_node_initialize(&(members[17]), 22192, NULL);
-    cgre_node_initialize(&(members[18]), 56796, NULL);
-    cgre_node_initialize(&(members[19]), 82024, NULL);
-    cgre_node_initialize(&(members[20]), 84354, NULL);
-    cgre_node_initialize(&(members[21]), 54012, NULL);
-    cgre_node_initialize(&(members[22]), 57724, NULL);
-    cgre_node_initialize(&(members[23]), 33286, NULL);
-    cgre_node_initialize(&(members[24]), 61423, NULL);
-    cgre_node_initialize(&(members[25]), 51614, NULL);
-    cgre_node_initialize(&(members[26]), 37828, NULL);
-    cgre_node_initialize(&(members[27]), 39916, NULL);
-    cgre_node_initialize(&(members[28]), 42658, NULL);
-    cgre_node_initialize(&(members[29]), 64064, NULL);
-    cgre_node_initialize(&(members[30]), 34558, NULL);
-    cgre_node_initialize(&(members[31]), 25899, NULL);
-    cgre_node_initialize(&(members[32]), 66692, NULL);
-    cgre_node_initialize(&(members[33]), 17288, NULL);
-    cgre_node_initialize(&(members[34]), 60297, NULL);
-    cgre_node_initialize(&(members[35]), 31014, NULL);
-    cgre_node_initialize(&(members[36]), 91448, NULL);
-    cgre_node_initialize(&(members[37]), 84935, NULL);
-    cgre_node_initialize(&(members[38]), 64343, NULL);
-    cgre_node_initialize(&(members[39]), 59323, NULL);
-    cgre_node_initialize(&(members[40]), 67188, NULL);
-    cgre_node_initialize(&(members[41]), 77995, NULL);
-    cgre_node_initialize(&(members[42]), 57587, NULL);
-    cgre_node_initialize(&(members[43]), 85241, NULL);
-    cgre_node_initialize(&(members[44]), 51961, NULL);
-    cgre_node_initialize(&(members[45]), 51033, NULL);
-    cgre_node_initialize(&(members[46]), 22251, NULL);
-    cgre_node_initialize(&(members[47]), 86411, NULL);
-    cgre_node_initialize(&(members[48]), 93033, NULL);
-    cgre_node_initialize(&(members[49]), 61239, NULL);
-    cgre_node_initialize(&(members[50]), 21534, NULL);
-    cgre_node_initialize(&(members[51]), 78815, NULL);
-    cgre_node_initialize(&(members[52]), 2678, NULL);
-    cgre_node_initialize(&(members[53]), 64553, NULL);
-    cgre_node_initialize(&(members[54]), 50114, NULL);
-    cgre_node_initialize(&(members[55]), 80932, NULL);
-    cgre_node_initialize(&(members[56]), 84480, NULL);
-    cgre_node_initialize(&(members[57]), 53417, NULL);
-    cgre_node_initialize(&(members[58]), 12109, NULL);
-    cgre_node_initialize(&(members[59]), 37517, NULL);
-    cgre_node_initialize(&(members[60]), 71904, NULL);
-    cgre_node_initialize(&(members[61]), 42939, NULL);
-    cgre_node_initialize(&(members[62]), 44734, NULL);
-    cgre_node_initialize(&(members[63]), 5635, NULL);
-    cgre_node_initialize(&(members[64]), 74187, NULL);
-    cgre_node_initialize(&(members[65]), 10213, NULL);
-    cgre_node_initialize(&(members[66]), 49016, NULL);
-    cgre_node_initialize(&(members[67]), 94727, NULL);
-    cgre_node_initialize(&(members[68]), 8579, NULL);
-    cgre_node_initialize(&(members[69]), 22859, NULL);
-    cgre_node_initialize(&(members[70]), 51415, NULL);
-    cgre_node_initialize(&(members[71]), 33030, NULL);
-    cgre_node_initialize(&(members[72]), 44073, NULL);
-    cgre_node_initialize(&(members[73]), 25474, NULL);
-    cgre_node_initialize(&(members[74]), 89169, NULL);
-    cgre_node_initialize(&(members[75]), 40331, NULL);
-    cgre_node_initialize(&(members[76]), 65657, NULL);
-    cgre_node_initialize(&(members[77]), 19509, NULL);
-    cgre_node_initialize(&(members[78]), 70583, NULL);
-    cgre_node_initialize(&(members[79]), 9161, NULL);
-    cgre_node_initialize(&(members[80]), 88011, NULL);
-    cgre_node_initialize(&(members[81]), 12613, NULL);
-    cgre_node_initialize(&(members[82]), 93006, NULL);
-    cgre_node_initialize(&(members[83]), 67516, NULL);
-    cgre_node_initialize(&(members[84]), 97081, NULL);
-    cgre_node_initialize(&(members[85]), 9885, NULL);
-    cgre_node_initialize(&(members[86]), 6394, NULL);
-    cgre_node_initialize(&(members[87]), 10702, NULL);
-    cgre_node_initialize(&(members[88]), 94547, NULL);
-    cgre_node_initialize(&(members[89]), 75524, NULL);
-    cgre_node_initialize(&(members[90]), 47847, NULL);
-    cgre_node_initialize(&(members[91]), 30221, NULL);
-    cgre_node_initialize(&(members[92]), 31780, NULL);
-    cgre_node_initialize(&(members[93]), 61439, NULL);
-    cgre_node_initialize(&(members[94]), 98124, NULL);
-    cgre_node_initialize(&(members[95]), 7815, NULL);
-    cgre_node_initialize(&(members[96]), 39284, NULL);
-    cgre_node_initialize(&(members[97]), 86020, NULL);
-    cgre_node_initialize(&(members[98]), 65392, NULL);
-    cgre_node_initialize(&(members[99]), 95505, NULL);
-    cgre_node_initialize(&(members[100]), 21076, NULL);
-    cgre_node_initialize(&(members[101]), 44867, NULL);
-    cgre_node_initialize(&(members[102]), 10683, NULL);
-    cgre_node_initialize(&(members[103]), 58407, NULL);
-    cgre_node_initialize(&(members[104]), 30963, NULL);
-    cgre_node_initialize(&(members[105]), 41714, NULL);
-    cgre_node_initialize(&(members[106]), 12080, NULL);
-    cgre_node_initialize(&(members[107]), 46721, NULL);
-    cgre_node_initialize(&(members[108]), 4322, NULL);
-    cgre_node_initialize(&(members[109]), 3593, NULL);
-    cgre_node_initialize(&(members[110]), 70139, NULL);
-    cgre_node_initialize(&(members[111]), 57608, NULL);
-    cgre_node_initialize(&(members[112]), 79858, NULL);
-    cgre_node_initialize(&(members[113]), 29105, NULL);
-    cgre_node_initialize(&(members[114]), 59276, NULL);
-    cgre_node_initialize(&(members[115]), 9212, NULL);
-    cgre_node_initialize(&(members[116]), 54958, NULL);
-    cgre_node_initialize(&(members[117]), 75101, NULL);
-    cgre_node_initialize(&(members[118]), 83198, NULL);
-    cgre_node_initialize(&(members[119]), 99674, NULL);
-    cgre_node_initialize(&(members[120]), 95175, NULL);
-    cgre_node_initialize(&(members[121]), 88124, NULL);
-    cgre_node_initialize(&(members[122]), 63820, NULL);
-    cgre_node_initialize(&(members[123]), 36990, NULL);
-    cgre_node_initialize(&(members[124]), 69273, NULL);
-    cgre_node_initialize(&(members[125]), 75374, NULL);
-    cgre_node_initialize(&(members[126]), 16983, NULL);
-    cgre_node_initialize(&(members[127]), 14364, NULL);
-    cgre_node_initialize(&(members[128]), 8086, NULL);
-    cgre_node_initialize(&(members[129]), 41348, NULL);
-    cgre_node_initialize(&(members[130]), 3350, NULL);
-    cgre_node_initialize(&(members[131]), 21378, NULL);
-    cgre_node_initialize(&(members[132]), 35695, NULL);
-    cgre_node_initialize(&(members[133]), 39154, NULL);
-    cgre_node_initialize(&(members[134]), 30844, NULL);
-    cgre_node_initialize(&(members[135]), 82680, NULL);
-    cgre_node_initialize(&(members[136]), 9669, NULL);
-    cgre_node_initialize(&(members[137]), 19797, NULL);
-    cgre_node_initialize(&(members[138]), 55947, NULL);
-    cgre_node_initialize(&(members[139]), 94965, NULL);
-    cgre_node_initialize(&(members[140]), 773, NULL);
-    cgre_node_initialize(&(members[141]), 34674, NULL);
-    cgre_node_initialize(&(members[142]), 60280, NULL);
-    cgre_node_initialize(&(members[143]), 20430, NULL);
-    cgre_node_initialize(&(members[144]), 39678, NULL);
-    cgre_node_initialize(&(members[145]), 64582, NULL);
-    cgre_node_initialize(&(members[146]), 68539, NULL);
-    cgre_node_initialize(&(members[147]), 34066, NULL);
-    cgre_node_initialize(&(members[148]), 45335, NULL);
-    cgre_node_initialize(&(members[149]), 71498, NULL);
-    cgre_node_initialize(&(members[150]), 36640, NULL);
-    cgre_node_initialize(&(members[151]), 99435, NULL);
-    cgre_node_initialize(&(members[152]), 69784, NULL);
-    cgre_node_initialize(&(members[153]), 78053, NULL);
-    cgre_node_initialize(&(members[154]), 57070, NULL);
-    cgre_node_initialize(&(members[155]), 72181, NULL);
-    cgre_node_initialize(&(members[156]), 21862, NULL);
-    cgre_node_initialize(&(members[157]), 48125, NULL);
-    cgre_node_initialize(&(members[158]), 9655, NULL);
-    cgre_node_initialize(&(members[159]), 43551, NULL);
-    cgre_node_initialize(&(members[160]), 13284, NULL);
-    cgre_node_initialize(&(members[161]), 1417, NULL);
-    cgre_node_initialize(&(members[162]), 7144, NULL);
-    cgre_node_initialize(&(members[163]), 44486, NULL);
-    cgre_node_initialize(&(members[164]), 58565, NULL);
-    cgre_node_initialize(&(members[165]), 8792, NULL);
-    cgre_node_initialize(&(members[166]), 16821, NULL);
-    cgre_node_initialize(&(members[167]), 50443, NULL);
-    cgre_node_initialize(&(members[168]), 5798, NULL);
-    cgre_node_initialize(&(members[169]), 45834, NULL);
-    cgre_node_initialize(&(members[170]), 8989, NULL);
-    cgre_node_initialize(&(members[171]), 58155, NULL);
-    cgre_node_initialize(&(members[172]), 55559, NULL);
-    cgre_node_initialize(&(members[173]), 49982, NULL);
-    cgre_node_initialize(&(members[174]), 34235, NULL);
-    cgre_node_initialize(&(members[175]), 75064, NULL);
-    cgre_node_initialize(&(members[176]), 85850, NULL);
-    cgre_node_initialize(&(members[177]), 52613, NULL);
-    cgre_node_initialize(&(members[178]), 15462, NULL);
-    cgre_node_initialize(&(members[179]), 76705, NULL);
-    cgre_node_initialize(&(members[180]), 63424, NULL);
-    cgre_node_initialize(&(members[181]), 97254, NULL);
-    cgre_node_initialize(&(members[182]), 28687, NULL);
-    cgre_node_initialize(&(members[183]), 37228, NULL);
-    cgre_node_initialize(&(members[184]), 63838, NULL);
-    cgre_node_initialize(&(members[185]), 3600, NULL);
-    cgre_node_initialize(&(members[186]), 91384, NULL);
-    cgre_node_initialize(&(members[187]), 95015, NULL);
-    cgre_node_initialize(&(members[188]), 48444, NULL);
-    cgre_node_initialize(&(members[189]), 19978, NULL);
-    cgre_node_initialize(&(members[190]), 13427, NULL);
-    cgre_node_initialize(&(members[191]), 84741, NULL);
-    cgre_node_initialize(&(members[192]), 69855, NULL);
-    cgre_node_initialize(&(members[193]), 31490, NULL);
-    cgre_node_initialize(&(members[194]), 93066, NULL);
-    cgre_node_initialize(&(members[195]), 63136, NULL);
-    cgre_node_initialize(&(members[196]), 68068, NULL);
-    cgre_node_initialize(&(members[197]), 43811, NULL);
-    cgre_node_initialize(&(members[198]), 56365, NULL);
-    cgre_node_initialize(&(members[199]), 73893, NULL);
-    cgre_node_initialize(&(members[200]), 64924, NULL);
-    cgre_node_initialize(&(members[201]), 84151, NULL);
-    cgre_node_initialize(&(members[202]), 70255, NULL);
-    cgre_node_initialize(&(members[203]), 99762, NULL);
-    cgre_node_initialize(&(members[204]), 38825, NULL);
-    cgre_node_initialize(&(members[205]), 11032, NULL);
-    cgre_node_initialize(&(members[206]), 79450, NULL);
-    cgre_node_initialize(&(members[207]), 2555, NULL);
-    cgre_node_initialize(&(members[208]), 3234, NULL);
-    cgre_node_initialize(&(members[209]), 88979, NULL);
-    cgre_node_initialize(&(members[210]), 57029, NULL);
-    cgre_node_initialize(&(members[211]), 18856, NULL);
-    cgre_node_initialize(&(members[212]), 98516, NULL);
-    cgre_node_initialize(&(members[213]), 96984, NULL);
-    cgre_node_initialize(&(members[214]), 32883, NULL);
-    cgre_node_initialize(&(members[215]), 24635, NULL);
-    cgre_node_initialize(&(members[216]), 71889, NULL);
-    cgre_node_initialize(&(members[217]), 34298, NULL);
-    cgre_node_initialize(&(members[218]), 55466, NULL);
-    cgre_node_initialize(&(members[219]), 85741, NULL);
-    cgre_node_initialize(&(members[220]), 18042, NULL);
-    cgre_node_initialize(&(members[221]), 9388, NULL);
-    cgre_node_initialize(&(members[222]), 2725, NULL);
-    cgre_node_initialize(&(members[223]), 63167, NULL);
-    cgre_node_initialize(&(members[224]), 65452, NULL);
-    cgre_node_initialize(&(members[225]), 41713, NULL);
-    cgre_node_initialize(&(members[226]), 61671, NULL);
-    cgre_node_initialize(&(members[227]), 3669, NULL);
-    cgre_node_initialize(&(members[228]), 35520, NULL);
-    cgre_node_initialize(&(members[229]), 27183, NULL);
-    cgre_node_initialize(&(members[230]), 98460, NULL);
-    cgre_node_initialize(&(members[231]), 77581, NULL);
-    cgre_node_initialize(&(members[232]), 10128, NULL);
-    cgre_node_initialize(&(members[233]), 62035, NULL);
-    cgre_node_initialize(&(members[234]), 42113, NULL);
-    cgre_node_initialize(&(members[235]), 18191, NULL);
-    cgre_node_initialize(&(members[236]), 26533, NULL);
-    cgre_node_initialize(&(members[237]), 84269, NULL);
-    cgre_node_initialize(&(members[238]), 28042, NULL);
-    cgre_node_initialize(&(members[239]), 46312, NULL);
-    cgre_node_initialize(&(members[240]), 19047, NULL);
-    cgre_node_initialize(&(members[241]), 58243, NULL);
-    cgre_node_initialize(&(members[242]), 81637, NULL);
-    cgre_node_initialize(&(members[243]), 56027, NULL);
-    cgre_node_initialize(&(members[244]), 41025, NULL);
-    cgre_node_initialize(&(members[245]), 9282, NULL);
-    cgre_node_initialize(&(members[246]), 50320, NULL);
-    cgre_node_initialize(&(members[247]), 36333, NULL);
-    cgre_node_initialize(&(members[248]), 61592, NULL);
-    cgre_node_initialize(&(members[249]), 79302, NULL);
-    cgre_node_initialize(&(members[250]), 74720, NULL);
-    cgre_node_initialize(&(members[251]), 15424, NULL);
-    cgre_node_initialize(&(members[252]), 39115, NULL);
-    cgre_node_initialize(&(members[253]), 20883, NULL);
-    cgre_node_initialize(&(members[254]), 91228, NULL);
-    cgre_node_initialize(&(members[255]), 90445, NULL);
-    cgre_node_initialize(&(members[256]), 53528, NULL);
-    cgre_node_initialize(&(members[257]), 76438, NULL);
-    cgre_node_initialize(&(members[258]), 36102, NULL);
-    cgre_node_initialize(&(members[259]), 65939, NULL);
-    cgre_node_initialize(&(members[260]), 37459, NULL);
-    cgre_node_initialize(&(members[261]), 53486, NULL);
-    cgre_node_initialize(&(members[262]), 91883, NULL);
-    cgre_node_initialize(&(members[263]), 67704, NULL);
-    cgre_node_initialize(&(members[264]), 79744, NULL);
-    cgre_node_initialize(&(members[265]), 34377, NULL);
-    cgre_node_initialize(&(members[266]), 76720, NULL);
-    cgre_node_initialize(&(members[267]), 51032, NULL);
-    cgre_node_initialize(&(members[268]), 25673, NULL);
-    cgre_node_initialize(&(members[269]), 55433, NULL);
-    cgre_node_initialize(&(members[270]), 84496, NULL);
-    cgre_node_initialize(&(members[271]), 61279, NULL);
-    cgre_node_initialize(&(members[272]), 98233, NULL);
-    cgre_node_initialize(&(members[273]), 86182, NULL);
-    cgre_node_initialize(&(members[274]), 97839, NULL);
-    cgre_node_initialize(&(members[275]), 50538, NULL);
-    cgre_node_initialize(&(members[276]), 55323, NULL);
-    cgre_node_initialize(&(members[277]), 29579, NULL);
-    cgre_node_initialize(&(members[278]), 35061, NULL);
-    cgre_node_initialize(&(members[279]), 25964, NULL);
-    cgre_node_initialize(&(members[280]), 43342, NULL);
-    cgre_node_initialize(&(members[281]), 98403, NULL);
-    cgre_node_initialize(&(members[282]), 36617, NULL);
-    cgre_node_initialize(&(members[283]), 59159, NULL);
-    cgre_node_initialize(&(members[284]), 68980, NULL);
-    cgre_node_initialize(&(members[285]), 59007, NULL);
-    cgre_node_initialize(&(members[286]), 10292, NULL);
-    cgre_node_initialize(&(members[287]), 25285, NULL);
-    cgre_node_initialize(&(members[288]), 77461, NULL);
-    cgre_node_initialize(&(members[289]), 19801, NULL);
-    cgre_node_initialize(&(members[290]), 4316, NULL);
-    cgre_node_initialize(&(members[291]), 70067, NULL);
-    cgre_node_initialize(&(members[292]), 14905, NULL);
-    cgre_node_initialize(&(members[293]), 14506, NULL);
-    cgre_node_initialize(&(members[294]), 54485, NULL);
-    cgre_node_initialize(&(members[295]), 21026, NULL);
-    cgre_node_initialize(&(members[296]), 90253, NULL);
-    cgre_node_initialize(&(members[297]), 35740, NULL);
-    cgre_node_initialize(&(members[298]), 26150, NULL);
-    cgre_node_initialize(&(members[299]), 76286, NULL);
-    cgre_node_initialize(&(members[300]), 49624, NULL);
-    cgre_node_initialize(&(members[301]), 30256, NULL);
-    cgre_node_initialize(&(members[302]), 55157, NULL);
-    cgre_node_initialize(&(members[303]), 25491, NULL);
-    cgre_node_initialize(&(members[304]), 1449, NULL);
-    cgre_node_initialize(&(members[305]), 96777, NULL);
-    cgre_node_initialize(&(members[306]), 71768, NULL);
-    cgre_node_initialize(&(members[307]), 18660, NULL);
-    cgre_node_initialize(&(members[308]), 37000, NULL);
-    cgre_node_initialize(&(members[309]), 20297, NULL);
-    cgre_node_initialize(&(members[310]), 8362, NULL);
-    cgre_node_initialize(&(members[311]), 6930, NULL);
-    cgre_node_initialize(&(members[312]), 71189, NULL);
-    cgre_node_initialize(&(members[313]), 42327, NULL);
-    cgre_node_initialize(&(members[314]), 63031, NULL);
-    cgre_node_initialize(&(members[315]), 19617, NULL);
-    cgre_node_initialize(&(members[316]), 57122, NULL);
-    cgre_node_initialize(&(members[317]), 79145, NULL);
-    cgre_node_initialize(&(members[318]), 30918, NULL);
-    cgre_node_initialize(&(members[319]), 66872, NULL);
-    cgre_node_initialize(&(members[320]), 94728, NULL);
-    cgre_node_initialize(&(members[321]), 94676, NULL);
-    cgre_node_initialize(&(members[322]), 8572, NULL);
-    cgre_node_initialize(&(members[323]), 76046, NULL);
-    cgre_node_initialize(&(members[324]), 3291, NULL);
-    cgre_node_initialize(&(members[325]), 97410, NULL);
-    cgre_node_initialize(&(members[326]), 47854, NULL);
-    cgre_node_initialize(&(members[327]), 97367, NULL);
-    cgre_node_initialize(&(members[328]), 71789, NULL);
-    cgre_node_initialize(&(members[329]), 89163, NULL);
-    cgre_node_initialize(&(members[330]), 59407, NULL);
-    cgre_node_initialize(&(members[331]), 22701, NULL);
-    cgre_node_initialize(&(members[332]), 26875, NULL);
-    cgre_node_initialize(&(members[333]), 4033, NULL);
-    cgre_node_initialize(&(members[334]), 24485, NULL);
-    cgre_node_initialize(&(members[335]), 63707, NULL);
-    cgre_node_initialize(&(members[336]), 73196, NULL);
-    cgre_node_initialize(&(members[337]), 31317, NULL);
-    cgre_node_initialize(&(members[338]), 71039, NULL);
-    cgre_node_initialize(&(members[339]), 51689, NULL);
-    cgre_node_initialize(&(members[340]), 60455, NULL);
-    cgre_node_initialize(&(members[341]), 92091, NULL);
-    cgre_node_initialize(&(members[342]), 43881, NULL);
-    cgre_node_initialize(&(members[343]), 30887, NULL);
-    cgre_node_initialize(&(members[344]), 5594, NULL);
-    cgre_node_initialize(&(members[345]), 34001, NULL);
-    cgre_node_initialize(&(members[346]), 2561, NULL);
-    cgre_node_initialize(&(members[347]), 63574, NULL);
-    cgre_node_initialize(&(members[348]), 16105, NULL);
-    cgre_node_initialize(&(members[349]), 99116, NULL);
-    cgre_node_initialize(&(members[350]), 26888, NULL);
-    cgre_node_initialize(&(members[351]), 9009, NULL);
-    cgre_node_initialize(&(members[352]), 65809, NULL);
-    cgre_node_initialize(&(members[353]), 80618, NULL);
-    cgre_node_initialize(&(members[354]), 62752, NULL);
-    cgre_node_initialize(&(members[355]), 73340, NULL);
-    cgre_node_initialize(&(members[356]), 81609, NULL);
-    cgre_node_initialize(&(members[357]), 2120, NULL);
-    cgre_node_initialize(&(members[358]), 99456, NULL);
-    cgre_node_initialize(&(members[359]), 78081, NULL);
-    cgre_node_initialize(&(members[360]), 27321, NULL);
-    cgre_node_initialize(&(members[361]), 57879, NULL);
-    cgre_node_initialize(&(members[362]), 15917, NULL);
-    cgre_node_initialize(&(members[363]), 46027, NULL);
-    cgre_node_initialize(&(members[364]), 19058, NULL);
-    cgre_node_initialize(&(members[365]), 98618, NULL);
-    cgre_node_initialize(&(members[366]), 9902, NULL);
-    cgre_node_initialize(&(members[367]), 5673, NULL);
-    cgre_node_initialize(&(members[368]), 78496, NULL);
-    cgre_node_initialize(&(members[369]), 96564, NULL);
-    cgre_node_initialize(&(members[370]), 56095, NULL);
-    cgre_node_initialize(&(members[371]), 76174, NULL);
-    cgre_node_initialize(&(members[372]), 61483, NULL);
-    cgre_node_initialize(&(members[373]), 75971, NULL);
-    cgre_node_initialize(&(members[374]), 82978, NULL);
-    cgre_node_initialize(&(members[375]), 15584, NULL);
-    cgre_node_initialize(&(members[376]), 5841, NULL);
-    cgre_node_initialize(&(members[377]), 70656, NULL);
-    cgre_node_initialize(&(members[378]), 69129, NULL);
-    cgre_node_initialize(&(members[379]), 24573, NULL);
-    cgre_node_initialize(&(members[380]), 42987, NULL);
-    cgre_node_initialize(&(members[381]), 29687, NULL);
-    cgre_node_initialize(&(members[382]), 87268, NULL);
-    cgre_node_initialize(&(members[383]), 68471, NULL);
-    cgre_node_initialize(&(members[384]), 18366, NULL);
-    cgre_node_initialize(&(members[385]), 6866, NULL);
-    cgre_node_initialize(&(members[386]), 3288, NULL);
-    cgre_node_initialize(&(members[387]), 85903, NULL);
-    cgre_node_initialize(&(members[388]), 49396, NULL);
-    cgre_node_initialize(&(members[389]), 32459, NULL);
-    cgre_node_initialize(&(members[390]), 93963, NULL);
-    cgre_node_initialize(&(members[391]), 16613, NULL);
-    cgre_node_initialize(&(members[392]), 37868, NULL);
-    cgre_node_initialize(&(members[393]), 63419, NULL);
-    cgre_node_initialize(&(members[394]), 94943, NULL);
-    cgre_node_initialize(&(members[395]), 83012, NULL);
-    cgre_node_initialize(&(members[396]), 85439, NULL);
-    cgre_node_initialize(&(members[397]), 67501, NULL);
-    cgre_node_initialize(&(members[398]), 50795, NULL);
-    cgre_node_initialize(&(members[399]), 38049, NULL);
-    cgre_node_initialize(&(members[400]), 39217, NULL);
-    cgre_node_initialize(&(members[401]), 38398, NULL);
-    cgre_node_initialize(&(members[402]), 84721, NULL);
-    cgre_node_initialize(&(members[403]), 68722, NULL);
-    cgre_node_initialize(&(members[404]), 40237, NULL);
-    cgre_node_initialize(&(members[405]), 74818, NULL);
-    cgre_node_initialize(&(members[406]), 57764, NULL);
-    cgre_node_initialize(&(members[407]), 23388, NULL);
-    cgre_node_initialize(&(members[408]), 88001, NULL);
-    cgre_node_initialize(&(members[409]), 57839, NULL);
-    cgre_node_initialize(&(members[410]), 25094, NULL);
-    cgre_node_initialize(&(members[411]), 17452, NULL);
-    cgre_node_initialize(&(members[412]), 92763, NULL);
-    cgre_node_initialize(&(members[413]), 90569, NULL);
-    cgre_node_initialize(&(members[414]), 34163, NULL);
-    cgre_node_initialize(&(members[415]), 93528, NULL);
-    cgre_node_initialize(&(members[416]), 93042, NULL);
-    cgre_node_initialize(&(members[417]), 73168, NULL);
-    cgre_node_initialize(&(members[418]), 32090, NULL);
-    cgre_node_initialize(&(members[419]), 69905, NULL);
-    cgre_node_initialize(&(members[420]), 71771, NULL);
-    cgre_node_initialize(&(members[421]), 94802, NULL);
-    cgre_node_initialize(&(members[422]), 52523, NULL);
-    cgre_node_initialize(&(members[423]), 19962, NULL);
-    cgre_node_initialize(&(members[424]), 58099, NULL);
-    cgre_node_initialize(&(members[425]), 82834, NULL);
-    cgre_node_initialize(&(members[426]), 2595, NULL);
-    cgre_node_initialize(&(members[427]), 99433, NULL);
-    cgre_node_initialize(&(members[428]), 28181, NULL);
-    cgre_node_initialize(&(members[429]), 75427, NULL);
-    cgre_node_initialize(&(members[430]), 7742, NULL);
-    cgre_node_initialize(&(members[431]), 27574, NULL);
-    cgre_node_initialize(&(members[432]), 54237, NULL);
-    cgre_node_initialize(&(members[433]), 61084, NULL);
-    cgre_node_initialize(&(members[434]), 48211, NULL);
-    cgre_node_initialize(&(members[435]), 23459, NULL);
-    cgre_node_initialize(&(members[436]), 64280, NULL);
-    cgre_node_initialize(&(members[437]), 83856, NULL);
-    cgre_node_initialize(&(members[438]), 24599, NULL);
-    cgre_node_initialize(&(members[439]), 4024, NULL);
-    cgre_node_initialize(&(members[440]), 24174, NULL);
-    cgre_node_initialize(&(members[441]), 23672, NULL);
-    cgre_node_initialize(&(members[442]), 23888, NULL);
-    cgre_node_initialize(&(members[443]), 80149, NULL);
-    cgre_node_initialize(&(members[444]), 509, NULL);
-    cgre_node_initialize(&(members[445]), 5848, NULL);
-    cgre_node_initialize(&(members[446]), 29551, NULL);
-    cgre_node_initialize(&(members[447]), 11797, NULL);
-    cgre_node_initialize(&(members[448]), 16228, NULL);
-    cgre_node_initialize(&(members[449]), 7979, NULL);
-    cgre_node_initialize(&(members[450]), 40494, NULL);
-    cgre_node_initialize(&(members[451]), 6958, NULL);
-    cgre_node_initialize(&(members[452]), 61387, NULL);
-    cgre_node_initialize(&(members[453]), 23845, NULL);
-    cgre_node_initialize(&(members[454]), 96695, NULL);
-    cgre_node_initialize(&(members[455]), 74677, NULL);
-    cgre_node_initialize(&(members[456]), 12415, NULL);
-    cgre_node_initialize(&(members[457]), 69439, NULL);
-    cgre_node_initialize(&(members[458]), 68274, NULL);
-    cgre_node_initialize(&(members[459]), 46946, NULL);
-    cgre_node_initialize(&(members[460]), 37678, NULL);
-    cgre_node_initialize(&(members[461]), 11174, NULL);
-    cgre_node_initialize(&(members[462]), 13253, NULL);
-    cgre_node_initialize(&(members[463]), 31995, NULL);
-    cgre_node_initialize(&(members[464]), 25764, NULL);
-    cgre_node_initialize(&(members[465]), 36022, NULL);
-    cgre_node_initialize(&(members[466]), 92976, NULL);
-    cgre_node_initialize(&(members[467]), 76350, NULL);
-    cgre_node_initialize(&(members[468]), 65960, NULL);
-    cgre_node_initialize(&(members[469]), 93496, NULL);
-    cgre_node_initialize(&(members[470]), 30479, NULL);
-    cgre_node_initialize(&(members[471]), 85161, NULL);
-    cgre_node_initialize(&(members[472]), 37508, NULL);
-    cgre_node_initialize(&(members[473]), 60820, NULL);
-    cgre_node_initialize(&(members[474]), 62799, NULL);
-    cgre_node_initialize(&(members[475]), 60982, NULL);
-    cgre_node_initialize(&(members[476]), 9682, NULL);
-    cgre_node_initialize(&(members[477]), 78553, NULL);
-    cgre_node_initialize(&(members[478]), 75547, NULL);
-    cgre_node_initialize(&(members[479]), 83704, NULL);
-    cgre_node_initialize(&(members[480]), 19018, NULL);
-    cgre_node_initialize(&(members[481]), 45452, NULL);
-    cgre_node_initialize(&(members[482]), 74585, NULL);
-    cgre_node_initialize(&(members[483]), 31520, NULL);
-    cgre_node_initialize(&(members[484]), 7239, NULL);
-    cgre_node_initialize(&(members[485]), 86753, NULL);
-    cgre_node_initialize(&(members[486]), 24594, NULL);
-    cgre_node_initialize(&(members[487]), 77033, NULL);
-    cgre_node_initialize(&(members[488]), 48981, NULL);
-    cgre_node_initialize(&(members[489]), 23057, NULL);
-    cgre_node_initialize(&(members[490]), 32250, NULL);
-    cgre_node_initialize(&(members[491]), 87305, NULL);
-    cgre_node_initialize(&(members[492]), 80460, NULL);
-    cgre_node_initialize(&(members[493]), 71134, NULL);
-    cgre_node_initialize(&(members[494]), 56073, NULL);
-    cgre_node_initialize(&(members[495]), 97314, NULL);
-    cgre_node_initialize(&(members[496]), 10436, NULL);
-    cgre_node_initialize(&(members[497]), 51686, NULL);
-    cgre_node_initialize(&(members[498]), 27081, NULL);
-    cgre_node_initialize(&(members[499]), 98556, NULL);
-    cgre_node_initialize(&(members[500]), 44700, NULL);
-    cgre_node_initialize(&(members[501]), 15911, NULL);
-    cgre_node_initialize(&(members[502]), 90427, NULL);
-    cgre_node_initialize(&(members[503]), 20748, NULL);
-    cgre_node_initialize(&(members[504]), 43961, NULL);
-    cgre_node_initialize(&(members[505]), 50600, NULL);
-    cgre_node_initialize(&(members[506]), 84863, NULL);
-    cgre_node_initialize(&(members[507]), 87023, NULL);
-    cgre_node_initialize(&(members[508]), 83049, NULL);
-    cgre_node_initialize(&(members[509]), 91598, NULL);
-    cgre_node_initialize(&(members[510]), 6743, NULL);
-    cgre_node_initialize(&(members[511]), 97938, NULL);
-    cgre_node_initialize(&(members[512]), 23022, NULL);
-    cgre_node_initialize(&(members[513]), 15433, NULL);
-    cgre_node_initialize(&(members[514]), 25730, NULL);
-    cgre_node_initialize(&(members[515]), 16107, NULL);
-    cgre_node_initialize(&(members[516]), 88715, NULL);
-    cgre_node_initialize(&(members[517]), 16601, NULL);
-    cgre_node_initialize(&(members[518]), 83985, NULL);
-    cgre_node_initialize(&(members[519]), 64722, NULL);
-    cgre_node_initialize(&(members[520]), 85875, NULL);
-    cgre_node_initialize(&(members[521]), 60697, NULL);
-    cgre_node_initialize(&(members[522]), 61148, NULL);
-    cgre_node_initialize(&(members[523]), 16045, NULL);
-    cgre_node_initialize(&(members[524]), 7067, NULL);
-    cgre_node_initialize(&(members[525]), 27537, NULL);
-    cgre_node_initialize(&(members[526]), 56421, NULL);
-    cgre_node_initialize(&(members[527]), 11885, NULL);
-    cgre_node_initialize(&(members[528]), 84091, NULL);
-    cgre_node_initialize(&(members[529]), 29759, NULL);
-    cgre_node_initialize(&(members[530]), 99576, NULL);
-    cgre_node_initialize(&(members[531]), 91822, NULL);
-    cgre_node_initialize(&(members[532]), 86590, NULL);
-    cgre_node_initialize(&(members[533]), 85999, NULL);
-    cgre_node_initialize(&(members[534]), 4040, NULL);
-    cgre_node_initialize(&(members[535]), 79720, NULL);
-    cgre_node_initialize(&(members[536]), 4526, NULL);
-    cgre_node_initialize(&(members[537]), 21250, NULL);
-    cgre_node_initialize(&(members[538]), 67614, NULL);
-    cgre_node_initialize(&(members[539]), 68876, NULL);
-    cgre_node_initialize(&(members[540]), 78117, NULL);
-    cgre_node_initialize(&(members[541]), 23488, NULL);
-    cgre_node_initialize(&(members[542]), 50228, NULL);
-    cgre_node_initialize(&(members[543]), 2197, NULL);
-    cgre_node_initialize(&(members[544]), 74970, NULL);
-    cgre_node_initialize(&(members[545]), 63509, NULL);
-    cgre_node_initialize(&(members[546]), 78616, NULL);
-    cgre_node_initialize(&(members[547]), 95639, NULL);
-    cgre_node_initialize(&(members[548]), 31849, NULL);
-    cgre_node_initialize(&(members[549]), 79451, NULL);
-    cgre_node_initialize(&(members[550]), 52516, NULL);
-    cgre_node_initialize(&(members[551]), 27250, NULL);
-    cgre_node_initialize(&(members[552]), 52822, NULL);
-    cgre_node_initialize(&(members[553]), 15548, NULL);
-    cgre_node_initialize(&(members[554]), 30119, NULL);
-    cgre_node_initialize(&(members[555]), 85443, NULL);
-    cgre_node_initialize(&(members[556]), 8411, NULL);
-    cgre_node_initialize(&(members[557]), 95447, NULL);
-    cgre_node_initialize(&(members[558]), 45796, NULL);
-    cgre_node_initialize(&(members[559]), 97371, NULL);
-    cgre_node_initialize(&(members[560]), 97986, NULL);
-    cgre_node_initialize(&(members[561]), 93831, NULL);
-    cgre_node_initialize(&(members[562]), 97016, NULL);
-    cgre_node_initialize(&(members[563]), 18593, NULL);
-    cgre_node_initialize(&(members[564]), 94895, NULL);
-    cgre_node_initialize(&(members[565]), 26164, NULL);
-    cgre_node_initialize(&(members[566]), 86293, NULL);
-    cgre_node_initialize(&(members[567]), 71756, NULL);
-    cgre_node_initialize(&(members[568]), 73343, NULL);
-    cgre_node_initialize(&(members[569]), 70008, NULL);
-    cgre_node_initialize(&(members[570]), 90604, NULL);
-    cgre_node_initialize(&(members[571]), 92508, NULL);
-    cgre_node_initialize(&(members[572]), 6909, NULL);
-    cgre_node_initialize(&(members[573]), 79716, NULL);
-    cgre_node_initialize(&(members[574]), 53404, NULL);
-    cgre_node_initialize(&(members[575]), 44849, NULL);
-    cgre_node_initialize(&(members[576]), 17983, NULL);
-    cgre_node_initialize(&(members[577]), 94421, NULL);
-    cgre_node_initialize(&(members[578]), 14842, NULL);
-    cgre_node_initialize(&(members[579]), 12190, NULL);
-    cgre_node_initialize(&(members[580]), 21768, NULL);
-    cgre_node_initialize(&(members[581]), 17918, NULL);
-    cgre_node_initialize(&(members[582]), 4548, NULL);
-    cgre_node_initialize(&(members[583]), 92858, NULL);
-    cgre_node_initialize(&(members[584]), 68735, NULL);
-    cgre_node_initialize(&(members[585]), 73353, NULL);
-    cgre_node_initialize(&(members[586]), 91237, NULL);
-    cgre_node_initialize(&(members[587]), 14667, NULL);
-    cgre_node_initialize(&(members[588]), 50962, NULL);
-    cgre_node_initialize(&(members[589]), 92573, NULL);
-    cgre_node_initialize(&(members[590]), 91602, NULL);
-    cgre_node_initialize(&(members[591]), 10636, NULL);
-    cgre_node_initialize(&(members[592]), 19451, NULL);
-    cgre_node_initialize(&(members[593]), 33527, NULL);
-    cgre_node_initialize(&(members[594]), 24714, NULL);
-    cgre_node_initialize(&(members[595]), 39044, NULL);
-    cgre_node_initialize(&(members[596]), 19803, NULL);
-    cgre_node_initialize(&(members[597]), 12292, NULL);
-    cgre_node_initialize(&(members[598]), 69535, NULL);
-    cgre_node_initialize(&(members[599]), 48757, NULL);
-    cgre_node_initialize(&(members[600]), 63000, NULL);
-    cgre_node_initialize(&(members[601]), 95007, NULL);
-    cgre_node_initialize(&(members[602]), 11056, NULL);
-    cgre_node_initialize(&(members[603]), 11576, NULL);
-    cgre_node_initialize(&(members[604]), 85661, NULL);
-    cgre_node_initialize(&(members[605]), 31483, NULL);
-    cgre_node_initialize(&(members[606]), 20859, NULL);
-    cgre_node_initialize(&(members[607]), 28901, NULL);
-    cgre_node_initialize(&(members[608]), 48913, NULL);
-    cgre_node_initialize(&(members[609]), 47909, NULL);
-    cgre_node_initialize(&(members[610]), 51162, NULL);
-    cgre_node_initialize(&(members[611]), 33781, NULL);
-    cgre_node_initialize(&(members[612]), 51806, NULL);
-    cgre_node_initialize(&(members[613]), 43238, NULL);
-    cgre_node_initialize(&(members[614]), 49462, NULL);
-    cgre_node_initialize(&(members[615]), 99255, NULL);
-    cgre_node_initialize(&(members[616]), 75879, NULL);
-    cgre_node_initialize(&(members[617]), 6704, NULL);
-    cgre_node_initialize(&(members[618]), 87742, NULL);
-    cgre_node_initialize(&(members[619]), 22404, NULL);
-    cgre_node_initialize(&(members[620]), 46376, NULL);
-    cgre_node_initialize(&(members[621]), 38886, NULL);
-    cgre_node_initialize(&(members[622]), 29346, NULL);
-    cgre_node_initialize(&(members[623]), 86258, NULL);
-    cgre_node_initialize(&(members[624]), 31922, NULL);
-    cgre_node_initialize(&(members[625]), 78169, NULL);
-    cgre_node_initialize(&(members[626]), 49596, NULL);
-    cgre_node_initialize(&(members[627]), 49950, NULL);
-    cgre_node_initialize(&(members[628]), 78474, NULL);
-    cgre_node_initialize(&(members[629]), 90036, NULL);
-    cgre_node_initialize(&(members[630]), 35121, NULL);
-    cgre_node_initialize(&(members[631]), 49059, NULL);
-    cgre_node_initialize(&(members[632]), 23001, NULL);
-    cgre_node_initialize(&(members[633]), 87774, NULL);
-    cgre_node_initialize(&(members[634]), 73940, NULL);
-    cgre_node_initialize(&(members[635]), 26720, NULL);
-    cgre_node_initialize(&(members[636]), 20109, NULL);
-    cgre_node_initialize(&(members[637]), 29047, NULL);
-    cgre_node_initialize(&(members[638]), 57529, NULL);
-    cgre_node_initialize(&(members[639]), 22764, NULL);
-    cgre_node_initialize(&(members[640]), 84059, NULL);
-    cgre_node_initialize(&(members[641]), 40078, NULL);
-    cgre_node_initialize(&(members[642]), 98608, NULL);
-    cgre_node_initialize(&(members[643]), 35016, NULL);
-    cgre_node_initialize(&(members[644]), 2276, NULL);
-    cgre_node_initialize(&(members[645]), 64545, NULL);
-    cgre_node_initialize(&(members[646]), 86238, NULL);
-    cgre_node_initialize(&(members[647]), 28549, NULL);
-    cgre_node_initialize(&(members[648]), 54715, NULL);
-    cgre_node_initialize(&(members[649]), 91088, NULL);
-    cgre_node_initialize(&(members[650]), 79355, NULL);
-    cgre_node_initialize(&(members[651]), 37028, NULL);
-    cgre_node_initialize(&(members[652]), 64758, NULL);
-    cgre_node_initialize(&(members[653]), 90529, NULL);
-    cgre_node_initialize(&(members[654]), 55823, NULL);
-    cgre_node_initialize(&(members[655]), 15423, NULL);
-    cgre_node_initialize(&(members[656]), 37786, NULL);
-    cgre_node_initialize(&(members[657]), 39509, NULL);
-    cgre_node_initialize(&(members[658]), 88702, NULL);
-    cgre_node_initialize(&(members[659]), 64066, NULL);
-    cgre_node_initialize(&(members[660]), 19855, NULL);
-    cgre_node_initialize(&(members[661]), 50188, NULL);
-    cgre_node_initialize(&(members[662]), 84966, NULL);
-    cgre_node_initialize(&(members[663]), 88520, NULL);
-    cgre_node_initialize(&(members[664]), 4662, NULL);
-    cgre_node_initialize(&(members[665]), 58668, NULL);
-    cgre_node_initialize(&(members[666]), 12240, NULL);
-    cgre_node_initialize(&(members[667]), 55421, NULL);
-    cgre_node_initialize(&(members[668]), 27701, NULL);
-    cgre_node_initialize(&(members[669]), 99425, NULL);
-    cgre_node_initialize(&(members[670]), 57400, NULL);
-    cgre_node_initialize(&(members[671]), 26670, NULL);
-    cgre_node_initialize(&(members[672]), 23911, NULL);
-    cgre_node_initialize(&(members[673]), 72860, NULL);
-    cgre_node_initialize(&(members[674]), 41504, NULL);
-    cgre_node_initialize(&(members[675]), 86955, NULL);
-    cgre_node_initialize(&(members[676]), 94447, NULL);
-    cgre_node_initialize(&(members[677]), 6617, NULL);
-    cgre_node_initialize(&(members[678]), 27270, NULL);
-    cgre_node_initialize(&(members[679]), 7885, NULL);
-    cgre_node_initialize(&(members[680]), 35805, NULL);
-    cgre_node_initialize(&(members[681]), 50300, NULL);
-    cgre_node_initialize(&(members[682]), 63692, NULL);
-    cgre_node_initialize(&(members[683]), 78853, NULL);
-    cgre_node_initialize(&(members[684]), 40573, NULL);
-    cgre_node_initialize(&(members[685]), 41706, NULL);
-    cgre_node_initialize(&(members[686]), 9115, NULL);
-    cgre_node_initialize(&(members[687]), 40202, NULL);
-    cgre_node_initialize(&(members[688]), 81115, NULL);
-    cgre_node_initialize(&(members[689]), 60641, NULL);
-    cgre_node_initialize(&(members[690]), 78209, NULL);
-    cgre_node_initialize(&(members[691]), 34626, NULL);
-    cgre_node_initialize(&(members[692]), 46848, NULL);
-    cgre_node_initialize(&(members[693]), 89396, NULL);
-    cgre_node_initialize(&(members[694]), 96690, NULL);
-    cgre_node_initialize(&(members[695]), 37322, NULL);
-    cgre_node_initialize(&(members[696]), 38329, NULL);
-    cgre_node_initialize(&(members[697]), 3271, NULL);
-    cgre_node_initialize(&(members[698]), 66309, NULL);
-    cgre_node_initialize(&(members[699]), 91797, NULL);
-    cgre_node_initialize(&(members[700]), 36510, NULL);
-    cgre_node_initialize(&(members[701]), 90481, NULL);
-    cgre_node_initialize(&(members[702]), 47775, NULL);
-    cgre_node_initialize(&(members[703]), 9266, NULL);
-    cgre_node_initialize(&(members[704]), 867, NULL);
-    cgre_node_initialize(&(members[705]), 88611, NULL);
-    cgre_node_initialize(&(members[706]), 84252, NULL);
-    cgre_node_initialize(&(members[707]), 25712, NULL);
-    cgre_node_initialize(&(members[708]), 14645, NULL);
-    cgre_node_initialize(&(members[709]), 92190, NULL);
-    cgre_node_initialize(&(members[710]), 20303, NULL);
-    cgre_node_initialize(&(members[711]), 74845, NULL);
-    cgre_node_initialize(&(members[712]), 62950, NULL);
-    cgre_node_initialize(&(members[713]), 48526, NULL);
-    cgre_node_initialize(&(members[714]), 91503, NULL);
-    cgre_node_initialize(&(members[715]), 44108, NULL);
-    cgre_node_initialize(&(members[716]), 9791, NULL);
-    cgre_node_initialize(&(members[717]), 29401, NULL);
-    cgre_node_initialize(&(members[718]), 86003, NULL);
-    cgre_node_initialize(&(members[719]), 73836, NULL);
-    cgre_node_initialize(&(members[720]), 70006, NULL);
-    cgre_node_initialize(&(members[721]), 21246, NULL);
-    cgre_node_initialize(&(members[722]), 81444, NULL);
-    cgre_node_initialize(&(members[723]), 75146, NULL);
-    cgre_node_initialize(&(members[724]), 80774, NULL);
-    cgre_node_initialize(&(members[725]), 19889, NULL);
-    cgre_node_initialize(&(members[726]), 49684, NULL);
-    cgre_node_initialize(&(members[727]), 61851, NULL);
-    cgre_node_initialize(&(members[728]), 20660, NULL);
-    cgre_node_initialize(&(members[729]), 42305, NULL);
-    cgre_node_initialize(&(members[730]), 78235, NULL);
-    cgre_node_initialize(&(members[731]), 94197, NULL);
-    cgre_node_initialize(&(members[732]), 8290, NULL);
-    cgre_node_initialize(&(members[733]), 44805, NULL);
-    cgre_node_initialize(&(members[734]), 57973, NULL);
-    cgre_node_initialize(&(members[735]), 96666, NULL);
-    cgre_node_initialize(&(members[736]), 83595, NULL);
-    cgre_node_initialize(&(members[737]), 86675, NULL);
-    cgre_node_initialize(&(members[738]), 39454, NULL);
-    cgre_node_initialize(&(members[739]), 75811, NULL);
-    cgre_node_initialize(&(members[740]), 86002, NULL);
-    cgre_node_initialize(&(members[741]), 1755, NULL);
-    cgre_node_initialize(&(members[742]), 6613, NULL);
-    cgre_node_initialize(&(members[743]), 47819, NULL);
-    cgre_node_initialize(&(members[744]), 5001, NULL);
-    cgre_node_initialize(&(members[745]), 56679, NULL);
-    cgre_node_initialize(&(members[746]), 20892, NULL);
-    cgre_node_initialize(&(members[747]), 37066, NULL);
-    cgre_node_initialize(&(members[748]), 89072, NULL);
-    cgre_node_initialize(&(members[749]), 14146, NULL);
-    cgre_node_initialize(&(members[750]), 83483, NULL);
-    cgre_node_initialize(&(members[751]), 36658, NULL);
-    cgre_node_initialize(&(members[752]), 99296, NULL);
-    cgre_node_initialize(&(members[753]), 54684, NULL);
-    cgre_node_initialize(&(members[754]), 83541, NULL);
-    cgre_node_initialize(&(members[755]), 70132, NULL);
-    cgre_node_initialize(&(members[756]), 25901, NULL);
-    cgre_node_initialize(&(members[757]), 5218, NULL);
-    cgre_node_initialize(&(members[758]), 23534, NULL);
-    cgre_node_initialize(&(members[759]), 14492, NULL);
-    cgre_node_initialize(&(members[760]), 59501, NULL);
-    cgre_node_initialize(&(members[761]), 49287, NULL);
-    cgre_node_initialize(&(members[762]), 85639, NULL);
-    cgre_node_initialize(&(members[763]), 6722, NULL);
-    cgre_node_initialize(&(members[764]), 40674, NULL);
-    cgre_node_initialize(&(members[765]), 19151, NULL);
-    cgre_node_initialize(&(members[766]), 47491, NULL);
-    cgre_node_initialize(&(members[767]), 55383, NULL);
-    cgre_node_initialize(&(members[768]), 65085, NULL);
-    cgre_node_initialize(&(members[769]), 59894, NULL);
-    cgre_node_initialize(&(members[770]), 45569, NULL);
-    cgre_node_initialize(&(members[771]), 11054, NULL);
-    cgre_node_initialize(&(members[772]), 56144, NULL);
-    cgre_node_initialize(&(members[773]), 81574, NULL);
-    cgre_node_initialize(&(members[774]), 79831, NULL);
-    cgre_node_initialize(&(members[775]), 46263, NULL);
-    cgre_node_initialize(&(members[776]), 28375, NULL);
-    cgre_node_initialize(&(members[777]), 66568, NULL);
-    cgre_node_initialize(&(members[778]), 90779, NULL);
-    cgre_node_initialize(&(members[779]), 11459, NULL);
-    cgre_node_initialize(&(members[780]), 36891, NULL);
-    cgre_node_initialize(&(members[781]), 39530, NULL);
-    cgre_node_initialize(&(members[782]), 46241, NULL);
-    cgre_node_initialize(&(members[783]), 99205, NULL);
-    cgre_node_initialize(&(members[784]), 39568, NULL);
-    cgre_node_initialize(&(members[785]), 1433, NULL);
-    cgre_node_initialize(&(members[786]), 17647, NULL);
-    cgre_node_initialize(&(members[787]), 93536, NULL);
-    cgre_node_initialize(&(members[788]), 25111, NULL);
-    cgre_node_initialize(&(members[789]), 37570, NULL);
-    cgre_node_initialize(&(members[790]), 5906, NULL);
-    cgre_node_initialize(&(members[791]), 48937, NULL);
-    cgre_node_initialize(&(members[792]), 44423, NULL);
-    cgre_node_initialize(&(members[793]), 43028, NULL);
-    cgre_node_initialize(&(members[794]), 53865, NULL);
-    cgre_node_initialize(&(members[795]), 84401, NULL);
-    cgre_node_initialize(&(members[796]), 87904, NULL);
-    cgre_node_initialize(&(members[797]), 40509, NULL);
-    cgre_node_initialize(&(members[798]), 997, NULL);
-    cgre_node_initialize(&(members[799]), 49907, NULL);
-    cgre_node_initialize(&(members[800]), 57934, NULL);
-    cgre_node_initialize(&(members[801]), 78914, NULL);
-    cgre_node_initialize(&(members[802]), 51629, NULL);
-    cgre_node_initialize(&(members[803]), 47469, NULL);
-    cgre_node_initialize(&(members[804]), 83755, NULL);
-    cgre_node_initialize(&(members[805]), 23595, NULL);
-    cgre_node_initialize(&(members[806]), 66605, NULL);
-    cgre_node_initialize(&(members[807]), 68043, NULL);
-    cgre_node_initialize(&(members[808]), 41542, NULL);
-    cgre_node_initialize(&(members[809]), 75740, NULL);
-    cgre_node_initialize(&(members[810]), 29987, NULL);
-    cgre_node_initialize(&(members[811]), 14286, NULL);
-    cgre_node_initialize(&(members[812]), 60817, NULL);
-    cgre_node_initialize(&(members[813]), 45316, NULL);
-    cgre_node_initialize(&(members[814]), 52722, NULL);
-    cgre_node_initialize(&(members[815]), 9226, NULL);
-    cgre_node_initialize(&(members[816]), 98119, NULL);
-    cgre_node_initialize(&(members[817]), 89303, NULL);
-    cgre_node_initialize(&(members[818]), 56777, NULL);
-    cgre_node_initialize(&(members[819]), 5398, NULL);
-    cgre_node_initialize(&(members[820]), 95411, NULL);
-    cgre_node_initialize(&(members[821]), 55762, NULL);
-    cgre_node_initialize(&(members[822]), 34524, NULL);
-    cgre_node_initialize(&(members[823]), 68140, NULL);
-    cgre_node_initialize(&(members[824]), 96946, NULL);
-    cgre_node_initialize(&(members[825]), 58673, NULL);
-    cgre_node_initialize(&(members[826]), 18765, NULL);
-    cgre_node_initialize(&(members[827]), 56376, NULL);
-    cgre_node_initialize(&(members[828]), 70875, NULL);
-    cgre_node_initialize(&(members[829]), 64913, NULL);
-    cgre_node_initialize(&(members[830]), 32995, NULL);
-    cgre_node_initialize(&(members[831]), 25017, NULL);
-    cgre_node_initialize(&(members[832]), 54167, NULL);
-    cgre_node_initialize(&(members[833]), 28247, NULL);
-    cgre_node_initialize(&(members[834]), 37208, NULL);
-    cgre_node_initialize(&(members[835]), 72700, NULL);
-    cgre_node_initialize(&(members[836]), 4179, NULL);
-    cgre_node_initialize(&(members[837]), 8622, NULL);
-    cgre_node_initialize(&(members[838]), 5518, NULL);
-    cgre_node_initialize(&(members[839]), 51655, NULL);
-    cgre_node_initialize(&(members[840]), 34765, NULL);
-    cgre_node_initialize(&(members[841]), 5380, NULL);
-    cgre_node_initialize(&(members[842]), 88662, NULL);
-    cgre_node_initialize(&(members[843]), 84964, NULL);
-    cgre_node_initialize(&(members[844]), 1733, NULL);
-    cgre_node_initialize(&(members[845]), 3860, NULL);
-    cgre_node_initialize(&(members[846]), 76833, NULL);
-    cgre_node_initialize(&(members[847]), 96667, NULL);
-    cgre_node_initialize(&(members[848]), 99967, NULL);
-    cgre_node_initialize(&(members[849]), 66802, NULL);
-    cgre_node_initialize(&(members[850]), 97398, NULL);
-    cgre_node_initialize(&(members[851]), 16531, NULL);
-    cgre_node_initialize(&(members[852]), 29464, NULL);
-    cgre_node_initialize(&(members[853]), 34917, NULL);
-    cgre_node_initialize(&(members[854]), 40826, NULL);
-    cgre_node_initialize(&(members[855]), 23335, NULL);
-    cgre_node_initialize(&(members[856]), 42320, NULL);
-    cgre_node_initialize(&(members[857]), 53951, NULL);
-    cgre_node_initialize(&(members[858]), 52646, NULL);
-    cgre_node_initialize(&(members[859]), 66104, NULL);
-    cgre_node_initialize(&(members[860]), 59456, NULL);
-    cgre_node_initialize(&(members[861]), 56883, NULL);
-    cgre_node_initialize(&(members[862]), 5217, NULL);
-    cgre_node_initialize(&(members[863]), 64419, NULL);
-    cgre_node_initialize(&(members[864]), 18064, NULL);
-    cgre_node_initialize(&(members[865]), 93747, NULL);
-    cgre_node_initialize(&(members[866]), 72238, NULL);
-    cgre_node_initialize(&(members[867]), 62328, NULL);
-    cgre_node_initialize(&(members[868]), 95851, NULL);
-    cgre_node_initialize(&(members[869]), 61044, NULL);
-    cgre_node_initialize(&(members[870]), 90343, NULL);
-    cgre_node_initialize(&(members[871]), 96937, NULL);
-    cgre_node_initialize(&(members[872]), 79394, NULL);
-    cgre_node_initialize(&(members[873]), 68594, NULL);
-    cgre_node_initialize(&(members[874]), 14850, NULL);
-    cgre_node_initialize(&(members[875]), 44263, NULL);
-    cgre_node_initialize(&(members[876]), 63215, NULL);
-    cgre_node_initialize(&(members[877]), 7865, NULL);
-    cgre_node_initialize(&(members[878]), 68671, NULL);
-    cgre_node_initialize(&(members[879]), 20582, NULL);
-    cgre_node_initialize(&(members[880]), 87488, NULL);
-    cgre_node_initialize(&(members[881]), 3295, NULL);
-    cgre_node_initialize(&(members[882]), 54511, NULL);
-    cgre_node_initialize(&(members[883]), 91748, NULL);
-    cgre_node_initialize(&(members[884]), 49100, NULL);
-    cgre_node_initialize(&(members[885]), 91813, NULL);
-    cgre_node_initialize(&(members[886]), 37007, NULL);
-    cgre_node_initialize(&(members[887]), 75480, NULL);
-    cgre_node_initialize(&(members[888]), 62877, NULL);
-    cgre_node_initialize(&(members[889]), 26117, NULL);
-    cgre_node_initialize(&(members[890]), 94651, NULL);
-    cgre_node_initialize(&(members[891]), 49014, NULL);
-    cgre_node_initialize(&(members[892]), 39665, NULL);
-    cgre_node_initialize(&(members[893]), 46931, NULL);
-    cgre_node_initialize(&(members[894]), 24947, NULL);
-    cgre_node_initialize(&(members[895]), 36121, NULL);
-    cgre_node_initialize(&(members[896]), 71208, NULL);
-    cgre_node_initialize(&(members[897]), 8556, NULL);
-    cgre_node_initialize(&(members[898]), 86176, NULL);
-    cgre_node_initialize(&(members[899]), 44075, NULL);
-    cgre_node_initialize(&(members[900]), 6372, NULL);
-    cgre_node_initialize(&(members[901]), 81840, NULL);
-    cgre_node_initialize(&(members[902]), 70701, NULL);
-    cgre_node_initialize(&(members[903]), 80771, NULL);
-    cgre_node_initialize(&(members[904]), 31851, NULL);
-    cgre_node_initialize(&(members[905]), 93133, NULL);
-    cgre_node_initialize(&(members[906]), 91406, NULL);
-    cgre_node_initialize(&(members[907]), 47986, NULL);
-    cgre_node_initialize(&(members[908]), 73260, NULL);
-    cgre_node_initialize(&(members[909]), 26773, NULL);
-    cgre_node_initialize(&(members[910]), 94737, NULL);
-    cgre_node_initialize(&(members[911]), 21745, NULL);
-    cgre_node_initialize(&(members[912]), 38900, NULL);
-    cgre_node_initialize(&(members[913]), 22033, NULL);
-    cgre_node_initialize(&(members[914]), 43283, NULL);
-    cgre_node_initialize(&(members[915]), 94898, NULL);
-    cgre_node_initialize(&(members[916]), 44643, NULL);
-    cgre_node_initialize(&(members[917]), 8286, NULL);
-    cgre_node_initialize(&(members[918]), 3370, NULL);
-    cgre_node_initialize(&(members[919]), 79191, NULL);
-    cgre_node_initialize(&(members[920]), 24195, NULL);
-    cgre_node_initialize(&(members[921]), 53575, NULL);
-    cgre_node_initialize(&(members[922]), 7791, NULL);
-    cgre_node_initialize(&(members[923]), 34746, NULL);
-    cgre_node_initialize(&(members[924]), 72092, NULL);
-    cgre_node_initialize(&(members[925]), 30594, NULL);
-    cgre_node_initialize(&(members[926]), 62001, NULL);
-    cgre_node_initialize(&(members[927]), 32143, NULL);
-    cgre_node_initialize(&(members[928]), 33385, NULL);
-    cgre_node_initialize(&(members[929]), 54589, NULL);
-    cgre_node_initialize(&(members[930]), 27152, NULL);
-    cgre_node_initialize(&(members[931]), 57286, NULL);
-    cgre_node_initialize(&(members[932]), 65558, NULL);
-    cgre_node_initialize(&(members[933]), 68574, NULL);
-    cgre_node_initialize(&(members[934]), 1704, NULL);
-    cgre_node_initialize(&(members[935]), 98474, NULL);
-    cgre_node_initialize(&(members[936]), 70484, NULL);
-    cgre_node_initialize(&(members[937]), 37358, NULL);
-    cgre_node_initialize(&(members[938]), 56044, NULL);
-    cgre_node_initialize(&(members[939]), 97218, NULL);
-    cgre_node_initialize(&(members[940]), 51482, NULL);
-    cgre_node_initialize(&(members[941]), 81148, NULL);
-    cgre_node_initialize(&(members[942]), 27549, NULL);
-    cgre_node_initialize(&(members[943]), 20241, NULL);
-    cgre_node_initialize(&(members[944]), 56899, NULL);
-    cgre_node_initialize(&(members[945]), 28274, NULL);
-    cgre_node_initialize(&(members[946]), 62626, NULL);
-    cgre_node_initialize(&(members[947]), 35118, NULL);
-    cgre_node_initialize(&(members[948]), 31076, NULL);
-    cgre_node_initialize(&(members[949]), 20052, NULL);
-    cgre_node_initialize(&(members[950]), 29447, NULL);
-    cgre_node_initialize(&(members[951]), 17964, NULL);
-    cgre_node_initialize(&(members[952]), 23120, NULL);
-    cgre_node_initialize(&(members[953]), 33686, NULL);
-    cgre_node_initialize(&(members[954]), 70158, NULL);
-    cgre_node_initialize(&(members[955]), 28445, NULL);
-    cgre_node_initialize(&(members[956]), 25216, NULL);
-    cgre_node_initialize(&(members[957]), 20326, NULL);
-    cgre_node_initialize(&(members[958]), 15326, NULL);
-    cgre_node_initialize(&(members[959]), 84744, NULL);
-    cgre_node_initialize(&(members[960]), 55030, NULL);
-    cgre_node_initialize(&(members[961]), 93973, NULL);
-    cgre_node_initialize(&(members[962]), 12648, NULL);
-    cgre_node_initialize(&(members[963]), 53105, NULL);
-    cgre_node_initialize(&(members[964]), 40354, NULL);
-    cgre_node_initialize(&(members[965]), 75797, NULL);
-    cgre_node_initialize(&(members[966]), 39889, NULL);
-    cgre_node_initialize(&(members[967]), 93489, NULL);
-    cgre_node_initialize(&(members[968]), 43549, NULL);
-    cgre_node_initialize(&(members[969]), 53661, NULL);
-    cgre_node_initialize(&(members[970]), 80262, NULL);
-    cgre_node_initialize(&(members[971]), 53325, NULL);
-    cgre_node_initialize(&(members[972]), 49626, NULL);
-    cgre_node_initialize(&(members[973]), 46734, NULL);
-    cgre_node_initialize(&(members[974]), 63183, NULL);
-    cgre_node_initialize(&(members[975]), 29234, NULL);
-    cgre_node_initialize(&(members[976]), 78039, NULL);
-    cgre_node_initialize(&(members[977]), 77756, NULL);
-    cgre_node_initialize(&(members[978]), 57836, NULL);
-    cgre_node_initialize(&(members[979]), 65700, NULL);
-    cgre_node_initialize(&(members[980]), 11840, NULL);
-    cgre_node_initialize(&(members[981]), 78020, NULL);
-    cgre_node_initialize(&(members[982]), 35113, NULL);
-    cgre_node_initialize(&(members[983]), 2239, NULL);
-    cgre_node_initialize(&(members[984]), 10298, NULL);
-    cgre_node_initialize(&(members[985]), 20807, NULL);
-    cgre_node_initialize(&(members[986]), 35882, NULL);
-    cgre_node_initialize(&(members[987]), 7933, NULL);
-    cgre_node_initialize(&(members[988]), 12470, NULL);
-    cgre_node_initialize(&(members[989]), 66596, NULL);
-    cgre_node_initialize(&(members[990]), 77906, NULL);
-    cgre_node_initialize(&(members[991]), 16419, NULL);
-    cgre_node_initialize(&(members[992]), 63609, NULL);
-    cgre_node_initialize(&(members[993]), 70700, NULL);
-    cgre_node_initialize(&(members[994]), 72835, NULL);
-    cgre_node_initialize(&(members[995]), 73228, NULL);
-    cgre_node_initialize(&(members[996]), 60452, NULL);
-    cgre_node_initialize(&(members[997]), 47915, NULL);
-    cgre_node_initialize(&(members[998]), 10930, NULL);
-    cgre_node_initialize(&(members[999]), 26831, NULL);
-    return members;
+    clock_t start, end;
+    struct cgre_node_set tree;
+    cgre_node_set_initialize(&tree);
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        order[idx] = &(members[idx]);
+    }
+    start = clockperf_wall();
+    cgre_tree_build(&tree, order, count);
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    free(members);
+    free(order);
+    return (end - start);
+}
+
+clock_t cgre_tree_insert_1m()
+{
+    return tree_insert_stepped(1000000, 2654435761u);
+}
+
+clock_t cgre_tree_insert_10m()
+{
+    return tree_insert_stepped(10000000, 2654435761u);
+}
+
+clock_t cgre_tree_delete_1m()
+{
+    return tree_delete_stepped(1000000, 2654435761u);
+}
+
+clock_t cgre_tree_delete_10m()
+{
+    return tree_delete_stepped(10000000, 2654435761u);
+}
+
+clock_t cgre_tree_build_1m()
+{
+    return tree_build_stepped(1000000, 2654435761u);
+}
+
+clock_t cgre_tree_build_10m()
+{
+    return tree_build_stepped(10000000, 2654435761u);
+}
+
+clock_t cgre_tree_insert_sorted_1m()
+{
+    return tree_insert_stepped(1000000, 1);
+}
+
+clock_t cgre_tree_build_sorted_1m()
+{
+    return tree_build_stepped(1000000, 1);
 }
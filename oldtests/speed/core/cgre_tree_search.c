@@ -0,0 +1,163 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cgre/cgre.h>
+#include "cgre-clockperf.h"
+
+#define TREE_SEARCH_MEMBERS 100000
+#define TREE_SEARCH_OPS 100000
+
+struct tree_search_reader {
+    struct cgre_node_set* tree;
+    cgre_uint_t members;
+    unsigned int seed;
+};
+
+static void* tree_search_run(void* arg)
+{
+    struct tree_search_reader* reader = (struct tree_search_reader*) arg;
+    cgre_uint_t sum = 0;
+    for (cgre_int_t idx = 0; idx < TREE_SEARCH_OPS; idx++) {
+        struct cgre_node* found = cgre_tree_search(reader->tree,
+                (cgre_uint_t) (rand_r(&(reader->seed)) % reader->members));
+        sum += (found != NULL) ? found->key : 0;
+    }
+    volatile cgre_uint_t result = sum;
+    (void) result;
+    return NULL;
+}
+
+static clock_t tree_search_readers(cgre_uint_t mode, int threads,
+        cgre_uint_t count)
+{
+    struct cgre_node_set tree;
+    struct tree_search_reader readers[threads];
+    pthread_t handles[threads];
+    cgre_node_set_initialize(&tree);
+    CGRE_NODES_MODE_SET_VALUE(tree.state, mode);
+    struct cgre_node* members = malloc(
+            sizeof(struct cgre_node) * count);
+    if (members == NULL) {
+        return 0;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_node_initialize(&(members[idx]), idx, NULL);
+        cgre_tree_insert(&tree, &(members[idx]));
+    }
+    clock_t start, end;
+    start = clockperf_wall();
+    for (int thread = 0; thread < threads; thread++) {
+        readers[thread].tree = &tree;
+        readers[thread].members = count;
+        readers[thread].seed = thread + 1;
+        pthread_create(&(handles[thread]), NULL, tree_search_run,
+                &(readers[thread]));
+    }
+    for (int thread = 0; thread < threads; thread++) {
+        pthread_join(handles[thread], NULL);
+    }
+    end = clockperf_wall();
+    cgre_node_set_uninitialize(&tree);
+    free(members);
+    return (end - start);
+}
+
+clock_t cgre_tree_search_locked_1t()
+{
+    return tree_search_readers(CGRE_TREE_LOCKED, 1, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_locked_2t()
+{
+    return tree_search_readers(CGRE_TREE_LOCKED, 2, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_locked_4t()
+{
+    return tree_search_readers(CGRE_TREE_LOCKED, 4, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_locked_8t()
+{
+    return tree_search_readers(CGRE_TREE_LOCKED, 8, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_optimistic_1t()
+{
+    return tree_search_readers(CGRE_TREE_OPTIMISTIC, 1, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_optimistic_2t()
+{
+    return tree_search_readers(CGRE_TREE_OPTIMISTIC, 2, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_optimistic_4t()
+{
+    return tree_search_readers(CGRE_TREE_OPTIMISTIC, 4, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_optimistic_8t()
+{
+    return tree_search_readers(CGRE_TREE_OPTIMISTIC, 8, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_btree_1t()
+{
+    return tree_search_readers(CGRE_TREE_BTREE, 1, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_btree_2t()
+{
+    return tree_search_readers(CGRE_TREE_BTREE, 2, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_btree_4t()
+{
+    return tree_search_readers(CGRE_TREE_BTREE, 4, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_btree_8t()
+{
+    return tree_search_readers(CGRE_TREE_BTREE, 8, TREE_SEARCH_MEMBERS);
+}
+
+clock_t cgre_tree_search_locked_1m()
+{
+    return tree_search_readers(CGRE_TREE_LOCKED, 1, 1000000);
+}
+
+clock_t cgre_tree_search_btree_1m()
+{
+    return tree_search_readers(CGRE_TREE_BTREE, 1, 1000000);
+}
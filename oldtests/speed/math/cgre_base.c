@@ -30,28 +30,37 @@ SOFTWARE.
 
 #include <time.h>
 #include <cgre/cgre.h>
+#include "cgre-clockperf.h"
 
+#define ATAN2_INPUTS 64
 
-clock_t cgre_base_atan2_10k()
+/* Calls CGRE_ATAN2 over run-time inputs so none of it folds away */
+static clock_t cgre_base_atan2(int total)
 {
-    clock_t start, end;
-    start = clock();
-    volatile cgre_real_t result;
-    for (int counter = 0; counter < 10000; counter++) {
-        result = CGRE_ATAN2(1.0, 1.0); 
+    cgre_real_t inputs[ATAN2_INPUTS];
+    volatile cgre_real_t step = 0.0625;
+    for (int idx = 0; idx < ATAN2_INPUTS; idx++) {
+        inputs[idx] = step * (idx + 1) - 2.0;
+    }
+    cgre_real_t sum = 0.0;
+    clock_t start = clockperf_wall();
+    for (int counter = 0; counter < total; counter++) {
+        sum += CGRE_ATAN2(
+            inputs[counter & (ATAN2_INPUTS - 1)],
+            inputs[(counter + 7) & (ATAN2_INPUTS - 1)]);
     }
-    end = clock();
+    clock_t end = clockperf_wall();
+    volatile cgre_real_t result = sum;
+    (void) result;
     return (end - start);
 }
 
+clock_t cgre_base_atan2_10k()
+{
+    return cgre_base_atan2(10000);
+}
+
 clock_t cgre_base_atan2_100k()
 {
-    clock_t start, end;
-    start = clock();
-    volatile cgre_real_t result;
-    for (int counter = 0; counter < 100000; counter++) {
-        result = CGRE_ATAN2(1.0, 1.0); 
-    }
-    end = clock();
-    return (end - start);
+    return cgre_base_atan2(100000);
 }
@@ -30,34 +30,38 @@ SOFTWARE.
 
 #include <time.h>
 #include <cgre/cgre.h>
+#include "cgre-clockperf.h"
 
+#define CLAMP_INPUTS 64
 
-clock_t cgre_real_clamp_10k()
+/* Clamps run-time inputs, half of them out of range, so none of it folds */
+static clock_t cgre_real_clamp(int total)
 {
-    clock_t start, end;
-    start = clock();
-    volatile cgre_real_t result;
-    for (int counter = 0; counter < 10000; counter++) {
-        result = CGRE_CLAMP(
-            (cgre_real_t) 1.5,
+    cgre_real_t inputs[CLAMP_INPUTS];
+    volatile cgre_real_t step = 0.125;
+    for (int idx = 0; idx < CLAMP_INPUTS; idx++) {
+        inputs[idx] = step * (idx + 1) - 4.0;
+    }
+    cgre_real_t sum = 0.0;
+    clock_t start = clockperf_wall();
+    for (int counter = 0; counter < total; counter++) {
+        sum += CGRE_CLAMP(
+            inputs[counter & (CLAMP_INPUTS - 1)],
             (cgre_real_t) -2.0,
             (cgre_real_t) 2.0);
     }
-    end = clock();
+    clock_t end = clockperf_wall();
+    volatile cgre_real_t result = sum;
+    (void) result;
     return (end - start);
 }
 
+clock_t cgre_real_clamp_10k()
+{
+    return cgre_real_clamp(10000);
+}
+
 clock_t cgre_real_clamp_100k()
 {
-    clock_t start, end;
-    start = clock();
-    volatile cgre_real_t result;
-    for (int counter = 0; counter < 100000; counter++) {
-        result = CGRE_CLAMP(
-            (cgre_real_t) 1.5,
-            (cgre_real_t) -2.0,
-            (cgre_real_t) 2.0);
-    }
-    end = clock();
-    return (end - start);
+    return cgre_real_clamp(100000);
 }
@@ -31,36 +31,38 @@ SOFTWARE.
 #include <assert.h>
 #include <time.h>
 #include <cgre/cgre.h>
+#include "cgre-clockperf.h"
 
+#define ANGLE_INPUTS 64
 
-clock_t cgre_vec2_oriented_angle_between_10k()
+/* Measures between run-time vectors so none of it folds away */
+static clock_t cgre_vec2_oriented_angle_between_run(int total)
 {
-    clock_t start, end;
-    struct cgre_vector2 v1 = {0.0, 0.0};
-    struct cgre_vector2 v2 = {0.0, 1.0};
-    volatile cgre_angular_t result;
-    start = clock();
-    for (int counter = 0; counter < 10000; counter++) {
-        result = cgre_vec2_oriented_angle_between(
-            &v1,
-            &v2);
+    struct cgre_vector2 inputs[ANGLE_INPUTS];
+    volatile cgre_real_t step = 0.0625;
+    for (int idx = 0; idx < ANGLE_INPUTS; idx++) {
+        inputs[idx].x = step * (idx + 1) - 2.0;
+        inputs[idx].y = 2.0 - step * idx;
+    }
+    cgre_angular_t sum = 0.0;
+    clock_t start = clockperf_wall();
+    for (int counter = 0; counter < total; counter++) {
+        sum += cgre_vec2_oriented_angle_between(
+            &(inputs[counter & (ANGLE_INPUTS - 1)]),
+            &(inputs[(counter + 7) & (ANGLE_INPUTS - 1)]));
     }
-    end = clock();
+    clock_t end = clockperf_wall();
+    volatile cgre_angular_t result = sum;
+    (void) result;
     return end - start;
 }
 
+clock_t cgre_vec2_oriented_angle_between_10k()
+{
+    return cgre_vec2_oriented_angle_between_run(10000);
+}
+
 clock_t cgre_vec2_oriented_angle_between_100k()
 {
-    clock_t start, end;
-    struct cgre_vector2 v1 = {0.0, 0.0};
-    struct cgre_vector2 v2 = {0.0, 1.0};
-    volatile cgre_angular_t result;
-    start = clock();
-    for (int counter = 0; counter < 100000; counter++) {
-        result = cgre_vec2_oriented_angle_between(
-            &v1,
-            &v2);
-    }
-    end = clock();
-    return end - start;
+    return cgre_vec2_oriented_angle_between_run(100000);
 }
@@ -30,8 +30,16 @@ SOFTWARE.
 
 #include <cgre/core/common.h>
 
+#include <sched.h>
+#include <stdlib.h>
 #include <string.h>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /* ifdef __linux__ */
+
 /**
  * @file include/cgre/core/common.h
  * @brief Core common header file
@@ -40,6 +48,44 @@ SOFTWARE.
  * declarations for core operations
  */
 
+/**
+ * @def CGRE_CACHE_LINE 64
+ * @brief Assumed cache line size in bytes
+ *
+ * Used to keep data written by different threads on separate cache lines.
+ */
+
+/**
+ * @def CGRE_NODES_PREFETCH 8
+ * @brief Members the batch operations fetch ahead of use
+ *
+ * Batches such as `cgre_tree_search_many()` keep this many lookups in flight,
+ * so their cache misses overlap instead of queueing behind each other.
+ */
+
+/**
+ * @def CGRE_NODE_LOCKS 64
+ * @brief Mutexes shared by the nodes of the compact layout
+ *
+ * `cgre_node_lock()` hashes a compact node to one of these, a power of 2.
+ */
+
+/**
+ * @def CGRE_NODE_COMPACT
+ * @brief Use the compact `cgre_node` layout
+ *
+ * Drops the unused `mode` and `state` fields and the embedded mutex, so a
+ * node takes 40 bytes instead of 88 on LP64 targets and over twice as many
+ * fit in each cache line of a traversal. The tree color stays in `dir`,
+ * which fills what would otherwise be padding after `key`, and
+ * `cgre_node_lock()` hands out a mutex from a shared table.
+ *
+ * This changes the layout of every `cgre_node`, so the library and all code
+ * using it must agree. Configure with `--enable-compact-node`, which passes
+ * `-DCGRE_NODE_COMPACT` to everything built in the tree, and define it for
+ * code built against the installed headers.
+ */
+
 /**
  * @def CGRE_NODE(N)
  * @brief Reference the node value
@@ -75,7 +121,7 @@ SOFTWARE.
  */
 
 /**
- * @def CGRE_NODES_MODE_SET(N, M) ((N & !3) | M)
+ * @def CGRE_NODES_MODE_SET(N, M) ((N & ~3) | M)
  * @brief Compute new mode of the collection
  *
  * Used when setting the mode ( last 2 bits ) of a Node collection such as
@@ -99,7 +145,7 @@ SOFTWARE.
  */
 
 /**
- * @def CGRE_NODES_LOCK(L, R) ((L & !4) | R)
+ * @def CGRE_NODES_LOCK(L, R) ((L & ~4) | R)
  * @brief Compute the lock result of the collection
  *
  * Used when setting the lock state ( 3rd bit ) of a Node collection such as
@@ -127,6 +173,82 @@ SOFTWARE.
  * @endcode
  */
 
+/**
+ * @def CGRE_LOCK_MUTEX 0
+ * @brief Lock policy guarding a set with a `pthread_mutex_t`
+ */
+
+/**
+ * @def CGRE_LOCK_FUTEX 16
+ * @brief Lock policy guarding a set with a one word futex lock
+ *
+ * Taking a free lock is a single CAS. A taken lock is spun on for up to
+ * `CGRE_LOCK_SPINS` tries before the thread sleeps in the kernel, and the
+ * kernel is only called on release when a thread sleeps.
+ */
+
+/**
+ * @def CGRE_LOCK_SPIN 32
+ * @brief Lock policy guarding a set with a one word spinlock
+ *
+ * Waiters spin then yield the processor, they never sleep. Suits sets held
+ * for a few instructions by threads that each have a core.
+ */
+
+/**
+ * @def CGRE_LOCK_NONE 48
+ * @brief Lock policy for sets only ever used by one thread
+ *
+ * Taking and releasing the lock does nothing.
+ */
+
+/**
+ * @def CGRE_LOCK_DEFAULT
+ * @brief Lock policy of sets set up by `cgre_node_set_initialize()`
+ *
+ * Configure `--with-lock=futex`, `spin` or `none` to change it. Any of those
+ * also drops the `pthread_mutex_t` from `union cgre_lock`, shrinking every
+ * set by the size of the mutex, and `CGRE_LOCK_MUTEX` falls back to
+ * `CGRE_LOCK_FUTEX`.
+ */
+
+/**
+ * @def CGRE_LOCK_SPINS 100
+ * @brief Tries on a taken futex lock before sleeping
+ */
+
+/**
+ * @def CGRE_NODES_LOCK_POLICY(N)
+ * @brief Get the lock policy bits from the state
+ */
+
+/**
+ * @union cgre_lock include/cgre/core/common.h <cgre/core/common.h>
+ * @brief Set lock
+ *
+ * @var pthread_mutex_t mutex
+ * Used by `CGRE_LOCK_MUTEX`, absent unless it is the default policy
+ * @var uint32_t word
+ * Used by the other policies, 0 when free, 1 when taken and 2 when taken
+ * with futex waiters
+ */
+
+/**
+ * @fn cgre_int_t cgre_node_set_lock(struct cgre_node_set* set)
+ * @brief Take the lock of a set following its lock policy
+ *
+ * @param[in] set The Node Set to lock
+ * @return 0 or the error of `pthread_mutex_lock()`
+ */
+
+/**
+ * @fn cgre_int_t cgre_node_set_unlock(struct cgre_node_set* set)
+ * @brief Release the lock of a set following its lock policy
+ *
+ * @param[in] set The Node Set to unlock
+ * @return 0 or the error of `pthread_mutex_unlock()`
+ */
+
 /**
  * @struct cgre_node include/cgre/core/common.h <cgre/core/common.h>
  * @brief Node struct
@@ -151,6 +273,8 @@ SOFTWARE.
  * Nodes do contain a lock that can be used to indicate that the value is
  * currently held by a thread. While the node itself can still be modified,
  * operations on the values should retain a lock while reading/writing.
+ * Reach it through `cgre_node_lock()`, which also covers the
+ * `CGRE_NODE_COMPACT` layout where `mode`, `state` and `lock` are absent.
  *
  * @var void* value
  * The pointer to the value of the node.
@@ -171,29 +295,319 @@ SOFTWARE.
  * `node.value`.
  */
 
+/**
+ * @struct cgre_node_store include/cgre/core/common.h <cgre/core/common.h>
+ * @brief Node Set storage header
+ *
+ * Collection modes that need memory beyond the member nodes, such as the
+ * `cgre_hash_list` table, allocate blocks starting with this header and hang
+ * them off `cgre_node_set.store`. The set owns these blocks and
+ * `cgre_node_set_uninitialize()` releases the whole chain.
+ *
+ * @var struct cgre_node_store* next
+ * The next block owned by the same set, or NULL
+ * @var cgre_uint_t size
+ * The number of slots in the block
+ * @var cgre_uint_t used
+ * The number of slots holding a member
+ */
+
+/**
+ * @struct cgre_array_cursor include/cgre/core/common.h <cgre/core/common.h>
+ * @brief Array Cursor
+ *
+ * Walks an array one member at a time without the indexed lookup of
+ * `cgre_array_get()`. Changing the array invalidates its cursors.
+ *
+ * @var struct cgre_node_set* array
+ * The array walked
+ * @var struct cgre_node* node
+ * The current member, or NULL when off either end
+ * @var cgre_uint_t index
+ * The index of the current member, `array->count` past the tail or
+ * `CGRE_ARRAY_CURSOR_BEFORE` before the head
+ */
+
+/**
+ * @struct cgre_node_pool include/cgre/core/common.h <cgre/core/common.h>
+ * @brief Node Pool
+ *
+ * Hands out nodes carved from slabs of `CGRE_NODE_POOL_SLAB` contiguous
+ * nodes, so members allocated together sit together in memory. Each thread
+ * keeps a magazine of free nodes per pool and only takes the pool lock to
+ * refill or flush it.
+ *
+ * @var struct cgre_node_store* store
+ * The slabs, newest first
+ * @var struct cgre_node* free
+ * Nodes flushed back by the threads, chained through `link[0]`
+ * @var cgre_uint_t state
+ * The pool state, records lock failures like `cgre_node_set.state`
+ * @var cgre_uint_t sequence
+ * Identifies this pool to the thread magazines
+ * @var pthread_mutex_t lock
+ * Guards `store` and `free`
+ */
+
+/**
+ * @struct cgre_epoch include/cgre/core/common.h <cgre/core/common.h>
+ * @brief Epoch Domain
+ *
+ * Defers releasing nodes removed from shared collections until no reader
+ * can still hold them. Readers announce the epoch they entered in, removed
+ * nodes wait in per-thread limbo lists tagged with the epoch they were
+ * retired in, and a list is released once the epoch has moved on twice.
+ *
+ * @var cgre_uint_t epoch
+ * The global epoch
+ * @var struct cgre_epoch_record* records
+ * One record per thread that used the domain, newest first
+ * @var void (*release)(void* context, struct cgre_node* node)
+ * Releases a node once it is safe, `free()` when NULL
+ * @var void* context
+ * Handed to `release`
+ * @var cgre_uint_t state
+ * The domain state
+ * @var cgre_uint_t sequence
+ * Identifies this domain to the thread caches
+ */
+
+/**
+ * @struct cgre_shard_map include/cgre/core/common.h <cgre/core/common.h>
+ * @brief Sharded Map
+ *
+ * A map split over independently locked `cgre_hash_list` tables, so threads
+ * working on different keys rarely wait on the same mutex.
+ *
+ * @var struct cgre_shard* shard
+ * The shards, each on its own cache lines
+ * @var cgre_uint_t size
+ * The number of shards, a power of 2
+ * @var cgre_uint_t state
+ * The map state, records lock failures like `cgre_node_set.state`
+ */
+
 /**
  * @brief Generate a hash from a key
  *
- * Generate a unique integer evaluating the bytes of a key. There is collision
- * like MD5 sums but for keys < 128 bytes long this works well.
+ * Hashes the bytes of a NUL terminated key with `cgre_hash_bytes()`.
  *
  * @param[in] key Value to be hashed
  * @return cgre_uint_t hash
  */
 cgre_uint_t cgre_hash(void* key)
 {
-    const char* s = (const char*) key;
-    cgre_uint_t sum = 0;
-    cgre_int_t interval = 0;
-    for (cgre_int_t idx = 0; s[idx] != 0; idx++) {
-        if (interval == 1) {
-            sum <<= sizeof(char);
-            interval--;
+    return (cgre_uint_t) cgre_hash_bytes(key, strlen((const char*) key), 0);
+}
+
+/**
+ * @brief Multiply two words and fold the 128 bit product onto itself
+ */
+static inline uint64_t cgre_hash_fold(
+        uint64_t first,
+        uint64_t second)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t product = (__uint128_t) first * second;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+#else
+    uint64_t low = (first & 0xFFFFFFFFu) * (second & 0xFFFFFFFFu);
+    uint64_t middle1 = (first >> 32) * (second & 0xFFFFFFFFu);
+    uint64_t middle2 = (first & 0xFFFFFFFFu) * (second >> 32);
+    uint64_t high = (first >> 32) * (second >> 32);
+    uint64_t carry = ((low >> 32) + (middle1 & 0xFFFFFFFFu) +
+            (middle2 & 0xFFFFFFFFu)) >> 32;
+    high += (middle1 >> 32) + (middle2 >> 32) + carry;
+    low += (middle1 << 32) + (middle2 << 32);
+    return low ^ high;
+#endif /* ifdef __SIZEOF_INT128__ */
+}
+
+static inline uint64_t cgre_hash_read64(
+        const unsigned char* bytes)
+{
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+static inline uint64_t cgre_hash_read32(
+        const unsigned char* bytes)
+{
+    uint32_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+/**
+ * @brief Generate a 64 bit hash from a run of bytes
+ *
+ * Bytes are folded 16 at a time by a 64 by 64 bit multiply, with three
+ * independent lanes covering 48 bytes per step on long input, so a single
+ * bit change spreads over the whole result. Keys need not be NUL terminated
+ * and may hold any byte.
+ *
+ * @code{.c}
+ * node.key = (cgre_uint_t) cgre_hash_bytes(name, length, 0);
+ * @endcode
+ *
+ * @param[in] data Bytes to hash
+ * @param[in] length Number of bytes
+ * @param[in] seed Value selecting an independent hash function
+ * @return 64 bit hash
+ *
+ * @remark
+ * Words are read in native byte order, so hashes differ between little and
+ * big endian machines and should not be stored.
+ */
+uint64_t cgre_hash_bytes(
+        const void* data,
+        size_t length,
+        uint64_t seed)
+{
+    const uint64_t prime0 = UINT64_C(0xa0761d6478bd642f);
+    const uint64_t prime1 = UINT64_C(0xe7037ed1a0b428db);
+    const uint64_t prime2 = UINT64_C(0x8ebc6af09c88c6e3);
+    const uint64_t prime3 = UINT64_C(0x589965cc75374cc3);
+    const unsigned char* bytes = (const unsigned char*) data;
+    uint64_t first, second;
+    seed ^= cgre_hash_fold(seed ^ prime0, prime1);
+    if (length <= 16) {
+        if (length >= 4) {
+            // Two overlapping reads from each end cover 4 to 16 bytes
+            size_t step = (length >> 3) << 2;
+            first = (cgre_hash_read32(bytes) << 32) |
+                    cgre_hash_read32(bytes + step);
+            second = (cgre_hash_read32(bytes + length - 4) << 32) |
+                    cgre_hash_read32(bytes + length - 4 - step);
+        } else if (length > 0) {
+            first = ((uint64_t) bytes[0] << 16) |
+                    ((uint64_t) bytes[length >> 1] << 8) |
+                    bytes[length - 1];
+            second = 0;
+        } else {
+            first = 0;
+            second = 0;
+        }
+    } else {
+        size_t left = length;
+        if (left > 48) {
+            uint64_t lane1 = seed, lane2 = seed;
+            do {
+                seed = cgre_hash_fold(cgre_hash_read64(bytes) ^ prime1,
+                        cgre_hash_read64(bytes + 8) ^ seed);
+                lane1 = cgre_hash_fold(cgre_hash_read64(bytes + 16) ^ prime2,
+                        cgre_hash_read64(bytes + 24) ^ lane1);
+                lane2 = cgre_hash_fold(cgre_hash_read64(bytes + 32) ^ prime3,
+                        cgre_hash_read64(bytes + 40) ^ lane2);
+                bytes += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (left > 16) {
+            seed = cgre_hash_fold(cgre_hash_read64(bytes) ^ prime1,
+                    cgre_hash_read64(bytes + 8) ^ seed);
+            bytes += 16;
+            left -= 16;
+        }
+        // The last 16 bytes, overlapping what came before when short
+        first = cgre_hash_read64(bytes + left - 16);
+        second = cgre_hash_read64(bytes + left - 8);
+    }
+    return cgre_hash_fold(prime1 ^ (uint64_t) length,
+            cgre_hash_fold(first ^ prime1, second ^ seed));
+}
+
+/**
+ * @brief Take a contended set lock word
+ *
+ * The slow path of `cgre_node_set_lock()`, once the uncontended CAS failed.
+ *
+ * @param[in] word The lock word
+ * @param[in] policy `CGRE_LOCK_FUTEX` or `CGRE_LOCK_SPIN`
+ * @return 0
+ */
+cgre_int_t cgre_lock_wait(
+        uint32_t* word,
+        cgre_uint_t policy)
+{
+    for (cgre_uint_t spins = 0;; spins++) {
+        uint32_t unlocked = 0;
+        if (__atomic_load_n(word, __ATOMIC_RELAXED) == 0 &&
+                __atomic_compare_exchange_n(word, &unlocked, 1, 0,
+                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return 0;
         }
-        sum ^= (cgre_int_t) s[idx];
-        interval++;
+        if (spins >= CGRE_LOCK_SPINS) {
+            if (policy == CGRE_LOCK_FUTEX) {
+                break;
+            }
+            // Let the holder run
+            sched_yield();
+        }
+#if defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#endif /* if defined(__i386__) || defined(__x86_64__) */
+    }
+    // Mark the lock as having a sleeper, and sleep until we take it
+    while (__atomic_exchange_n(word, 2, __ATOMIC_ACQUIRE) != 0) {
+#ifdef __linux__
+        syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+#else
+        sched_yield();
+#endif /* ifdef __linux__ */
     }
-    return sum;
+    return 0;
+}
+
+/**
+ * @brief Wake one thread sleeping on a futex lock word
+ *
+ * @param[in] word The lock word
+ */
+void cgre_lock_wake(
+        uint32_t* word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+    (void) word;
+#endif /* ifdef __linux__ */
+}
+
+#ifdef CGRE_NODE_COMPACT
+static struct cgre_node_lock_slot {
+    pthread_mutex_t lock;
+} __attribute__((aligned(CGRE_CACHE_LINE))) cgre_node_locks[CGRE_NODE_LOCKS] = {
+    [0 ... CGRE_NODE_LOCKS - 1] = {PTHREAD_MUTEX_INITIALIZER}
+};
+#endif /* ifdef CGRE_NODE_COMPACT */
+
+/**
+ * @brief Get the mutex guarding the value of a node
+ *
+ * The collections never take this lock, it is there for library operations
+ * that hold the object referenced at `node.value`.
+ *
+ * @param[in] node Node whose value is guarded
+ * @return pthread_mutex_t pointer
+ *
+ * @remark
+ * With `CGRE_NODE_COMPACT` the mutex is shared with the other nodes hashing
+ * to the same slot of a static table and is ready to use. Otherwise it is
+ * the node's own `lock`, which the caller initializes.
+ */
+pthread_mutex_t* cgre_node_lock(
+        struct cgre_node* node)
+{
+#ifdef CGRE_NODE_COMPACT
+    uint64_t slot = (uint64_t) (cgre_uintptr_t) node *
+        UINT64_C(0x9e3779b97f4a7c15);
+    return &(cgre_node_locks[(slot >> 32) & (CGRE_NODE_LOCKS - 1)].lock);
+#else
+    return &(node->lock);
+#endif /* ifdef CGRE_NODE_COMPACT */
 }
 
 /**
@@ -220,17 +634,56 @@ struct cgre_node* cgre_node_initialize(
 /**
  * @brief Initialize a Node Set
  *
+ * The set is guarded by the `CGRE_LOCK_DEFAULT` lock policy.
+ *
  * @param[in] set The Node Set to initialize
  */
 struct cgre_node_set* cgre_node_set_initialize(
         struct cgre_node_set* set)
 {
-    if (pthread_mutex_init(&(set->lock), NULL) != 0) {
+    return cgre_node_set_initialize_lock(set, CGRE_LOCK_DEFAULT);
+}
+
+/**
+ * @brief Initialize a Node Set with a lock policy
+ *
+ * @param[in] set The Node Set to initialize
+ * @param[in] policy One of `CGRE_LOCK_MUTEX`, `CGRE_LOCK_FUTEX`,
+ * `CGRE_LOCK_SPIN` or `CGRE_LOCK_NONE`
+ * @return set or NULL on error
+ *
+ * @code{.c}
+ * // Only touched by the render thread
+ * cgre_node_set_initialize_lock(&batches, CGRE_LOCK_NONE);
+ * @endcode
+ *
+ * @warning
+ * A `CGRE_LOCK_NONE` set must not be shared between threads.
+ */
+struct cgre_node_set* cgre_node_set_initialize_lock(
+        struct cgre_node_set* set,
+        cgre_uint_t policy)
+{
+    policy = CGRE_NODES_LOCK_POLICY(policy);
+#if CGRE_LOCK_DEFAULT != CGRE_LOCK_MUTEX
+    // The mutex was configured out
+    if (policy == CGRE_LOCK_MUTEX) {
+        policy = CGRE_LOCK_FUTEX;
+    }
+#endif /* if CGRE_LOCK_DEFAULT != CGRE_LOCK_MUTEX */
+    set->state = policy;
+#if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX
+    if (policy == CGRE_LOCK_MUTEX &&
+            pthread_mutex_init(&(set->lock.mutex), NULL) != 0) {
         CGRE_NODES_LOCK_SET_FAIL(set->state);
         return NULL;
     }
+#endif /* if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX */
+    if (policy != CGRE_LOCK_MUTEX) {
+        set->lock.word = 0;
+    }
     // We are going to be working on this tree
-    cgre_int_t fail = pthread_mutex_lock(&(set->lock));
+    cgre_int_t fail = cgre_node_set_lock(set);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(set->state);
         return NULL;
@@ -238,9 +691,11 @@ struct cgre_node_set* cgre_node_set_initialize(
     set->link[0] = NULL;
     set->link[1] = NULL;
     set->link[2] = NULL;
+    set->store = NULL;
+    set->finger = NULL;
     set->count = 0;
-    set->state = 0;
-    fail = pthread_mutex_unlock(&(set->lock));
+    set->sequence = 0;
+    fail = cgre_node_set_unlock(set);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(set->state);
         return NULL;
@@ -257,11 +712,27 @@ struct cgre_node_set* cgre_node_set_initialize(
  * @warning
  * This destroys the mutex on the object. There must be no current operations
  * executed on this tree, or tree is uninitialized but NULL returned.
+ *
+ * @remark
+ * Storage allocated by the collection modes is released, the member nodes
+ * are left to the caller.
  */
 struct cgre_node_set* cgre_node_set_uninitialize(
         struct cgre_node_set* set)
 {
-    cgre_int_t fail = pthread_mutex_destroy(&(set->lock));
+    cgre_int_t fail = 0;
+#if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX
+    if (CGRE_NODES_LOCK_POLICY(set->state) == CGRE_LOCK_MUTEX) {
+        fail = pthread_mutex_destroy(&(set->lock.mutex));
+    }
+#endif /* if CGRE_LOCK_DEFAULT == CGRE_LOCK_MUTEX */
+    for (struct cgre_node_store* block = set->store; block != NULL;) {
+        struct cgre_node_store* next = block->next;
+        free(block);
+        block = next;
+    }
+    set->store = NULL;
+    set->finger = NULL;
     set->link[0] = NULL;
     set->link[1] = NULL;
     set->link[2] = NULL;
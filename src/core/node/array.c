@@ -30,6 +30,148 @@ SOFTWARE.
 
 #include <cgre/core/set.h>
 
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @def CGRE_ARRAY_LINKED 1
+ * @brief Linked mode of the array
+ *
+ * Members are chained through `link[CGRE_NODE_HEAD]` and
+ * `link[CGRE_NODE_TAIL]`, indexed access walks from the closest of the head,
+ * middle, tail or the member reached by the last indexed access. That member
+ * is kept in `finger` with its index in `sequence`, so the mode owns no
+ * storage.
+ */
+
+/**
+ * @def CGRE_ARRAY_VECTOR 2
+ * @brief Contiguous mode of the array
+ *
+ * Members are held in a growable buffer of node pointers owned by the set.
+ * Get and set are O(1), add is amortized O(1) and delete moves the members
+ * after the index down by one. Member links are left untouched.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&array);
+ * CGRE_NODES_MODE_SET_VALUE(array.state, CGRE_ARRAY_VECTOR);
+ * @endcode
+ */
+
+/**
+ * @def CGRE_ARRAY_MODE_DEFAULT
+ * @brief Mode used by an array with no mode set
+ */
+
+/**
+ * @def CGRE_ARRAY_MODE(N)
+ * @brief Compute the effective mode of an array from its state
+ */
+
+/**
+ * @def CGRE_ARRAY_VECTOR_MIN_SIZE 16
+ * @brief Initial slot count of an array vector
+ */
+
+struct cgre_array_vector {
+    struct cgre_node_store store;
+    struct cgre_node* slot[];
+};
+
+/**
+ * @brief Make sure the array vector has room for one more member
+ *
+ * The buffer doubles when full.
+ *
+ * @return vector or NULL on allocation error
+ */
+static struct cgre_array_vector* cgre_array_vector_reserve(
+        struct cgre_node_set* array)
+{
+    struct cgre_array_vector* vector =
+        (struct cgre_array_vector*) array->store;
+    if (vector != NULL && vector->store.used < vector->store.size) {
+        return vector;
+    }
+    cgre_uint_t size = (vector == NULL) ?
+        CGRE_ARRAY_VECTOR_MIN_SIZE : vector->store.size << 1;
+    struct cgre_array_vector* grown = realloc(vector,
+            sizeof(struct cgre_array_vector) +
+            sizeof(struct cgre_node*) * size);
+    if (grown == NULL) {
+        return NULL;
+    }
+    if (vector == NULL) {
+        grown->store.next = NULL;
+        grown->store.used = 0;
+    }
+    grown->store.size = size;
+    array->store = (struct cgre_node_store*) grown;
+    return grown;
+}
+
+
+/**
+ * @brief Compute the index of the middle member of a linked array
+ */
+static cgre_uint_t cgre_array_fold(
+        cgre_uint_t count)
+{
+    return (count < 2) ? 0 : (count - 1) >> 1;
+}
+
+/**
+ * @brief Compute the number of links between two indexes
+ */
+static cgre_uint_t cgre_array_distance(
+        cgre_uint_t from,
+        cgre_uint_t to)
+{
+    return (from > to) ? from - to : to - from;
+}
+
+/**
+ * @brief Find a linked array member by index
+ *
+ * Walks from whichever of the head, middle, tail or finger is closest and
+ * leaves the finger on the member found.
+ *
+ * @param[in] array The Node Set to walk, locked and holding index
+ * @param[in] index The position to find
+ * @return node at index
+ */
+static struct cgre_node* cgre_array_walk(
+        struct cgre_node_set* array,
+        cgre_uint_t index)
+{
+    struct cgre_node* found = array->link[CGRE_NODE_HEAD];
+    cgre_uint_t at = 0;
+    cgre_uint_t middle = cgre_array_fold(array->count);
+    if (cgre_array_distance(middle, index) < cgre_array_distance(at, index)) {
+        found = array->link[CGRE_NODE_MIDDLE];
+        at = middle;
+    }
+    if ((array->count - 1) - index < cgre_array_distance(at, index)) {
+        found = array->link[CGRE_NODE_TAIL];
+        at = array->count - 1;
+    }
+    if (array->finger != NULL &&
+            cgre_array_distance(array->sequence, index) <
+            cgre_array_distance(at, index)) {
+        found = array->finger;
+        at = array->sequence;
+    }
+    for (; at < index; at++) {
+        found = found->link[CGRE_NODE_TAIL];
+    }
+    for (; at > index; at--) {
+        found = found->link[CGRE_NODE_HEAD];
+    }
+    array->finger = found;
+    array->sequence = index;
+    return found;
+}
+
 /**
  * @brief Add a node to the array
  *
@@ -45,29 +187,28 @@ struct cgre_node* cgre_array_add(
         struct cgre_node_set* array,
         struct cgre_node* node)
 {
-    // Could be dealing with a 0 member list, so start at NULL
-    struct cgre_node* parent = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(array->lock));
+    struct cgre_node* added = node;
+    cgre_int_t fail = cgre_node_set_lock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
         return NULL;
     }
-    if (array->count >= 2) {
-        // Start in the middle
-        parent = array->link[CGRE_NODE_MIDDLE];
-        for (cgre_uint_t steps = (array->count - (array->count >> 1));
-                steps > 0 && parent->link[CGRE_NODE_TAIL] != NULL;
-                steps--){
-            // From the middle, work to the end of the array
-            parent = parent->link[CGRE_NODE_TAIL];
+    if (CGRE_ARRAY_MODE(array->state) == CGRE_ARRAY_VECTOR) {
+        struct cgre_array_vector* vector = cgre_array_vector_reserve(array);
+        if (vector != NULL) {
+            vector->slot[vector->store.used++] = node;
+            array->count++;
+        } else {
+            added = NULL;
         }
-    } else {
-        // Are we a single item list?
-        if (array->count == 1) {
-            // Start at element 1
-            parent = array->link[CGRE_NODE_HEAD];
+        fail = cgre_node_set_unlock(array);
+        if (fail) {
+            CGRE_NODES_LOCK_SET_FAIL(array->state);
         }
+        return added;
     }
+    // The tail is where we attach, NULL on a 0 member list
+    struct cgre_node* parent = array->link[CGRE_NODE_TAIL];
     // Are we special case 0 elements?
     if (array->count == 0){
         // We are the start and the middle
@@ -82,16 +223,122 @@ struct cgre_node* cgre_array_add(
     }
     array->count++;
     // Will we get a new middle?
-    if (array->count > 1 && (array->count & 1)) {
+    if (cgre_array_fold(array->count) != cgre_array_fold(array->count - 1)) {
         // Next is the new middle
         array->link[CGRE_NODE_MIDDLE] =
             array->link[CGRE_NODE_MIDDLE]->link[CGRE_NODE_TAIL];
     }
-    fail = pthread_mutex_unlock(&(array->lock));
+    fail = cgre_node_set_unlock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
     }
-    return node;
+    return added;
+}
+
+/**
+ * @brief Start a cursor on the first array member
+ *
+ * @param[out] cursor The cursor to start
+ * @param[in] array The Node Set to walk
+ * @return first member or NULL on an empty array or error
+ *
+ * @code{.c}
+ * struct cgre_array_cursor cursor;
+ * for (struct cgre_node* node = cgre_array_cursor_begin(&cursor, &array);
+ *         node != NULL;
+ *         node = cgre_array_cursor_next(&cursor)) {
+ *     ...
+ * }
+ * @endcode
+ */
+struct cgre_node* cgre_array_cursor_begin(
+        struct cgre_array_cursor* cursor,
+        struct cgre_node_set* array)
+{
+    cursor->array = array;
+    cursor->node = NULL;
+    cursor->index = CGRE_ARRAY_CURSOR_BEFORE;
+    return cgre_array_cursor_next(cursor);
+}
+
+/**
+ * @brief Move a cursor to the next array member
+ *
+ * From before the head this is the head. Past the tail the cursor stays put.
+ *
+ * @param[in] cursor The cursor to move
+ * @return next member or NULL past the tail or on error
+ */
+struct cgre_node* cgre_array_cursor_next(
+        struct cgre_array_cursor* cursor)
+{
+    struct cgre_node_set* array = cursor->array;
+    cgre_int_t fail = cgre_node_set_lock(array);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(array->state);
+        return NULL;
+    }
+    if (CGRE_ARRAY_MODE(array->state) == CGRE_ARRAY_VECTOR) {
+        if (cursor->index == CGRE_ARRAY_CURSOR_BEFORE ||
+                cursor->index < array->count) {
+            cursor->index++;
+        } else {
+            cursor->index = array->count;
+        }
+        cursor->node = (cursor->index < array->count) ?
+            ((struct cgre_array_vector*) array->store)->slot[cursor->index] :
+            NULL;
+    } else if (cursor->node != NULL) {
+        cursor->node = cursor->node->link[CGRE_NODE_TAIL];
+        cursor->index++;
+    } else if (cursor->index == CGRE_ARRAY_CURSOR_BEFORE) {
+        cursor->node = array->link[CGRE_NODE_HEAD];
+        cursor->index = 0;
+    }
+    fail = cgre_node_set_unlock(array);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(array->state);
+    }
+    return cursor->node;
+}
+
+/**
+ * @brief Move a cursor to the previous array member
+ *
+ * From past the tail this is the tail. Before the head the cursor stays put.
+ *
+ * @param[in] cursor The cursor to move
+ * @return previous member or NULL before the head or on error
+ */
+struct cgre_node* cgre_array_cursor_prev(
+        struct cgre_array_cursor* cursor)
+{
+    struct cgre_node_set* array = cursor->array;
+    cgre_int_t fail = cgre_node_set_lock(array);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(array->state);
+        return NULL;
+    }
+    if (CGRE_ARRAY_MODE(array->state) == CGRE_ARRAY_VECTOR) {
+        if (cursor->index != CGRE_ARRAY_CURSOR_BEFORE) {
+            cursor->index = ((cursor->index > array->count) ?
+                array->count : cursor->index) - 1;
+        }
+        cursor->node = (cursor->index < array->count) ?
+            ((struct cgre_array_vector*) array->store)->slot[cursor->index] :
+            NULL;
+    } else if (cursor->node != NULL) {
+        cursor->node = cursor->node->link[CGRE_NODE_HEAD];
+        cursor->index--;
+    } else if (cursor->index != CGRE_ARRAY_CURSOR_BEFORE) {
+        cursor->node = array->link[CGRE_NODE_TAIL];
+        cursor->index = array->count - 1;
+    }
+    fail = cgre_node_set_unlock(array);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(array->state);
+    }
+    return cursor->node;
 }
 
 /**
@@ -106,66 +353,60 @@ struct cgre_node* cgre_array_delete(
         cgre_uint_t index)
 {
     struct cgre_node* removed = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(array->lock));
+    cgre_int_t fail = cgre_node_set_lock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
         return NULL;
     }
-    if ((index + 1) <= array->count) {
-        // Compute the fold
-        cgre_uint_t middle = ((array->count >> 1) - 1);
-        // Are we above the fold?
-        if (index >= middle){
-            removed = array->link[CGRE_NODE_MIDDLE];
-            if (index != middle) {
-                for (cgre_uint_t steps = (index - middle);
-                        steps > 0 && removed->link[CGRE_NODE_TAIL] != NULL;
-                        steps-- ) {
-                    removed = removed->link[CGRE_NODE_TAIL];
-                }
+    if (CGRE_ARRAY_MODE(array->state) == CGRE_ARRAY_VECTOR) {
+        struct cgre_array_vector* vector =
+            (struct cgre_array_vector*) array->store;
+        if (index < array->count) {
+            removed = vector->slot[index];
+            // Close the gap
+            memmove(&(vector->slot[index]), &(vector->slot[index + 1]),
+                    sizeof(struct cgre_node*) * (array->count - index - 1));
+            vector->store.used--;
+            array->count--;
+        }
+    } else if (index < array->count) {
+        removed = cgre_array_walk(array, index);
+        struct cgre_node* previous = removed->link[CGRE_NODE_HEAD];
+        struct cgre_node* next = removed->link[CGRE_NODE_TAIL];
+        // Find the new middle before the links change
+        cgre_uint_t middle = cgre_array_fold(array->count);
+        cgre_uint_t fold = cgre_array_fold(array->count - 1);
+        struct cgre_node* centre = array->link[CGRE_NODE_MIDDLE];
+        if (index > middle) {
+            if (fold != middle) {
+                centre = centre->link[CGRE_NODE_HEAD];
             }
-            // Are we at the end?
-            if (index == (array->count - 1)) {
-                removed->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] = NULL;
-            } else {
-                // link previous to next node
-                removed->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] =
-                    removed->link[CGRE_NODE_TAIL];
-                // link next node to previous
-                removed->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] =
-                    removed->link[CGRE_NODE_HEAD];
+        } else if (index < middle) {
+            if (fold == middle) {
+                centre = centre->link[CGRE_NODE_TAIL];
             }
-        // Nope, below the fold.
         } else {
-            removed = array->link[CGRE_NODE_HEAD];
-            if (index != 0) {
-                for (cgre_uint_t steps = 0;
-                        steps < index;
-                        steps++){
-                    removed = removed->link[CGRE_NODE_TAIL];
-                }
-            }
-            // Are we at the beginning?
-            if (index == 0) {
-                removed->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] = NULL;
-            } else {
-                // link previous to next node
-                removed->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] =
-                    removed->link[CGRE_NODE_TAIL];
-                // link next node to previous
-                removed->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] =
-                    removed->link[CGRE_NODE_HEAD];
-            }
+            centre = (fold == middle) ?
+                centre->link[CGRE_NODE_TAIL] : centre->link[CGRE_NODE_HEAD];
         }
-        array->count--;
-        // Will we get a new middle?
-        if (array->count > 0 && (array->count & 1)) {
-            // Yes, set new middle
-            array->link[CGRE_NODE_MIDDLE] =
-                array->link[CGRE_NODE_MIDDLE]->link[CGRE_NODE_HEAD];
+        // link previous to next node
+        if (previous != NULL) {
+            previous->link[CGRE_NODE_TAIL] = next;
+        } else {
+            array->link[CGRE_NODE_HEAD] = next;
         }
+        // link next node to previous
+        if (next != NULL) {
+            next->link[CGRE_NODE_HEAD] = previous;
+        } else {
+            array->link[CGRE_NODE_TAIL] = previous;
+        }
+        array->link[CGRE_NODE_MIDDLE] = centre;
+        array->count--;
+        // The next member takes over the index
+        array->finger = next;
     }
-    fail = pthread_mutex_unlock(&(array->lock));
+    fail = cgre_node_set_unlock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
     }
@@ -184,38 +425,20 @@ struct cgre_node* cgre_array_get(
         cgre_uint_t index)
 {
     struct cgre_node* found = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(array->lock));
+    cgre_int_t fail = cgre_node_set_lock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
         return NULL;
     }
     // Are we within bounds?
-    if ((index + 1) <= array->count) {
-        // Compute the fold
-        cgre_uint_t middle = ((array->count >> 1) - 1);
-        // Are we above the fold?
-        if (index >= middle){
-            found = array->link[CGRE_NODE_MIDDLE];
-            if (index != middle) {
-                for (cgre_uint_t steps = (index - middle);
-                        steps > 0 && found->link[CGRE_NODE_TAIL] != NULL;
-                        steps-- ) {
-                    found = found->link[CGRE_NODE_TAIL];
-                }
-            }
-        // Nope, below the fold.
-        } else {
-            found = array->link[CGRE_NODE_HEAD];
-            if (index != 0) {
-                for (cgre_uint_t steps = 0;
-                        steps < index;
-                        steps++){
-                    found = found->link[CGRE_NODE_TAIL];
-                }
-            }
-        }
+    if (index >= array->count) {
+        found = NULL;
+    } else if (CGRE_ARRAY_MODE(array->state) == CGRE_ARRAY_VECTOR) {
+        found = ((struct cgre_array_vector*) array->store)->slot[index];
+    } else {
+        found = cgre_array_walk(array, index);
     }
-    fail = pthread_mutex_unlock(&(array->lock));
+    fail = cgre_node_set_unlock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
     }
@@ -250,61 +473,45 @@ struct cgre_node* cgre_array_set(
         cgre_uint_t index)
 {
     struct cgre_node* replaced = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(array->lock));
+    cgre_int_t fail = cgre_node_set_lock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
         return NULL;
     }
     // Are we within bounds?
-    if ((index + 1) <= array->count) {
-        // Compute the fold
-        cgre_uint_t middle = ((array->count >> 1) - 1);
-        // Are we above the fold?
-        if (index >= middle){
-            replaced = array->link[CGRE_NODE_MIDDLE];
-            if (index != middle) {
-                for (cgre_uint_t steps = (index - middle);
-                        steps > 0 && replaced->link[CGRE_NODE_TAIL] != NULL;
-                        steps-- ) {
-                    replaced = replaced->link[CGRE_NODE_TAIL];
-                }
-            }
-        // Nope, below the fold.
-        } else {
-            replaced = array->link[CGRE_NODE_HEAD];
-            if (index != 0) {
-                for (cgre_uint_t steps = 0;
-                        steps < index;
-                        steps++){
-                    replaced = replaced->link[CGRE_NODE_TAIL];
-                }
-            }
-        }
+    if (index >= array->count) {
+        replaced = NULL;
+    } else if (CGRE_ARRAY_MODE(array->state) == CGRE_ARRAY_VECTOR) {
+        struct cgre_array_vector* vector =
+            (struct cgre_array_vector*) array->store;
+        replaced = vector->slot[index];
+        vector->slot[index] = node;
+    } else {
+        replaced = cgre_array_walk(array, index);
         // Copy the current head and tail
         node->link[CGRE_NODE_HEAD] = replaced->link[CGRE_NODE_HEAD];
         node->link[CGRE_NODE_TAIL] = replaced->link[CGRE_NODE_TAIL];
-        if (index > 0) {
-            // Update the heads and tails
-            replaced->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] = node;
-            if (index < (array->count - 1)) {
-                replaced->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] = node;
-            }
+        // Update the heads and tails
+        if (node->link[CGRE_NODE_HEAD] != NULL) {
+            node->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] = node;
         } else {
             // We are the new head
             array->link[CGRE_NODE_HEAD] = node;
         }
+        if (node->link[CGRE_NODE_TAIL] != NULL) {
+            node->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] = node;
+        } else {
+            // We are the new tail
+            array->link[CGRE_NODE_TAIL] = node;
+        }
         // Were we the middle?
         if (array->link[CGRE_NODE_MIDDLE] == replaced){
             // Update the middle
             array->link[CGRE_NODE_MIDDLE] = node;
         }
-        // Were we the tail?
-        if (array->link[CGRE_NODE_TAIL] == replaced){
-            // Update the tail
-            array->link[CGRE_NODE_TAIL] = node;
-        }
+        array->finger = node;
     }
-    fail = pthread_mutex_unlock(&(array->lock));
+    fail = cgre_node_set_unlock(array);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(array->state);
     }
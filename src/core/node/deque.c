@@ -0,0 +1,295 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/core/set.h>
+
+#include <stdlib.h>
+
+/**
+ * @brief Slots of a work-stealing deque
+ *
+ * Rings are only ever replaced by a larger copy, the old ones stay chained
+ * behind the deque until the set is uninitialized since a thief may still be
+ * reading from them.
+ */
+struct cgre_deque_ring {
+    struct cgre_node_store store;
+    struct cgre_node* slot[];
+};
+
+/**
+ * @brief Work-stealing deque held in the set store
+ *
+ * Thieves take from `top`, the owner pushes and pops at `bottom`. Each end
+ * sits on its own cache line.
+ */
+struct cgre_deque {
+    struct cgre_node_store store;
+    char pad0[CGRE_CACHE_LINE];
+    cgre_intptr_t top;
+    char pad1[CGRE_CACHE_LINE - sizeof(cgre_intptr_t)];
+    cgre_intptr_t bottom;
+    struct cgre_deque_ring* ring;
+    char pad2[CGRE_CACHE_LINE - sizeof(cgre_intptr_t) -
+        sizeof(struct cgre_deque_ring*)];
+};
+
+/**
+ * @brief Allocate a deque ring
+ *
+ * @return ring or NULL on allocation error
+ */
+static struct cgre_deque_ring* cgre_deque_ring_create(
+        cgre_uint_t size)
+{
+    struct cgre_deque_ring* ring = malloc(sizeof(struct cgre_deque_ring) +
+            sizeof(struct cgre_node*) * size);
+    if (ring != NULL) {
+        ring->store.next = NULL;
+        ring->store.size = size;
+        ring->store.used = 0;
+    }
+    return ring;
+}
+
+/**
+ * @brief Replace the deque ring with one twice the size
+ *
+ * Only called by the owner. Members from top to bottom are copied across
+ * before the new ring is published.
+ *
+ * @return new ring or NULL on allocation error
+ */
+static struct cgre_deque_ring* cgre_deque_grow(
+        struct cgre_deque* deque,
+        struct cgre_deque_ring* ring,
+        cgre_intptr_t top,
+        cgre_intptr_t bottom)
+{
+    cgre_uintptr_t mask = ring->store.size - 1;
+    struct cgre_deque_ring* grown = cgre_deque_ring_create(
+            ring->store.size << 1);
+    if (grown == NULL) {
+        return NULL;
+    }
+    for (cgre_intptr_t idx = top; idx < bottom; idx++) {
+        grown->slot[idx & (grown->store.size - 1)] = __atomic_load_n(
+                &(ring->slot[idx & mask]), __ATOMIC_RELAXED);
+    }
+    // Keep the old ring alive for thieves still reading it
+    grown->store.next = deque->store.next;
+    deque->store.next = (struct cgre_node_store*) grown;
+    __atomic_store_n(&(deque->ring), grown, __ATOMIC_RELEASE);
+    return grown;
+}
+
+/**
+ * @brief Pop the most recently pushed member off the deque
+ *
+ * Only the owner thread may pop. No lock is taken, a CAS is only needed
+ * when racing a thief for the last member.
+ *
+ * @param[in] deque The Node Set to pop from
+ * @return node or NULL on empty
+ */
+struct cgre_node* cgre_deque_pop(
+        struct cgre_node_set* deque)
+{
+    struct cgre_deque* ends = (struct cgre_deque*) deque->store;
+    if (ends == NULL) {
+        return NULL;
+    }
+    cgre_intptr_t bottom = __atomic_load_n(&(ends->bottom),
+            __ATOMIC_RELAXED) - 1;
+    struct cgre_deque_ring* ring = __atomic_load_n(&(ends->ring),
+            __ATOMIC_RELAXED);
+    // Claim the bottom before looking at what the thieves took
+    __atomic_store_n(&(ends->bottom), bottom, __ATOMIC_SEQ_CST);
+    cgre_intptr_t top = __atomic_load_n(&(ends->top), __ATOMIC_SEQ_CST);
+    struct cgre_node* popped = NULL;
+    if (top <= bottom) {
+        popped = __atomic_load_n(
+                &(ring->slot[bottom & (ring->store.size - 1)]),
+                __ATOMIC_RELAXED);
+        // Is it the last member?
+        if (top == bottom) {
+            // Yes. Race the thieves for it
+            if (!__atomic_compare_exchange_n(&(ends->top), &top, top + 1,
+                        0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                popped = NULL;
+            }
+            __atomic_store_n(&(ends->bottom), bottom + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        // Empty, put the bottom back
+        __atomic_store_n(&(ends->bottom), bottom + 1, __ATOMIC_RELAXED);
+    }
+    return popped;
+}
+
+/**
+ * @brief Push a member onto the deque
+ *
+ * Only the owner thread may push. No lock is taken, the ring doubles when
+ * full.
+ *
+ * @param[in] deque The Node Set to push to
+ * @param[in] node The Node to push
+ * @return node or NULL on allocation error or an unreserved deque
+ */
+struct cgre_node* cgre_deque_push(
+        struct cgre_node_set* deque,
+        struct cgre_node* node)
+{
+    struct cgre_deque* ends = (struct cgre_deque*) deque->store;
+    if (ends == NULL) {
+        return NULL;
+    }
+    cgre_intptr_t bottom = __atomic_load_n(&(ends->bottom),
+            __ATOMIC_RELAXED);
+    cgre_intptr_t top = __atomic_load_n(&(ends->top), __ATOMIC_ACQUIRE);
+    struct cgre_deque_ring* ring = __atomic_load_n(&(ends->ring),
+            __ATOMIC_RELAXED);
+    // Is the ring full?
+    if (bottom - top > (cgre_intptr_t) ring->store.size - 1) {
+        ring = cgre_deque_grow(ends, ring, top, bottom);
+        if (ring == NULL) {
+            return NULL;
+        }
+    }
+    __atomic_store_n(&(ring->slot[bottom & (ring->store.size - 1)]), node,
+            __ATOMIC_RELAXED);
+    // Publish the member to thieves
+    __atomic_store_n(&(ends->bottom), bottom + 1, __ATOMIC_RELEASE);
+    return node;
+}
+
+/**
+ * @brief Make a set ready to be used as a work-stealing deque
+ *
+ * @param[in] deque The empty Node Set to prepare
+ * @param[in] size Initial capacity, rounded up to a power of 2
+ * @return deque or NULL on error or a set already in use
+ *
+ * @remark
+ * The thread that pushes to the deque owns it and is the only one allowed to
+ * pop, any thread may steal. `cgre_node_set.count` is not maintained and
+ * member links are left untouched.
+ *
+ * @warning
+ * The deque must not be shared with other threads until this returns. Rings
+ * outgrown by the deque are kept until `cgre_node_set_uninitialize()`, since
+ * a thief may still be reading one.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&jobs);
+ * cgre_deque_reserve(&jobs, 256);
+ * // owner
+ * cgre_deque_push(&jobs, job);
+ * job = cgre_deque_pop(&jobs);
+ * // any other thread
+ * job = cgre_deque_steal(&jobs);
+ * @endcode
+ */
+struct cgre_node_set* cgre_deque_reserve(
+        struct cgre_node_set* deque,
+        cgre_uint_t size)
+{
+    struct cgre_node_set* reserved = NULL;
+    cgre_int_t fail = cgre_node_set_lock(deque);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(deque->state);
+        return NULL;
+    }
+    // Only an empty set can be prepared
+    if (deque->count == 0 && deque->store == NULL && size > 0) {
+        cgre_uint_t capacity = 2;
+        while (capacity < size) {
+            capacity <<= 1;
+        }
+        struct cgre_deque* ends = NULL;
+        struct cgre_deque_ring* ring = cgre_deque_ring_create(capacity);
+        if (ring != NULL && posix_memalign((void**) &ends, CGRE_CACHE_LINE,
+                    sizeof(struct cgre_deque)) == 0) {
+            ends->store.next = (struct cgre_node_store*) ring;
+            ends->store.size = 0;
+            ends->store.used = 0;
+            ends->top = 0;
+            ends->bottom = 0;
+            ends->ring = ring;
+            deque->store = (struct cgre_node_store*) ends;
+            reserved = deque;
+        } else {
+            free(ring);
+        }
+    }
+    fail = cgre_node_set_unlock(deque);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(deque->state);
+        return NULL;
+    }
+    return reserved;
+}
+
+/**
+ * @brief Steal the oldest member from the deque
+ *
+ * Any thread may steal. Retries while the deque holds members and another
+ * thread won the race for the one in reach.
+ *
+ * @param[in] deque The Node Set to steal from
+ * @return node or NULL on empty
+ */
+struct cgre_node* cgre_deque_steal(
+        struct cgre_node_set* deque)
+{
+    struct cgre_deque* ends = (struct cgre_deque*) deque->store;
+    if (ends == NULL) {
+        return NULL;
+    }
+    for (;;) {
+        cgre_intptr_t top = __atomic_load_n(&(ends->top), __ATOMIC_SEQ_CST);
+        cgre_intptr_t bottom = __atomic_load_n(&(ends->bottom),
+                __ATOMIC_SEQ_CST);
+        if (top >= bottom) {
+            return NULL;
+        }
+        struct cgre_deque_ring* ring = __atomic_load_n(&(ends->ring),
+                __ATOMIC_ACQUIRE);
+        struct cgre_node* stolen = __atomic_load_n(
+                &(ring->slot[top & (ring->store.size - 1)]),
+                __ATOMIC_RELAXED);
+        // Did we win the member?
+        if (__atomic_compare_exchange_n(&(ends->top), &top, top + 1, 0,
+                    __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            return stolen;
+        }
+    }
+}
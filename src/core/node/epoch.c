@@ -0,0 +1,431 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/core/common.h>
+
+#include <stdlib.h>
+
+/**
+ * @def CGRE_EPOCH_BAG 64
+ * @brief Retired nodes held by each limbo block
+ */
+
+/**
+ * @def CGRE_EPOCH_THRESHOLD 128
+ * @brief Nodes a thread retires between attempts to advance the epoch
+ */
+
+/**
+ * @def CGRE_EPOCH_CACHES 4
+ * @brief Domains each thread remembers its record for
+ *
+ * A thread working with more domains than this finds its record again by
+ * walking the records of the domain.
+ */
+
+/**
+ * @brief Limbo block of retired nodes
+ */
+struct cgre_epoch_bag {
+    struct cgre_epoch_bag* next;
+    cgre_uint_t count;
+    struct cgre_node* node[CGRE_EPOCH_BAG];
+};
+
+/**
+ * @brief Epoch record of one thread in one domain
+ *
+ * `active` is 0 outside a critical section, otherwise the announced epoch
+ * shifted left once with the low bit set. It is the only field read by other
+ * threads and sits alone on its cache line. The nodes retired during epoch
+ * `e` wait in `limbo[e % 3]`.
+ */
+struct cgre_epoch_record {
+    cgre_uint_t active;
+    char pad[CGRE_CACHE_LINE - sizeof(cgre_uint_t)];
+    struct cgre_epoch_record* next;
+    pthread_t owner;
+    cgre_uint_t epoch;
+    cgre_uint_t nesting;
+    cgre_uint_t retired;
+    struct cgre_epoch_bag* limbo[3];
+    struct cgre_epoch_bag* spare;
+} __attribute__((aligned(CGRE_CACHE_LINE)));
+
+struct cgre_epoch_cache {
+    struct cgre_epoch* epoch;
+    cgre_uint_t sequence;
+    struct cgre_epoch_record* record;
+};
+
+static __thread struct cgre_epoch_cache cgre_epoch_caches[CGRE_EPOCH_CACHES];
+
+static cgre_uint_t cgre_epoch_sequence = 0;
+
+/**
+ * @brief Find the record of this thread in a domain, adding one if needed
+ *
+ * @return record or NULL on allocation error
+ */
+static struct cgre_epoch_record* cgre_epoch_record(
+        struct cgre_epoch* epoch)
+{
+    struct cgre_epoch_cache* spare = NULL;
+    for (cgre_uint_t idx = 0; idx < CGRE_EPOCH_CACHES; idx++) {
+        struct cgre_epoch_cache* cache = &(cgre_epoch_caches[idx]);
+        if (cache->epoch == epoch && cache->sequence == epoch->sequence) {
+            return cache->record;
+        }
+        if (spare == NULL && cache->epoch == NULL) {
+            spare = cache;
+        }
+    }
+    if (spare == NULL) {
+        spare = &(cgre_epoch_caches[epoch->sequence % CGRE_EPOCH_CACHES]);
+    }
+    pthread_t self = pthread_self();
+    struct cgre_epoch_record* record = __atomic_load_n(&(epoch->records),
+            __ATOMIC_ACQUIRE);
+    for (; record != NULL; record = record->next) {
+        if (pthread_equal(record->owner, self)) {
+            break;
+        }
+    }
+    if (record == NULL) {
+        if (posix_memalign((void**) &record, CGRE_CACHE_LINE,
+                    sizeof(struct cgre_epoch_record))) {
+            return NULL;
+        }
+        record->active = 0;
+        record->owner = self;
+        record->epoch = __atomic_load_n(&(epoch->epoch), __ATOMIC_RELAXED);
+        record->nesting = 0;
+        record->retired = 0;
+        record->limbo[0] = NULL;
+        record->limbo[1] = NULL;
+        record->limbo[2] = NULL;
+        record->spare = NULL;
+        // Records are only ever added, and only freed with the domain
+        record->next = __atomic_load_n(&(epoch->records), __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&(epoch->records),
+                    &(record->next), record, 1, __ATOMIC_RELEASE,
+                    __ATOMIC_RELAXED)) {
+        }
+    }
+    spare->epoch = epoch;
+    spare->sequence = epoch->sequence;
+    spare->record = record;
+    return record;
+}
+
+/**
+ * @brief Release every node of a limbo list, keeping its blocks as spares
+ *
+ * @return number of nodes released
+ */
+static cgre_uint_t cgre_epoch_release(
+        struct cgre_epoch* epoch,
+        struct cgre_epoch_record* record,
+        cgre_uint_t list)
+{
+    cgre_uint_t released = 0;
+    for (struct cgre_epoch_bag* bag = record->limbo[list]; bag != NULL;) {
+        struct cgre_epoch_bag* next = bag->next;
+        for (cgre_uint_t idx = 0; idx < bag->count; idx++) {
+            if (epoch->release != NULL) {
+                epoch->release(epoch->context, bag->node[idx]);
+            } else {
+                free(bag->node[idx]);
+            }
+        }
+        released += bag->count;
+        bag->next = record->spare;
+        record->spare = bag;
+        bag = next;
+    }
+    record->limbo[list] = NULL;
+    return released;
+}
+
+/**
+ * @brief Catch a record up with the global epoch
+ *
+ * Nodes retired two epochs before the global one can no longer be reached
+ * by any reader and are released.
+ *
+ * @return number of nodes released
+ */
+static cgre_uint_t cgre_epoch_sync(
+        struct cgre_epoch* epoch,
+        struct cgre_epoch_record* record,
+        cgre_uint_t global)
+{
+    cgre_uint_t released = 0;
+    if (record->epoch == global) {
+        return 0;
+    }
+    for (cgre_uint_t list = 0; list < 3; list++) {
+        // Nodes from the epoch just before are still in reach
+        if (global - record->epoch == 1 && list == record->epoch % 3) {
+            continue;
+        }
+        released += cgre_epoch_release(epoch, record, list);
+    }
+    record->epoch = global;
+    return released;
+}
+
+/**
+ * @brief Move the global epoch on if every reader has seen it
+ *
+ * @return the global epoch afterwards
+ */
+static cgre_uint_t cgre_epoch_advance(
+        struct cgre_epoch* epoch)
+{
+    cgre_uint_t global = __atomic_load_n(&(epoch->epoch), __ATOMIC_SEQ_CST);
+    struct cgre_epoch_record* record = __atomic_load_n(&(epoch->records),
+            __ATOMIC_ACQUIRE);
+    for (; record != NULL; record = record->next) {
+        cgre_uint_t active = __atomic_load_n(&(record->active),
+                __ATOMIC_SEQ_CST);
+        // Is a reader still in an older epoch?
+        if ((active & 1) && (active >> 1) != global) {
+            return global;
+        }
+    }
+    if (__atomic_compare_exchange_n(&(epoch->epoch), &global, global + 1, 0,
+                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+        global++;
+    }
+    return global;
+}
+
+/**
+ * @brief Release what this thread retired as soon as it is safe
+ *
+ * Tries to move the epoch on far enough for every node this thread retired
+ * before the call to be released. Nodes still in reach of a reader that has
+ * not left its critical section are kept.
+ *
+ * @param[in] epoch The domain
+ * @return number of nodes released
+ *
+ * @remark
+ * Must not be called from inside a critical section, the caller would be
+ * holding the epoch back itself.
+ */
+cgre_uint_t cgre_epoch_collect(
+        struct cgre_epoch* epoch)
+{
+    struct cgre_epoch_record* record = cgre_epoch_record(epoch);
+    if (record == NULL) {
+        return 0;
+    }
+    cgre_uint_t global = __atomic_load_n(&(epoch->epoch), __ATOMIC_SEQ_CST);
+    cgre_uint_t released = cgre_epoch_sync(epoch, record, global);
+    for (cgre_uint_t round = 0; round < 2; round++) {
+        global = cgre_epoch_advance(epoch);
+        released += cgre_epoch_sync(epoch, record, global);
+    }
+    record->retired = 0;
+    return released;
+}
+
+/**
+ * @brief Enter a read-side critical section
+ *
+ * Nodes reached until the matching `cgre_epoch_leave()` stay valid, even if
+ * another thread removes and retires them meanwhile. Critical sections nest.
+ *
+ * @param[in] epoch The domain
+ * @return epoch or NULL on allocation error
+ *
+ * @code{.c}
+ * cgre_epoch_enter(&epoch);
+ * struct cgre_node* found = cgre_tree_search(&tree, key);
+ * ...
+ * cgre_epoch_leave(&epoch);
+ * @endcode
+ */
+struct cgre_epoch* cgre_epoch_enter(
+        struct cgre_epoch* epoch)
+{
+    struct cgre_epoch_record* record = cgre_epoch_record(epoch);
+    if (record == NULL) {
+        return NULL;
+    }
+    if (record->nesting++ == 0) {
+        cgre_uint_t global = __atomic_load_n(&(epoch->epoch),
+                __ATOMIC_RELAXED);
+        // Announce before reading any shared node
+        __atomic_store_n(&(record->active), (global << 1) | 1,
+                __ATOMIC_SEQ_CST);
+        cgre_epoch_sync(epoch, record, global);
+    }
+    return epoch;
+}
+
+/**
+ * @brief Initialize an epoch domain
+ *
+ * @param[in] epoch The domain to initialize
+ * @param[in] release Called on each node once it is safe, or NULL to use
+ * `free()`
+ * @param[in] context Handed to `release`
+ * @return epoch or NULL on error
+ *
+ * @code{.c}
+ * static void release_node(void* pool, struct cgre_node* node)
+ * {
+ *     cgre_node_pool_free((struct cgre_node_pool*) pool, node);
+ * }
+ * ...
+ * cgre_epoch_initialize(&epoch, release_node, &pool);
+ * @endcode
+ */
+struct cgre_epoch* cgre_epoch_initialize(
+        struct cgre_epoch* epoch,
+        void (*release)(void* context, struct cgre_node* node),
+        void* context)
+{
+    epoch->epoch = 0;
+    epoch->records = NULL;
+    epoch->release = release;
+    epoch->context = context;
+    epoch->state = 0;
+    // Sequence 0 is never used, it marks an uninitialized domain
+    do {
+        epoch->sequence = __atomic_add_fetch(&cgre_epoch_sequence, 1,
+                __ATOMIC_RELAXED);
+    } while (epoch->sequence == 0);
+    return epoch;
+}
+
+/**
+ * @brief Leave a read-side critical section
+ *
+ * @param[in] epoch The domain
+ */
+void cgre_epoch_leave(
+        struct cgre_epoch* epoch)
+{
+    struct cgre_epoch_record* record = cgre_epoch_record(epoch);
+    if (record != NULL && record->nesting > 0 && --(record->nesting) == 0) {
+        __atomic_store_n(&(record->active), 0, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Hand over a removed node to be released once no reader can see it
+ *
+ * The node waits in a limbo list of the calling thread. Every
+ * `CGRE_EPOCH_THRESHOLD` retires the thread tries to move the epoch on and
+ * releases what became safe.
+ *
+ * @param[in] epoch The domain
+ * @param[in] node Node already removed from every shared collection
+ * @return node or NULL on allocation error, the node is then not retired
+ *
+ * @code{.c}
+ * struct cgre_node* removed = cgre_tree_delete(&tree, key);
+ * if (removed != NULL) {
+ *     cgre_epoch_retire(&epoch, removed);
+ * }
+ * @endcode
+ */
+struct cgre_node* cgre_epoch_retire(
+        struct cgre_epoch* epoch,
+        struct cgre_node* node)
+{
+    struct cgre_epoch_record* record = cgre_epoch_record(epoch);
+    if (record == NULL) {
+        return NULL;
+    }
+    cgre_uint_t global = __atomic_load_n(&(epoch->epoch), __ATOMIC_SEQ_CST);
+    cgre_epoch_sync(epoch, record, global);
+    cgre_uint_t list = global % 3;
+    struct cgre_epoch_bag* bag = record->limbo[list];
+    if (bag == NULL || bag->count == CGRE_EPOCH_BAG) {
+        struct cgre_epoch_bag* fresh = record->spare;
+        if (fresh != NULL) {
+            record->spare = fresh->next;
+        } else if ((fresh = malloc(sizeof(struct cgre_epoch_bag))) == NULL) {
+            return NULL;
+        }
+        fresh->next = bag;
+        fresh->count = 0;
+        record->limbo[list] = fresh;
+        bag = fresh;
+    }
+    bag->node[bag->count++] = node;
+    if (++(record->retired) >= CGRE_EPOCH_THRESHOLD) {
+        record->retired = 0;
+        cgre_epoch_sync(epoch, record, cgre_epoch_advance(epoch));
+    }
+    return node;
+}
+
+/**
+ * @brief Uninitialize an epoch domain
+ *
+ * Every node still waiting in a limbo list is released.
+ *
+ * @param[in] epoch The domain to uninitialize
+ * @return epoch
+ *
+ * @warning
+ * No thread may be inside a critical section or use the domain anymore.
+ */
+struct cgre_epoch* cgre_epoch_uninitialize(
+        struct cgre_epoch* epoch)
+{
+    for (struct cgre_epoch_record* record = epoch->records; record != NULL;) {
+        struct cgre_epoch_record* next = record->next;
+        for (cgre_uint_t list = 0; list < 3; list++) {
+            cgre_epoch_release(epoch, record, list);
+        }
+        for (struct cgre_epoch_bag* bag = record->spare; bag != NULL;) {
+            struct cgre_epoch_bag* after = bag->next;
+            free(bag);
+            bag = after;
+        }
+        free(record);
+        record = next;
+    }
+    for (cgre_uint_t idx = 0; idx < CGRE_EPOCH_CACHES; idx++) {
+        if (cgre_epoch_caches[idx].epoch == epoch) {
+            cgre_epoch_caches[idx].epoch = NULL;
+        }
+    }
+    epoch->records = NULL;
+    epoch->sequence = 0;
+    return epoch;
+}
@@ -30,6 +30,820 @@ SOFTWARE.
 
 #include <cgre/core/set.h>
 
+#include <stdlib.h>
+
+/**
+ * @def CGRE_HASH_LIST_SORTED 1
+ * @brief Sorted linked list mode of the hash list
+ *
+ * Members are chained in key order through `link[CGRE_NODE_HEAD]` and
+ * `link[CGRE_NODE_TAIL]`, searches walk from the head or the middle.
+ */
+
+/**
+ * @def CGRE_HASH_LIST_TABLE 2
+ * @brief Open addressing table mode of the hash list
+ *
+ * Members are held in a robin hood hash table owned by the set. Search,
+ * insert and delete are expected O(1), member links are left untouched and
+ * there is no key order.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&list);
+ * CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_TABLE);
+ * @endcode
+ */
+
+/**
+ * @def CGRE_HASH_LIST_SKIP 3
+ * @brief Skip list mode of the hash list
+ *
+ * Members stay chained in key order through `link[CGRE_NODE_HEAD]` and
+ * `link[CGRE_NODE_TAIL]` as in `CGRE_HASH_LIST_SORTED`, so in order walks
+ * are unchanged. A random quarter of them also stand in a first express
+ * lane, a quarter of those in a second and so on, in towers owned by the
+ * set. Search, insert and delete walk down the lanes and are expected
+ * O(log n). `cgre_node_set.link[CGRE_NODE_MIDDLE]` is not used.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&list);
+ * CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_SKIP);
+ * @endcode
+ */
+
+/**
+ * @def CGRE_HASH_SKIP_LEVELS 16
+ * @brief Most express lanes of a skip list hash list
+ *
+ * With a quarter of the members in each lane, 16 lanes stay useful up to
+ * about four billion members.
+ */
+
+/**
+ * @def CGRE_HASH_LIST_MODE_DEFAULT
+ * @brief Mode used by a hash list with no mode set
+ *
+ * Build with `-DCGRE_HASH_LIST_MODE_DEFAULT=CGRE_HASH_LIST_TABLE` to move
+ * every hash list without an explicit mode to the table.
+ */
+
+/**
+ * @def CGRE_HASH_LIST_MODE(N)
+ * @brief Compute the effective mode of a hash list from its state
+ */
+
+/**
+ * @def CGRE_HASH_TABLE_MIN_SIZE 16
+ * @brief Initial slot count of a hash list table, must be a power of 2
+ */
+
+/**
+ * @def CGRE_HASH_TABLE_DRAIN 8
+ * @brief Slots moved out of the previous table per operation while growing
+ *
+ * The table grows by doubling. Instead of rehashing every member at once,
+ * the previous table is kept and drained a few slots at a time by the
+ * following inserts and deletes, so no single call pays for the whole move.
+ */
+
+struct cgre_hash_slot {
+    struct cgre_node* node;
+    cgre_uint_t key;
+};
+
+struct cgre_hash_table {
+    struct cgre_node_store store;
+    cgre_uint_t drain;
+    struct cgre_hash_slot slot[];
+};
+
+/**
+ * @brief Compute the home slot of a key
+ *
+ * Keys are commonly small or sequential, so they are mixed before masking.
+ */
+static inline cgre_uint_t cgre_hash_table_home(
+        cgre_uint_t key,
+        cgre_uint_t mask)
+{
+    uint64_t mixed = (uint64_t) key;
+    mixed ^= mixed >> 33;
+    mixed *= UINT64_C(0xff51afd7ed558ccd);
+    mixed ^= mixed >> 33;
+    mixed *= UINT64_C(0xc4ceb9fe1a85ec53);
+    mixed ^= mixed >> 33;
+    return (cgre_uint_t) mixed & mask;
+}
+
+static struct cgre_hash_table* cgre_hash_table_create(
+        cgre_uint_t size)
+{
+    struct cgre_hash_table* table = calloc(1,
+            sizeof(struct cgre_hash_table) +
+            sizeof(struct cgre_hash_slot) * size);
+    if (table != NULL) {
+        table->store.size = size;
+    }
+    return table;
+}
+
+/**
+ * @brief Place a node known to be absent in a table with room for it
+ */
+static void cgre_hash_table_place(
+        struct cgre_hash_table* table,
+        struct cgre_node* node)
+{
+    cgre_uint_t mask = table->store.size - 1;
+    cgre_uint_t index = cgre_hash_table_home(node->key, mask);
+    struct cgre_hash_slot carry = { node, node->key };
+    for (cgre_uint_t distance = 0;; distance++) {
+        struct cgre_hash_slot* slot = &(table->slot[index]);
+        if (slot->node == NULL) {
+            *slot = carry;
+            break;
+        }
+        // Rich slots give way to poor ones
+        cgre_uint_t resident = (index -
+                cgre_hash_table_home(slot->key, mask)) & mask;
+        if (resident < distance) {
+            struct cgre_hash_slot swap = *slot;
+            *slot = carry;
+            carry = swap;
+            distance = resident;
+        }
+        index = (index + 1) & mask;
+    }
+    table->store.used++;
+}
+
+/**
+ * @brief Find the slot of a key in the current table
+ *
+ * @return slot index or table size when not found
+ */
+static cgre_uint_t cgre_hash_table_find(
+        struct cgre_hash_table* table,
+        cgre_uint_t key)
+{
+    cgre_uint_t mask = table->store.size - 1;
+    cgre_uint_t index = cgre_hash_table_home(key, mask);
+    for (cgre_uint_t distance = 0;; distance++) {
+        struct cgre_hash_slot* slot = &(table->slot[index]);
+        if (slot->node == NULL) {
+            return table->store.size;
+        }
+        if (slot->key == key) {
+            return index;
+        }
+        // Any further and the key would have displaced this slot
+        if (((index - cgre_hash_table_home(slot->key, mask)) & mask) <
+                distance) {
+            return table->store.size;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+/**
+ * @brief Empty a slot of the current table by shifting its cluster back
+ */
+static void cgre_hash_table_remove(
+        struct cgre_hash_table* table,
+        cgre_uint_t index)
+{
+    cgre_uint_t mask = table->store.size - 1;
+    for (;;) {
+        cgre_uint_t next = (index + 1) & mask;
+        struct cgre_hash_slot* slot = &(table->slot[next]);
+        if (slot->node == NULL ||
+                cgre_hash_table_home(slot->key, mask) == next) {
+            break;
+        }
+        table->slot[index] = *slot;
+        index = next;
+    }
+    table->slot[index].node = NULL;
+    table->store.used--;
+}
+
+/**
+ * @brief Find the slot of a key in a draining table
+ *
+ * Slots below `drain` were emptied by the move and are skipped over, so the
+ * probe chains of the remaining members stay intact.
+ *
+ * @return slot index or table size when not found
+ */
+static cgre_uint_t cgre_hash_table_find_old(
+        struct cgre_hash_table* old,
+        cgre_uint_t key)
+{
+    cgre_uint_t mask = old->store.size - 1;
+    cgre_uint_t index = cgre_hash_table_home(key, mask);
+    for (cgre_uint_t steps = 0; steps < old->store.size; steps++) {
+        if (index < old->drain) {
+            index = old->drain;
+        }
+        struct cgre_hash_slot* slot = &(old->slot[index]);
+        if (slot->node == NULL) {
+            break;
+        }
+        if (slot->key == key) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return old->store.size;
+}
+
+/**
+ * @brief Move up to `limit` slots of the draining table into the current one
+ *
+ * The draining table is released once empty.
+ */
+static void cgre_hash_table_drain(
+        struct cgre_hash_table* table,
+        cgre_uint_t limit)
+{
+    struct cgre_hash_table* old = (struct cgre_hash_table*) table->store.next;
+    if (old == NULL) {
+        return;
+    }
+    for (; limit > 0 && old->drain < old->store.size; limit--) {
+        struct cgre_hash_slot* slot = &(old->slot[old->drain]);
+        if (slot->node != NULL) {
+            cgre_hash_table_place(table, slot->node);
+            slot->node = NULL;
+            old->store.used--;
+        }
+        old->drain++;
+    }
+    if (old->store.used == 0 || old->drain == old->store.size) {
+        table->store.next = old->store.next;
+        free(old);
+    }
+}
+
+/**
+ * @brief Remove a slot of the draining table
+ *
+ * The members following it in the cluster may have probed through the slot,
+ * so they are moved to the current table rather than left unreachable.
+ */
+static void cgre_hash_table_remove_old(
+        struct cgre_hash_table* table,
+        struct cgre_hash_table* old,
+        cgre_uint_t index)
+{
+    cgre_uint_t mask = old->store.size - 1;
+    old->slot[index].node = NULL;
+    old->store.used--;
+    for (index = (index + 1) & mask;; index = (index + 1) & mask) {
+        if (index < old->drain) {
+            index = old->drain;
+        }
+        struct cgre_hash_slot* slot = &(old->slot[index]);
+        if (slot->node == NULL) {
+            break;
+        }
+        cgre_hash_table_place(table, slot->node);
+        slot->node = NULL;
+        old->store.used--;
+    }
+}
+
+/**
+ * @brief Make sure the current table has room for one more member
+ *
+ * @return current table or NULL on allocation error
+ */
+static struct cgre_hash_table* cgre_hash_table_reserve(
+        struct cgre_node_set* list)
+{
+    struct cgre_hash_table* table = (struct cgre_hash_table*) list->store;
+    if (table == NULL) {
+        table = cgre_hash_table_create(CGRE_HASH_TABLE_MIN_SIZE);
+        list->store = (struct cgre_node_store*) table;
+        return table;
+    }
+    // Keep the load under 7/8
+    if ((table->store.used + 1) * 8 <= table->store.size * 7) {
+        return table;
+    }
+    // Still moving the last growth? Finish it first
+    cgre_hash_table_drain(table, CGRE_UINT_MAX);
+    struct cgre_hash_table* grown = cgre_hash_table_create(
+            table->store.size << 1);
+    if (grown == NULL) {
+        return NULL;
+    }
+    grown->store.next = (struct cgre_node_store*) table;
+    list->store = (struct cgre_node_store*) grown;
+    return grown;
+}
+
+/**
+ * @brief Delete a key from the hash list table
+ */
+static struct cgre_node* cgre_hash_table_delete(
+        struct cgre_node_set* list,
+        cgre_uint_t key)
+{
+    struct cgre_node* removed = NULL;
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_hash_table* table = (struct cgre_hash_table*) list->store;
+    if (table != NULL) {
+        cgre_uint_t index = cgre_hash_table_find(table, key);
+        if (index != table->store.size) {
+            removed = table->slot[index].node;
+            cgre_hash_table_remove(table, index);
+        } else if (table->store.next != NULL) {
+            struct cgre_hash_table* old =
+                (struct cgre_hash_table*) table->store.next;
+            index = cgre_hash_table_find_old(old, key);
+            if (index != old->store.size) {
+                removed = old->slot[index].node;
+                cgre_hash_table_remove_old(table, old, index);
+            }
+        }
+        if (removed != NULL) {
+            list->count--;
+        }
+        cgre_hash_table_drain(table, CGRE_HASH_TABLE_DRAIN);
+    }
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+    }
+    return removed;
+}
+
+/**
+ * @brief Insert a node into the locked hash list table
+ */
+static struct cgre_node* cgre_hash_table_put(
+        struct cgre_node_set* list,
+        struct cgre_node* node)
+{
+    struct cgre_hash_table* table = (struct cgre_hash_table*) list->store;
+    // Are we already here?
+    if (table == NULL ||
+            (cgre_hash_table_find(table, node->key) == table->store.size &&
+            (table->store.next == NULL || cgre_hash_table_find_old(
+                (struct cgre_hash_table*) table->store.next, node->key) ==
+                table->store.next->size))) {
+        // No. Make room and take a slot
+        table = cgre_hash_table_reserve(list);
+        if (table != NULL) {
+            cgre_hash_table_place(table, node);
+            cgre_hash_table_drain(table, CGRE_HASH_TABLE_DRAIN);
+            list->count++;
+            return node;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Insert a node into the hash list table
+ */
+static struct cgre_node* cgre_hash_table_insert(
+        struct cgre_node_set* list,
+        struct cgre_node* node)
+{
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_node* inserted = cgre_hash_table_put(list, node);
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+    }
+    return inserted;
+}
+
+/**
+ * @brief Find the slot holding a key in either table
+ *
+ * @return slot pointer or NULL when not found
+ */
+static struct cgre_hash_slot* cgre_hash_table_slot(
+        struct cgre_node_set* list,
+        cgre_uint_t key)
+{
+    struct cgre_hash_table* table = (struct cgre_hash_table*) list->store;
+    if (table == NULL) {
+        return NULL;
+    }
+    cgre_uint_t index = cgre_hash_table_find(table, key);
+    if (index != table->store.size) {
+        return &(table->slot[index]);
+    }
+    struct cgre_hash_table* old = (struct cgre_hash_table*) table->store.next;
+    if (old != NULL) {
+        index = cgre_hash_table_find_old(old, key);
+        if (index != old->store.size) {
+            return &(old->slot[index]);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Replace the node holding a key in the hash list table
+ */
+static struct cgre_node* cgre_hash_table_replace(
+        struct cgre_node_set* list,
+        struct cgre_node* node)
+{
+    struct cgre_node* replaced = NULL;
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_hash_slot* slot = cgre_hash_table_slot(list, node->key);
+    if (slot != NULL) {
+        replaced = slot->node;
+        slot->node = node;
+    }
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    return replaced;
+}
+
+/**
+ * @brief Search for a key in the hash list table
+ */
+static struct cgre_node* cgre_hash_table_search(
+        struct cgre_node_set* list,
+        cgre_uint_t key)
+{
+    struct cgre_node* found = NULL;
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_hash_slot* slot = cgre_hash_table_slot(list, key);
+    if (slot != NULL) {
+        found = slot->node;
+    }
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    return found;
+}
+
+struct cgre_hash_skip_tower {
+    struct cgre_node* node;
+    cgre_uint_t key;
+    cgre_uint_t height;
+    struct cgre_hash_skip_tower* next[];
+};
+
+struct cgre_hash_skip_chunk {
+    struct cgre_node_store store;
+    char bytes[];
+};
+
+/**
+ * @brief Skip list index owned by a set, first block of its store
+ *
+ * `lane` holds the first tower of every express lane, `level` the number of
+ * lanes in use. Towers are carved from chunks chained after this block and
+ * released towers wait in `free` by height.
+ */
+struct cgre_hash_skip {
+    struct cgre_node_store store;
+    cgre_uint_t level;
+    cgre_uint_t seed;
+    struct cgre_hash_skip_tower* lane[CGRE_HASH_SKIP_LEVELS];
+    struct cgre_hash_skip_tower* free[CGRE_HASH_SKIP_LEVELS + 1];
+};
+
+/**
+ * @brief Get the skip list index of a list, creating it when asked
+ */
+static struct cgre_hash_skip* cgre_hash_skip_index(
+        struct cgre_node_set* list,
+        cgre_int_t create)
+{
+    if (list->store == NULL && create) {
+        struct cgre_hash_skip* skip = calloc(1, sizeof(struct cgre_hash_skip));
+        if (skip != NULL) {
+            skip->seed = 0x9e3779b9u;
+            list->store = (struct cgre_node_store*) skip;
+        }
+    }
+    return (struct cgre_hash_skip*) list->store;
+}
+
+/**
+ * @brief Draw the number of lanes a new member joins
+ *
+ * Each lane holds about a quarter of the members of the one below, so a
+ * search crosses about four members per lane.
+ */
+static cgre_uint_t cgre_hash_skip_height(
+        struct cgre_hash_skip* skip)
+{
+    cgre_uint_t draw = skip->seed;
+    draw ^= draw << 13;
+    draw ^= draw >> 17;
+    draw ^= draw << 5;
+    skip->seed = draw;
+    cgre_uint_t height = 0;
+    for (; (draw & 3) == 0 && height < CGRE_HASH_SKIP_LEVELS; draw >>= 2) {
+        height++;
+    }
+    return height;
+}
+
+static struct cgre_hash_skip_tower* cgre_hash_skip_tower_create(
+        struct cgre_hash_skip* skip,
+        cgre_uint_t height)
+{
+    struct cgre_hash_skip_tower* tower = skip->free[height];
+    if (tower != NULL) {
+        skip->free[height] = tower->next[0];
+        return tower;
+    }
+    cgre_uint_t bytes = sizeof(struct cgre_hash_skip_tower) +
+        sizeof(struct cgre_hash_skip_tower*) * height;
+    struct cgre_hash_skip_chunk* chunk =
+        (struct cgre_hash_skip_chunk*) skip->store.next;
+    if (chunk == NULL || chunk->store.size - chunk->store.used < bytes) {
+        // Chunks double up to 256KiB, so there are few of them
+        cgre_uint_t size = chunk == NULL ? 4096 : chunk->store.size * 2;
+        if (size > 262144) {
+            size = 262144;
+        }
+        chunk = malloc(sizeof(struct cgre_hash_skip_chunk) + size);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->store.next = skip->store.next;
+        chunk->store.size = size;
+        chunk->store.used = 0;
+        skip->store.next = (struct cgre_node_store*) chunk;
+    }
+    tower = (struct cgre_hash_skip_tower*) &(chunk->bytes[chunk->store.used]);
+    chunk->store.used += bytes;
+    tower->height = height;
+    return tower;
+}
+
+static void cgre_hash_skip_tower_release(
+        struct cgre_hash_skip* skip,
+        struct cgre_hash_skip_tower* tower)
+{
+    tower->next[0] = skip->free[tower->height];
+    skip->free[tower->height] = tower;
+}
+
+/**
+ * @brief Find the first member at or above a key in a locked list
+ *
+ * Walks down the express lanes, then along the member links from the last
+ * tower below the key. When `update` is given it receives, for every lane in
+ * use, the `next` array whose entry at that lane precedes the key.
+ */
+static struct cgre_node* cgre_hash_skip_find(
+        struct cgre_node_set* list,
+        struct cgre_hash_skip* skip,
+        cgre_uint_t key,
+        struct cgre_hash_skip_tower*** update)
+{
+    struct cgre_hash_skip_tower* below = NULL;
+    if (skip != NULL) {
+        struct cgre_hash_skip_tower** next = skip->lane;
+        for (cgre_uint_t level = skip->level; level > 0; level--) {
+            while (next[level - 1] != NULL && next[level - 1]->key < key) {
+                below = next[level - 1];
+                next = below->next;
+            }
+            if (update != NULL) {
+                update[level - 1] = next;
+            }
+        }
+    }
+    struct cgre_node* node = below == NULL ?
+        list->link[CGRE_NODE_HEAD] : below->node;
+    while (node != NULL && node->key < key) {
+        node = node->link[CGRE_NODE_TAIL];
+    }
+    return node;
+}
+
+/**
+ * @brief Insert a node into the locked skip list
+ *
+ * @return node or NULL when the key is already present
+ */
+static struct cgre_node* cgre_hash_skip_put(
+        struct cgre_node_set* list,
+        struct cgre_node* node)
+{
+    struct cgre_hash_skip_tower** update[CGRE_HASH_SKIP_LEVELS];
+    struct cgre_hash_skip* skip = cgre_hash_skip_index(list, 1);
+    struct cgre_node* after = cgre_hash_skip_find(list, skip, node->key,
+            update);
+    if (after != NULL && after->key == node->key) {
+        return NULL;
+    }
+    // Link between the members below and above the key
+    node->link[CGRE_NODE_TAIL] = after;
+    node->link[CGRE_NODE_HEAD] = after == NULL ?
+        list->link[CGRE_NODE_TAIL] : after->link[CGRE_NODE_HEAD];
+    if (node->link[CGRE_NODE_HEAD] != NULL) {
+        node->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] = node;
+    } else {
+        list->link[CGRE_NODE_HEAD] = node;
+    }
+    if (after != NULL) {
+        after->link[CGRE_NODE_HEAD] = node;
+    } else {
+        list->link[CGRE_NODE_TAIL] = node;
+    }
+    list->count++;
+    if (skip == NULL) {
+        // No index memory, the member is still reachable through its links
+        return node;
+    }
+    cgre_uint_t height = cgre_hash_skip_height(skip);
+    if (height == 0) {
+        return node;
+    }
+    struct cgre_hash_skip_tower* tower = cgre_hash_skip_tower_create(skip,
+            height);
+    if (tower == NULL) {
+        return node;
+    }
+    tower->node = node;
+    tower->key = node->key;
+    for (; skip->level < height; skip->level++) {
+        update[skip->level] = skip->lane;
+    }
+    for (cgre_uint_t level = 0; level < height; level++) {
+        tower->next[level] = update[level][level];
+        update[level][level] = tower;
+    }
+    return node;
+}
+
+/**
+ * @brief Delete a key from the locked skip list
+ */
+static struct cgre_node* cgre_hash_skip_remove(
+        struct cgre_node_set* list,
+        cgre_uint_t key)
+{
+    struct cgre_hash_skip_tower** update[CGRE_HASH_SKIP_LEVELS];
+    struct cgre_hash_skip* skip = cgre_hash_skip_index(list, 0);
+    struct cgre_node* removed = cgre_hash_skip_find(list, skip, key, update);
+    if (removed == NULL || removed->key != key) {
+        return NULL;
+    }
+    if (removed->link[CGRE_NODE_HEAD] != NULL) {
+        removed->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] =
+            removed->link[CGRE_NODE_TAIL];
+    } else {
+        list->link[CGRE_NODE_HEAD] = removed->link[CGRE_NODE_TAIL];
+    }
+    if (removed->link[CGRE_NODE_TAIL] != NULL) {
+        removed->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] =
+            removed->link[CGRE_NODE_HEAD];
+    } else {
+        list->link[CGRE_NODE_TAIL] = removed->link[CGRE_NODE_HEAD];
+    }
+    removed->link[CGRE_NODE_HEAD] = NULL;
+    removed->link[CGRE_NODE_TAIL] = NULL;
+    list->count--;
+    // A tower of the key follows the lowest lane entry found
+    if (skip != NULL && skip->level > 0 && update[0][0] != NULL &&
+            update[0][0]->key == key) {
+        struct cgre_hash_skip_tower* tower = update[0][0];
+        for (cgre_uint_t level = 0; level < tower->height; level++) {
+            update[level][level] = tower->next[level];
+        }
+        cgre_hash_skip_tower_release(skip, tower);
+        while (skip->level > 0 && skip->lane[skip->level - 1] == NULL) {
+            skip->level--;
+        }
+    }
+    return removed;
+}
+
+static struct cgre_node* cgre_hash_skip_delete(
+        struct cgre_node_set* list,
+        cgre_uint_t key)
+{
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_node* removed = cgre_hash_skip_remove(list, key);
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+    }
+    return removed;
+}
+
+static struct cgre_node* cgre_hash_skip_insert(
+        struct cgre_node_set* list,
+        struct cgre_node* node)
+{
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_node* inserted = cgre_hash_skip_put(list, node);
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+    }
+    return inserted;
+}
+
+static struct cgre_node* cgre_hash_skip_replace(
+        struct cgre_node_set* list,
+        struct cgre_node* node)
+{
+    struct cgre_hash_skip_tower** update[CGRE_HASH_SKIP_LEVELS];
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_hash_skip* skip = cgre_hash_skip_index(list, 0);
+    struct cgre_node* replaced = cgre_hash_skip_find(list, skip, node->key,
+            update);
+    if (replaced != NULL && replaced->key == node->key) {
+        node->link[CGRE_NODE_HEAD] = replaced->link[CGRE_NODE_HEAD];
+        node->link[CGRE_NODE_TAIL] = replaced->link[CGRE_NODE_TAIL];
+        if (node->link[CGRE_NODE_HEAD] != NULL) {
+            node->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] = node;
+        } else {
+            list->link[CGRE_NODE_HEAD] = node;
+        }
+        if (node->link[CGRE_NODE_TAIL] != NULL) {
+            node->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] = node;
+        } else {
+            list->link[CGRE_NODE_TAIL] = node;
+        }
+        if (skip != NULL && skip->level > 0 && update[0][0] != NULL &&
+                update[0][0]->key == node->key) {
+            update[0][0]->node = node;
+        }
+    } else {
+        replaced = NULL;
+    }
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    return replaced;
+}
+
+static struct cgre_node* cgre_hash_skip_search(
+        struct cgre_node_set* list,
+        cgre_uint_t key)
+{
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    struct cgre_node* found = cgre_hash_skip_find(list,
+            cgre_hash_skip_index(list, 0), key, NULL);
+    if (found != NULL && found->key != key) {
+        found = NULL;
+    }
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return NULL;
+    }
+    return found;
+}
+
 /**
  * @brief Delete a node from the list
  *
@@ -41,8 +855,14 @@ struct cgre_node* cgre_hash_list_delete(
         struct cgre_node_set* list,
         cgre_uint_t key)
 {
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_TABLE) {
+        return cgre_hash_table_delete(list, key);
+    }
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_SKIP) {
+        return cgre_hash_skip_delete(list, key);
+    }
     struct cgre_node* removed = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(list->lock));
+    cgre_int_t fail = cgre_node_set_lock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
         return NULL;
@@ -63,7 +883,7 @@ struct cgre_node* cgre_hash_list_delete(
             if (removed->link[CGRE_NODE_TAIL] == NULL &&
                     key != removed->key) {
                 // We are done working on this list
-                fail = pthread_mutex_unlock(&(list->lock));
+                fail = cgre_node_set_unlock(list);
                 if (fail) {
                     CGRE_NODES_LOCK_SET_FAIL(list->state);
                 }
@@ -83,7 +903,7 @@ struct cgre_node* cgre_hash_list_delete(
             if (removed->link[CGRE_NODE_TAIL] == list->link[CGRE_NODE_MIDDLE] &&
                     key != removed->key) {
                 // We are done working on this list
-                fail = pthread_mutex_unlock(&(list->lock));
+                fail = cgre_node_set_unlock(list);
                 if (fail) {
                     CGRE_NODES_LOCK_SET_FAIL(list->state);
                 }
@@ -113,13 +933,79 @@ struct cgre_node* cgre_hash_list_delete(
         }
         list->count--;
     }
-    fail = pthread_mutex_unlock(&(list->lock));
+    fail = cgre_node_set_unlock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
     }
     return removed;
 }
 
+/**
+ * @brief Insert a node into the locked sorted list
+ *
+ * @return node or NULL when the key is already present
+ */
+static struct cgre_node* cgre_hash_list_place(
+        struct cgre_node_set* list,
+        struct cgre_node* node)
+{
+    // Could be dealing with a 0 member list, so start at NULL
+    struct cgre_node* parent = NULL;
+    node->link[CGRE_NODE_HEAD] = NULL;
+    node->link[CGRE_NODE_TAIL] = NULL;
+    // Are we the only one?
+    if (list->count == 0) {
+        // Yes. We are the head, middle and tail
+        list->link[CGRE_NODE_HEAD] = node;
+        list->link[CGRE_NODE_MIDDLE] = node;
+        list->link[CGRE_NODE_TAIL] = node;
+        list->count++;
+        return node;
+    }
+    // Start from the middle when we are above the fold, the head otherwise
+    if (node->key >= list->link[CGRE_NODE_MIDDLE]->key) {
+        parent = list->link[CGRE_NODE_MIDDLE];
+    } else if (node->key >= list->link[CGRE_NODE_HEAD]->key) {
+        parent = list->link[CGRE_NODE_HEAD];
+    }
+    // Climb up the list to the last member not above us
+    if (parent != NULL) {
+        while (parent->link[CGRE_NODE_TAIL] != NULL &&
+                parent->link[CGRE_NODE_TAIL]->key <= node->key) {
+            parent = parent->link[CGRE_NODE_TAIL];
+        }
+        // Are we already here?
+        if (parent->key == node->key) {
+            // Yes. We cannot be inserted
+            return NULL;
+        }
+        node->link[CGRE_NODE_TAIL] = parent->link[CGRE_NODE_TAIL];
+        parent->link[CGRE_NODE_TAIL] = node;
+    } else {
+        // Below the head, we are the new head
+        node->link[CGRE_NODE_TAIL] = list->link[CGRE_NODE_HEAD];
+        list->link[CGRE_NODE_HEAD] = node;
+    }
+    node->link[CGRE_NODE_HEAD] = parent;
+    if (node->link[CGRE_NODE_TAIL] != NULL) {
+        node->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] = node;
+    } else {
+        list->link[CGRE_NODE_TAIL] = node;
+    }
+    list->count++;
+    // Keep the middle at the fold
+    if (node->key < list->link[CGRE_NODE_MIDDLE]->key) {
+        if ((list->count & 1) == 0) {
+            list->link[CGRE_NODE_MIDDLE] =
+                list->link[CGRE_NODE_MIDDLE]->link[CGRE_NODE_HEAD];
+        }
+    } else if (list->count & 1) {
+        list->link[CGRE_NODE_MIDDLE] =
+            list->link[CGRE_NODE_MIDDLE]->link[CGRE_NODE_TAIL];
+    }
+    return node;
+}
+
 /**
  * @brief Insert a node into the list
  *
@@ -134,137 +1020,79 @@ struct cgre_node* cgre_hash_list_insert(
         struct cgre_node_set* list,
         struct cgre_node* node)
 {
-    // Could be dealing with a 0 member list, so start at NULL
-    struct cgre_node* parent = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(list->lock));
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_TABLE) {
+        return cgre_hash_table_insert(list, node);
+    }
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_SKIP) {
+        return cgre_hash_skip_insert(list, node);
+    }
+    cgre_int_t fail = cgre_node_set_lock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
         return NULL;
     }
-    // Do we really need to search?
-    if (list->count < 2) {
-        // No. Are we the only one?
-        if (list->count == 0) {
-            // Yes. We are the head, middle and tail
-            list->link[CGRE_NODE_HEAD] = node;
-            list->link[CGRE_NODE_MIDDLE] = node;
-            list->link[CGRE_NODE_TAIL] = node;
-        } else {
-            // No. Are we after the only item?
-            if (node->key > list->link[CGRE_NODE_HEAD]->key) {
-                // Yes. That is our head
-                parent = list->link[CGRE_NODE_HEAD];
-                // We are tail
-                parent->link[CGRE_NODE_TAIL] = node;
-                list->link[CGRE_NODE_TAIL] = node;
-            } else {
-                // No. We have no HEAD, but we have a tail
-                node->link[CGRE_NODE_TAIL] = node->link[CGRE_NODE_HEAD];
-                // We are the new head
-                list->link[CGRE_NODE_HEAD] = node;
-                list->link[CGRE_NODE_TAIL] = parent;
+    node = cgre_hash_list_place(list, node);
+    fail = cgre_node_set_unlock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+    }
+    return node;
+}
+
+/**
+ * @brief Insert many nodes into the list under one lock
+ *
+ * @param[in] list The Node List to operate on
+ * @param[in,out] nodes Nodes to insert, those not inserted are set to NULL
+ * @param[in] count Number of nodes
+ * @return number of nodes inserted
+ */
+cgre_uint_t cgre_hash_list_insert_many(
+        struct cgre_node_set* list,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    cgre_uint_t inserted = 0;
+    if (list == NULL || nodes == NULL) {
+        return 0;
+    }
+    cgre_int_t fail = cgre_node_set_lock(list);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(list->state);
+        return 0;
+    }
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_TABLE) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            // Fetch nodes ahead, then the home slots of the nodes fetched
+            if (idx + 2 * CGRE_NODES_PREFETCH < count) {
+                __builtin_prefetch(nodes[idx + 2 * CGRE_NODES_PREFETCH]);
             }
-        }
-    // Yes. Before we work, Are we already the HEAD, MIDDLE or TAIL?
-    } else if (node->key == list->link[CGRE_NODE_MIDDLE]->key ||
-            node->key == list->link[CGRE_NODE_HEAD]->key ||
-            node->key == list->link[CGRE_NODE_TAIL]->key) {
-            // Yes. We cannot be inserted
-            fail = pthread_mutex_unlock(&(list->lock));
-            if (fail) {
-                CGRE_NODES_LOCK_SET_FAIL(list->state);
+            struct cgre_hash_table* table =
+                    (struct cgre_hash_table*) list->store;
+            if (table != NULL && idx + CGRE_NODES_PREFETCH < count) {
+                __builtin_prefetch(&(table->slot[cgre_hash_table_home(
+                        nodes[idx + CGRE_NODES_PREFETCH]->key,
+                        table->store.size - 1)]));
             }
-            return NULL;
+            nodes[idx] = cgre_hash_table_put(list, nodes[idx]);
+            inserted += nodes[idx] != NULL;
+        }
+    } else if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_SKIP) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            nodes[idx] = cgre_hash_skip_put(list, nodes[idx]);
+            inserted += nodes[idx] != NULL;
+        }
     } else {
-        // Are we below the middle?
-        if (node->key < list->link[CGRE_NODE_MIDDLE]->key) {
-            // Yes. Are we below the head?
-            if (node->key < list->link[CGRE_NODE_HEAD]->key) {
-                // Yes. Our tail is the current head
-                node->link[CGRE_NODE_TAIL] = list->link[CGRE_NODE_HEAD];
-                // We have no head, and we are the new head
-                list->link[CGRE_NODE_HEAD] = node;
-            } else {
-                // We will start our search at parent head
-                parent = list->link[CGRE_NODE_HEAD];
-                // We are somewhere above parent, but before the MIDDLE or TAIL
-                for (cgre_int_t steps = (list->count - (list->count >> 1));
-                        steps > 0 && parent->link[CGRE_NODE_TAIL] != NULL;
-                        steps--) {
-                    // Are we already here?
-                    if(parent->link[CGRE_NODE_TAIL]->key == node->key){
-                        // Yes. We cannot be inserted
-                        fail = pthread_mutex_unlock(&(list->lock));
-                        if (fail) {
-                            CGRE_NODES_LOCK_SET_FAIL(list->state);
-                        }
-                        return NULL;
-                    // Are we above this, but before the next?
-                    } else if (node->key > parent->key &&
-                            node->key < parent->link[CGRE_NODE_TAIL]->key) {
-                        // Yes. Next is our tail and we are next head
-                        node->link[CGRE_NODE_TAIL] = parent->link[CGRE_NODE_TAIL];
-                        parent->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] = node;
-                        // We are the tail of the parent
-                        parent->link[CGRE_NODE_TAIL] = node;
-                        break;
-                    } else {
-                        // Let's check the next item
-                        parent = parent->link[CGRE_NODE_TAIL];
-                    }
-                }
-            }
-        // Are we above the middle?
-        } else {
-            // Yes. Are we above the tail?
-            if (node->key > list->link[CGRE_NODE_TAIL]->key){
-                // Yes. We have no tail
-                // Our head is the current tail
-                node->link[CGRE_NODE_HEAD] = list->link[CGRE_NODE_TAIL];
-                // We are the new tail
-                list->link[CGRE_NODE_TAIL] = node;
-            } else {
-                // We will start our search at the parent middle
-                parent = list->link[CGRE_NODE_MIDDLE];
-                // We are somewhere above middle but before tail
-                for (cgre_int_t steps = (list->count - (list->count >> 1));
-                        steps > 0 && parent->link[CGRE_NODE_TAIL] != NULL;
-                        steps--) {
-                    // Are we already here?
-                    if(parent->link[CGRE_NODE_TAIL]->key == node->key){
-                        // Yes. We cannot be inserted
-                        fail = pthread_mutex_unlock(&(list->lock));
-                        if (fail) {
-                            CGRE_NODES_LOCK_SET_FAIL(list->state);
-                        }
-                        return NULL;
-                    // Are we above this but before next?
-                    } else if (node->key > parent->key &&
-                            node->key < parent->link[CGRE_NODE_TAIL]->key) {
-                        // Yes. Next is our tail and we are next head
-                        node->link[CGRE_NODE_TAIL] = parent->link[CGRE_NODE_TAIL];
-                        parent->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] = node;
-                        // We are the tail of the parent
-                        parent->link[CGRE_NODE_TAIL] = node;
-                        break;
-                    } else {
-                        // Let's check the next item
-                        parent = parent->link[CGRE_NODE_TAIL];
-                    }
-                }
-            }
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            nodes[idx] = cgre_hash_list_place(list, nodes[idx]);
+            inserted += nodes[idx] != NULL;
         }
     }
-    list->count++;
-    // Do we need a new middle?
-    if (list->count > 2 && (list->count & 1)) {
-        list->link[CGRE_NODE_MIDDLE] = list->link[CGRE_NODE_MIDDLE]->link[CGRE_NODE_TAIL];
-    }
-    fail = pthread_mutex_unlock(&(list->lock));
+    fail = cgre_node_set_unlock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
     }
-    return node;
+    return inserted;
 }
 
 /**
@@ -278,10 +1106,16 @@ struct cgre_node* cgre_hash_list_replace(
         struct cgre_node_set* list,
         struct cgre_node* node)
 {
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_TABLE) {
+        return cgre_hash_table_replace(list, node);
+    }
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_SKIP) {
+        return cgre_hash_skip_replace(list, node);
+    }
     struct cgre_node* replaced = NULL;
     struct cgre_node* check = NULL;
     // We are going to be working on this list
-    cgre_int_t fail = pthread_mutex_lock(&(list->lock));
+    cgre_int_t fail = cgre_node_set_lock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
         return NULL;
@@ -333,7 +1167,7 @@ struct cgre_node* cgre_hash_list_replace(
         }
     }
     // We are done working with this list
-    fail = pthread_mutex_unlock(&(list->lock));
+    fail = cgre_node_set_unlock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
         return NULL;
@@ -352,10 +1186,16 @@ struct cgre_node* cgre_hash_list_search(
         struct cgre_node_set* list,
         cgre_uint_t key)
 {
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_TABLE) {
+        return cgre_hash_table_search(list, key);
+    }
+    if (CGRE_HASH_LIST_MODE(list->state) == CGRE_HASH_LIST_SKIP) {
+        return cgre_hash_skip_search(list, key);
+    }
     struct cgre_node* found = NULL;
     struct cgre_node* check = NULL;
     // We are going to be working on this list
-    cgre_int_t fail = pthread_mutex_lock(&(list->lock));
+    cgre_int_t fail = cgre_node_set_lock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
         return NULL;
@@ -391,7 +1231,7 @@ struct cgre_node* cgre_hash_list_search(
         }
     }
     // We are done working with this list
-    fail = pthread_mutex_unlock(&(list->lock));
+    fail = cgre_node_set_unlock(list);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(list->state);
         return NULL;
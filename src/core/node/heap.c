@@ -0,0 +1,332 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/core/set.h>
+
+#include <stdlib.h>
+
+/**
+ * @def CGRE_HEAP_ARITY 4
+ * @brief Children of every heap member
+ *
+ * Wider heaps are shallower, so pushes and decreases climb fewer levels and
+ * the children compared on the way down share cache lines.
+ */
+
+/**
+ * @def CGRE_HEAP_MIN_SIZE 16
+ * @brief Initial slot count of a heap
+ */
+
+/**
+ * @brief Heap members in level order, held in the set store
+ *
+ * Every member keeps its slot in `cgre_node.dir` so it can be found again
+ * by `cgre_heap_decrease()`.
+ */
+struct cgre_heap_vector {
+    struct cgre_node_store store;
+    struct cgre_node* slot[];
+};
+
+/**
+ * @brief Make sure the heap has room for more members
+ *
+ * The buffer doubles until it fits.
+ *
+ * @return vector or NULL on allocation error
+ */
+static struct cgre_heap_vector* cgre_heap_reserve(
+        struct cgre_node_set* heap,
+        cgre_uint_t count)
+{
+    struct cgre_heap_vector* vector = (struct cgre_heap_vector*) heap->store;
+    if (vector != NULL && heap->count + count <= vector->store.size) {
+        return vector;
+    }
+    cgre_uint_t size = (vector == NULL) ?
+        CGRE_HEAP_MIN_SIZE : vector->store.size;
+    while (size < heap->count + count) {
+        size <<= 1;
+    }
+    struct cgre_heap_vector* grown = realloc(vector,
+            sizeof(struct cgre_heap_vector) +
+            sizeof(struct cgre_node*) * size);
+    if (grown == NULL) {
+        return NULL;
+    }
+    if (vector == NULL) {
+        grown->store.next = NULL;
+        grown->store.used = 0;
+    }
+    grown->store.size = size;
+    heap->store = (struct cgre_node_store*) grown;
+    return grown;
+}
+
+/**
+ * @brief Move a member towards the root until its parent is not larger
+ */
+static void cgre_heap_up(
+        struct cgre_heap_vector* vector,
+        cgre_uint_t index)
+{
+    struct cgre_node* node = vector->slot[index];
+    while (index > 0) {
+        cgre_uint_t parent = (index - 1) / CGRE_HEAP_ARITY;
+        if (vector->slot[parent]->key <= node->key) {
+            break;
+        }
+        // Pull the parent down into the hole
+        vector->slot[index] = vector->slot[parent];
+        vector->slot[index]->dir = index;
+        index = parent;
+    }
+    vector->slot[index] = node;
+    node->dir = index;
+}
+
+/**
+ * @brief Move a member towards the leaves until no child is smaller
+ */
+static void cgre_heap_down(
+        struct cgre_heap_vector* vector,
+        cgre_uint_t count,
+        cgre_uint_t index)
+{
+    struct cgre_node* node = vector->slot[index];
+    for (;;) {
+        cgre_uint_t first = index * CGRE_HEAP_ARITY + 1;
+        if (first >= count) {
+            break;
+        }
+        cgre_uint_t last = (count - first > CGRE_HEAP_ARITY) ?
+            first + CGRE_HEAP_ARITY : count;
+        // Find the smallest child
+        cgre_uint_t child = first;
+        for (cgre_uint_t sibling = first + 1; sibling < last; sibling++) {
+            if (vector->slot[sibling]->key < vector->slot[child]->key) {
+                child = sibling;
+            }
+        }
+        if (node->key <= vector->slot[child]->key) {
+            break;
+        }
+        // Push the child up into the hole
+        vector->slot[index] = vector->slot[child];
+        vector->slot[index]->dir = index;
+        index = child;
+    }
+    vector->slot[index] = node;
+    node->dir = index;
+}
+
+/**
+ * @brief Build a heap from an array of nodes at once
+ *
+ * The nodes are placed as given then sifted down from the last parent to the
+ * root under a single lock, in O(n) rather than the O(n log n) of pushing
+ * them one by one.
+ *
+ * @param[in] heap Empty heap to build
+ * @param[in] nodes Nodes to add
+ * @param[in] count Number of nodes
+ * @return heap or NULL if the heap is not empty or error
+ */
+struct cgre_node_set* cgre_heap_build(
+        struct cgre_node_set* heap,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    struct cgre_node_set* built = NULL;
+    if (heap == NULL || (nodes == NULL && count > 0)) {
+        return NULL;
+    }
+    cgre_int_t fail = cgre_node_set_lock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+        return NULL;
+    }
+    struct cgre_heap_vector* vector = NULL;
+    if (heap->count == 0 && (vector = cgre_heap_reserve(heap, count))) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            vector->slot[idx] = nodes[idx];
+            nodes[idx]->dir = idx;
+        }
+        heap->count = count;
+        vector->store.used = count;
+        // Leaves are heaps already, fix up every parent bottom up
+        for (cgre_uint_t parent = (count + CGRE_HEAP_ARITY - 2) /
+                CGRE_HEAP_ARITY; parent > 0; parent--) {
+            cgre_heap_down(vector, count, parent - 1);
+        }
+        built = heap;
+    }
+    fail = cgre_node_set_unlock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+    }
+    return built;
+}
+
+/**
+ * @brief Lower the key of a heap member
+ *
+ * The member moves towards the root as needed, in O(log n) without a search
+ * since it knows its own slot.
+ *
+ * @param[in] heap The Node Set holding the member
+ * @param[in] node The member to update
+ * @param[in] key The new key, not larger than the current one
+ * @return node or NULL if not a member, the key is larger or error
+ */
+struct cgre_node* cgre_heap_decrease(
+        struct cgre_node_set* heap,
+        struct cgre_node* node,
+        cgre_uint_t key)
+{
+    struct cgre_node* decreased = NULL;
+    cgre_int_t fail = cgre_node_set_lock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+        return NULL;
+    }
+    struct cgre_heap_vector* vector = (struct cgre_heap_vector*) heap->store;
+    // Is it really our member, and going the right way?
+    if (node->dir < heap->count && vector->slot[node->dir] == node &&
+            key <= node->key) {
+        node->key = key;
+        cgre_heap_up(vector, node->dir);
+        decreased = node;
+    }
+    fail = cgre_node_set_unlock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+    }
+    return decreased;
+}
+
+/**
+ * @brief Get the member with the smallest key without removing it
+ *
+ * @param[in] heap The Node Set to peek on
+ * @return node or NULL on empty or error
+ */
+struct cgre_node* cgre_heap_peek(
+        struct cgre_node_set* heap)
+{
+    struct cgre_node* peek = NULL;
+    cgre_int_t fail = cgre_node_set_lock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+        return NULL;
+    }
+    if (heap->count > 0) {
+        peek = ((struct cgre_heap_vector*) heap->store)->slot[0];
+    }
+    fail = cgre_node_set_unlock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+    }
+    return peek;
+}
+
+/**
+ * @brief Remove the member with the smallest key
+ *
+ * @param[in] heap The Node Set to pop from
+ * @return node or NULL on empty or error
+ *
+ * @remark
+ * Members with the same key come out in no particular order.
+ */
+struct cgre_node* cgre_heap_pop(
+        struct cgre_node_set* heap)
+{
+    struct cgre_node* popped = NULL;
+    cgre_int_t fail = cgre_node_set_lock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+        return NULL;
+    }
+    if (heap->count > 0) {
+        struct cgre_heap_vector* vector =
+            (struct cgre_heap_vector*) heap->store;
+        popped = vector->slot[0];
+        heap->count--;
+        vector->store.used--;
+        // Sink the last member from the root
+        if (heap->count > 0) {
+            vector->slot[0] = vector->slot[heap->count];
+            cgre_heap_down(vector, heap->count, 0);
+        }
+    }
+    fail = cgre_node_set_unlock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+    }
+    return popped;
+}
+
+/**
+ * @brief Add a node to the heap
+ *
+ * @param[in] heap The Node Set to push to
+ * @param[in] node The Node to push, ordered by its key
+ * @return node or NULL on error
+ *
+ * @warning
+ * The heap keeps the slot of each member in `cgre_node.dir`, a member must
+ * not be in another collection at the same time.
+ */
+struct cgre_node* cgre_heap_push(
+        struct cgre_node_set* heap,
+        struct cgre_node* node)
+{
+    struct cgre_node* pushed = NULL;
+    cgre_int_t fail = cgre_node_set_lock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+        return NULL;
+    }
+    struct cgre_heap_vector* vector = cgre_heap_reserve(heap, 1);
+    if (vector != NULL) {
+        vector->slot[heap->count] = node;
+        cgre_heap_up(vector, heap->count);
+        heap->count++;
+        vector->store.used++;
+        pushed = node;
+    }
+    fail = cgre_node_set_unlock(heap);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(heap->state);
+    }
+    return pushed;
+}
@@ -0,0 +1,402 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/core/common.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/**
+ * @def CGRE_NODE_POOL_SLAB 1024
+ * @brief Nodes carved from each slab of a node pool
+ */
+
+/**
+ * @def CGRE_NODE_POOL_MAGAZINE 64
+ * @brief Nodes a thread moves between its magazine and the pool at once
+ *
+ * A magazine refills with up to this many nodes when empty and flushes this
+ * many back when it holds twice as many, so the pool lock is taken at most
+ * once per this many allocations or releases.
+ */
+
+/**
+ * @def CGRE_NODE_POOL_CACHES 4
+ * @brief Pools each thread keeps a magazine for
+ *
+ * A thread working with more pools than this takes over the slot of another
+ * pool, flushing the free nodes left in it back to that pool. The magazines
+ * of an exiting thread are flushed back the same way.
+ */
+
+struct cgre_node_slab {
+    struct cgre_node_store store;
+    char pad[CGRE_CACHE_LINE - sizeof(struct cgre_node_store)];
+    struct cgre_node node[];
+};
+
+struct cgre_node_magazine {
+    struct cgre_node_pool* pool;
+    cgre_uint_t sequence;
+    cgre_uint_t count;
+    struct cgre_node* free;
+};
+
+/**
+ * @brief Magazines of one thread, listed while it holds any
+ *
+ * The list lets a pool being uninitialized detach itself from the magazines
+ * of every thread, so none is flushed into it afterwards.
+ */
+struct cgre_node_magazines {
+    struct cgre_node_magazine magazine[CGRE_NODE_POOL_CACHES];
+    struct cgre_node_magazines* next;
+    struct cgre_node_magazines* prev;
+    cgre_uint_t listed;
+};
+
+static __thread struct cgre_node_magazines cgre_node_magazines;
+
+static struct cgre_node_magazines* cgre_node_pool_threads = NULL;
+
+static pthread_mutex_t cgre_node_pool_threads_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_key_t cgre_node_pool_key;
+
+static pthread_once_t cgre_node_pool_once = PTHREAD_ONCE_INIT;
+
+static cgre_uint_t cgre_node_pool_sequence = 0;
+
+/**
+ * @brief Move the nodes of a magazine past the first keep back to its pool
+ */
+static void cgre_node_pool_flush(
+        struct cgre_node_magazine* magazine,
+        cgre_uint_t keep)
+{
+    struct cgre_node_pool* pool = magazine->pool;
+    if (magazine->count <= keep) {
+        return;
+    }
+    struct cgre_node* last = NULL;
+    struct cgre_node* flush = magazine->free;
+    for (cgre_uint_t idx = 0; idx < keep; idx++) {
+        last = flush;
+        flush = flush->link[0];
+    }
+    struct cgre_node* tail = flush;
+    for (; tail->link[0] != NULL;) {
+        tail = tail->link[0];
+    }
+    // We are going to be working on this pool
+    cgre_int_t fail = pthread_mutex_lock(&(pool->lock));
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(pool->state);
+        return;
+    }
+    if (last != NULL) {
+        last->link[0] = NULL;
+    } else {
+        magazine->free = NULL;
+    }
+    magazine->count = keep;
+    tail->link[0] = pool->free;
+    pool->free = flush;
+    // We are done working on this pool
+    fail = pthread_mutex_unlock(&(pool->lock));
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(pool->state);
+    }
+}
+
+/**
+ * @brief Flush the magazines of an exiting thread back to their pools
+ */
+static void cgre_node_pool_exit(
+        void* data)
+{
+    struct cgre_node_magazines* magazines = data;
+    pthread_mutex_lock(&cgre_node_pool_threads_lock);
+    for (cgre_uint_t idx = 0; idx < CGRE_NODE_POOL_CACHES; idx++) {
+        struct cgre_node_magazine* magazine = &(magazines->magazine[idx]);
+        if (magazine->pool != NULL) {
+            cgre_node_pool_flush(magazine, 0);
+            magazine->pool = NULL;
+        }
+    }
+    if (magazines->prev != NULL) {
+        magazines->prev->next = magazines->next;
+    } else {
+        cgre_node_pool_threads = magazines->next;
+    }
+    if (magazines->next != NULL) {
+        magazines->next->prev = magazines->prev;
+    }
+    magazines->listed = 0;
+    pthread_mutex_unlock(&cgre_node_pool_threads_lock);
+}
+
+static void cgre_node_pool_key_create()
+{
+    pthread_key_create(&cgre_node_pool_key, cgre_node_pool_exit);
+}
+
+/**
+ * @brief List the magazines of this thread and have them flushed on exit
+ */
+static void cgre_node_pool_list(
+        struct cgre_node_magazines* magazines)
+{
+    pthread_once(&cgre_node_pool_once, cgre_node_pool_key_create);
+    pthread_mutex_lock(&cgre_node_pool_threads_lock);
+    magazines->prev = NULL;
+    magazines->next = cgre_node_pool_threads;
+    if (cgre_node_pool_threads != NULL) {
+        cgre_node_pool_threads->prev = magazines;
+    }
+    cgre_node_pool_threads = magazines;
+    magazines->listed = 1;
+    pthread_mutex_unlock(&cgre_node_pool_threads_lock);
+    pthread_setspecific(cgre_node_pool_key, magazines);
+}
+
+/**
+ * @brief Find the magazine of this thread for a pool, claiming one if needed
+ *
+ * Pools are told apart by their sequence as well as their address, a pool
+ * initialized where an uninitialized one was does not inherit its magazines.
+ */
+static struct cgre_node_magazine* cgre_node_pool_magazine(
+        struct cgre_node_pool* pool)
+{
+    struct cgre_node_magazine* spare = NULL;
+    for (cgre_uint_t idx = 0; idx < CGRE_NODE_POOL_CACHES; idx++) {
+        struct cgre_node_magazine* magazine =
+            &(cgre_node_magazines.magazine[idx]);
+        if (magazine->pool == pool && magazine->sequence == pool->sequence) {
+            return magazine;
+        }
+        if (spare == NULL && magazine->pool == NULL) {
+            spare = magazine;
+        }
+    }
+    if (spare == NULL) {
+        spare = &(cgre_node_magazines.magazine[
+                pool->sequence % CGRE_NODE_POOL_CACHES]);
+        cgre_node_pool_flush(spare, 0);
+    }
+    if (!cgre_node_magazines.listed) {
+        cgre_node_pool_list(&cgre_node_magazines);
+    }
+    spare->pool = pool;
+    spare->sequence = pool->sequence;
+    spare->count = 0;
+    spare->free = NULL;
+    return spare;
+}
+
+/**
+ * @brief Move free nodes from the pool to an empty magazine
+ *
+ * Nodes flushed back by threads are taken first, then fresh ones are carved
+ * from the newest slab, starting a new slab when it is used up.
+ */
+static cgre_uint_t cgre_node_pool_refill(
+        struct cgre_node_pool* pool,
+        struct cgre_node_magazine* magazine)
+{
+    // We are going to be working on this pool
+    cgre_int_t fail = pthread_mutex_lock(&(pool->lock));
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(pool->state);
+        return 0;
+    }
+    for (; magazine->count < CGRE_NODE_POOL_MAGAZINE && pool->free != NULL;) {
+        struct cgre_node* node = pool->free;
+        pool->free = node->link[0];
+        node->link[0] = magazine->free;
+        magazine->free = node;
+        magazine->count++;
+    }
+    if (magazine->count == 0) {
+        struct cgre_node_slab* slab = (struct cgre_node_slab*) pool->store;
+        if (slab == NULL || slab->store.used == slab->store.size) {
+            if (posix_memalign((void**) &slab, CGRE_CACHE_LINE,
+                    sizeof(struct cgre_node_slab) +
+                    sizeof(struct cgre_node) * CGRE_NODE_POOL_SLAB)) {
+                slab = NULL;
+            } else {
+                slab->store.next = pool->store;
+                slab->store.size = CGRE_NODE_POOL_SLAB;
+                slab->store.used = 0;
+                pool->store = (struct cgre_node_store*) slab;
+            }
+        }
+        // Carve backwards so the magazine hands nodes out in address order
+        cgre_uint_t first = slab == NULL ? 0 : slab->store.used;
+        cgre_uint_t last = slab == NULL ? 0 : slab->store.size;
+        if (last - first > CGRE_NODE_POOL_MAGAZINE) {
+            last = first + CGRE_NODE_POOL_MAGAZINE;
+        }
+        for (cgre_uint_t idx = last; idx > first; idx--) {
+            slab->node[idx - 1].link[0] = magazine->free;
+            magazine->free = &(slab->node[idx - 1]);
+            magazine->count++;
+        }
+        if (slab != NULL) {
+            slab->store.used = last;
+        }
+    }
+    // We are done working on this pool
+    fail = pthread_mutex_unlock(&(pool->lock));
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(pool->state);
+    }
+    return magazine->count;
+}
+
+/**
+ * @brief Allocate an initialized node from a pool
+ *
+ * @param[in] pool The Node Pool to allocate from
+ * @param[in] key Key to set for Node
+ * @param[in] value Node value pointer
+ * @return cgre_node pointer or NULL if error
+ */
+struct cgre_node* cgre_node_pool_alloc(
+        struct cgre_node_pool* pool,
+        cgre_uint_t key,
+        void* value)
+{
+    struct cgre_node_magazine* magazine = cgre_node_pool_magazine(pool);
+    if (magazine->free == NULL && cgre_node_pool_refill(pool, magazine) == 0) {
+        return NULL;
+    }
+    struct cgre_node* node = magazine->free;
+    magazine->free = node->link[0];
+    magazine->count--;
+    return cgre_node_initialize(node, key, value);
+}
+
+/**
+ * @brief Return a node to its pool
+ *
+ * @param[in] pool The Node Pool the node was allocated from
+ * @param[in] node Node to release, no longer a member of any collection
+ */
+void cgre_node_pool_free(
+        struct cgre_node_pool* pool,
+        struct cgre_node* node)
+{
+    struct cgre_node_magazine* magazine = cgre_node_pool_magazine(pool);
+    node->link[0] = magazine->free;
+    magazine->free = node;
+    if (++(magazine->count) < 2 * CGRE_NODE_POOL_MAGAZINE) {
+        return;
+    }
+    // Keep the most recently freed half, they are the warmest
+    cgre_node_pool_flush(magazine, CGRE_NODE_POOL_MAGAZINE);
+}
+
+/**
+ * @brief Initialize a Node Pool
+ *
+ * @param[in] pool The Node Pool to initialize
+ * @return pool or NULL on error
+ *
+ * @code{.c}
+ * cgre_node_pool_initialize(&pool);
+ * cgre_tree_insert(&tree, cgre_node_pool_alloc(&pool, key, value));
+ * ...
+ * cgre_node_set_uninitialize(&tree);
+ * cgre_node_pool_uninitialize(&pool);
+ * @endcode
+ */
+struct cgre_node_pool* cgre_node_pool_initialize(
+        struct cgre_node_pool* pool)
+{
+    pool->store = NULL;
+    pool->free = NULL;
+    pool->state = 0;
+    // Sequence 0 is never used, it marks an uninitialized pool
+    do {
+        pool->sequence = __atomic_add_fetch(&cgre_node_pool_sequence, 1,
+                __ATOMIC_RELAXED);
+    } while (pool->sequence == 0);
+    if (pthread_mutex_init(&(pool->lock), NULL) != 0) {
+        CGRE_NODES_LOCK_SET_FAIL(pool->state);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * @brief Uninitialize a Node Pool
+ *
+ * Releases every slab at once, including the nodes still held by
+ * collections or by the magazines of other threads.
+ *
+ * @param[in] pool The Node Pool to uninitialize
+ * @return pool or NULL on error
+ *
+ * @warning
+ * No node of the pool may be used afterwards. Uninitialize the sets holding
+ * them first, there is no need to free their members one by one.
+ */
+struct cgre_node_pool* cgre_node_pool_uninitialize(
+        struct cgre_node_pool* pool)
+{
+    // No thread may flush into the pool once it is gone
+    pthread_mutex_lock(&cgre_node_pool_threads_lock);
+    for (struct cgre_node_magazines* magazines = cgre_node_pool_threads;
+            magazines != NULL; magazines = magazines->next) {
+        for (cgre_uint_t idx = 0; idx < CGRE_NODE_POOL_CACHES; idx++) {
+            if (magazines->magazine[idx].pool == pool) {
+                magazines->magazine[idx].pool = NULL;
+            }
+        }
+    }
+    pthread_mutex_unlock(&cgre_node_pool_threads_lock);
+    cgre_int_t fail = pthread_mutex_destroy(&(pool->lock));
+    for (struct cgre_node_store* block = pool->store; block != NULL;) {
+        struct cgre_node_store* next = block->next;
+        free(block);
+        block = next;
+    }
+    pool->store = NULL;
+    pool->free = NULL;
+    pool->state = 0;
+    pool->sequence = 0;
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(pool->state);
+        return NULL;
+    }
+    return pool;
+}
@@ -30,17 +30,374 @@ SOFTWARE.
 
 #include <cgre/core/set.h>
 
+#include <stdlib.h>
+
+/**
+ * @def CGRE_QUEUE_LOCKED 1
+ * @brief Linked mode of the queue
+ *
+ * Members are chained through their links and every operation holds the set
+ * lock.
+ */
+
+/**
+ * @def CGRE_QUEUE_RING 2
+ * @brief Lock-free ring mode of the queue
+ *
+ * Members are held in a bounded ring of node pointers owned by the set. Any
+ * number of threads may push and pop without taking the set lock, each cell
+ * carries a sequence number telling producers and consumers whose turn it
+ * is. Member links are left untouched. Selected with `cgre_queue_reserve()`.
+ *
+ * @remark
+ * `cgre_node_set.count` is not maintained in this mode, counting would put
+ * every thread back on a single cache line.
+ */
+
+/**
+ * @def CGRE_QUEUE_SPSC 3
+ * @brief Single producer, single consumer ring mode of the queue
+ *
+ * Members are held in a bounded ring of node pointers owned by the set. One
+ * thread may push while one other thread pops, neither takes a lock or
+ * writes to the other's cache line unless the ring looks full or empty.
+ * Nothing is allocated after `cgre_queue_reserve()`, until then the queue
+ * behaves as `CGRE_QUEUE_LOCKED`.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&queue);
+ * CGRE_NODES_MODE_SET_VALUE(queue.state, CGRE_QUEUE_SPSC);
+ * cgre_queue_reserve(&queue, 1024);
+ * @endcode
+ *
+ * @remark
+ * `cgre_node_set.count` is not maintained in this mode.
+ */
+
+/**
+ * @def CGRE_QUEUE_MODE(N)
+ * @brief Compute the effective mode of a queue from its state
+ */
+
+struct cgre_queue_cell {
+    cgre_uintptr_t sequence;
+    struct cgre_node* node;
+};
+
+struct cgre_queue_ring {
+    struct cgre_node_store store;
+    char pad0[CGRE_CACHE_LINE];
+    cgre_uintptr_t enqueue;
+    char pad1[CGRE_CACHE_LINE - sizeof(cgre_uintptr_t)];
+    cgre_uintptr_t dequeue;
+    char pad2[CGRE_CACHE_LINE - sizeof(cgre_uintptr_t)];
+    struct cgre_queue_cell cell[];
+};
+
+/**
+ * @brief Single producer, single consumer ring held in the set store
+ *
+ * Each side owns a cache line holding its own position and its last look at
+ * the other side's, and only reads the other line once the cached position
+ * says the ring is full or empty.
+ */
+struct cgre_queue_spsc {
+    struct cgre_node_store store;
+    char pad0[CGRE_CACHE_LINE];
+    cgre_uintptr_t enqueue;
+    cgre_uintptr_t dequeue_seen;
+    char pad1[CGRE_CACHE_LINE - 2 * sizeof(cgre_uintptr_t)];
+    cgre_uintptr_t dequeue;
+    cgre_uintptr_t enqueue_seen;
+    char pad2[CGRE_CACHE_LINE - 2 * sizeof(cgre_uintptr_t)];
+    struct cgre_node* slot[];
+};
+
+/**
+ * @brief Push onto the queue ring
+ *
+ * @return node or NULL when the ring is full
+ */
+static struct cgre_node* cgre_queue_ring_push(
+        struct cgre_queue_ring* ring,
+        struct cgre_node* node)
+{
+    cgre_uintptr_t mask = ring->store.size - 1;
+    cgre_uintptr_t position = __atomic_load_n(&(ring->enqueue),
+            __ATOMIC_RELAXED);
+    struct cgre_queue_cell* cell;
+    for (;;) {
+        cell = &(ring->cell[position & mask]);
+        cgre_uintptr_t sequence = __atomic_load_n(&(cell->sequence),
+                __ATOMIC_ACQUIRE);
+        cgre_intptr_t turn = (cgre_intptr_t) (sequence - position);
+        // Is the cell free for this lap?
+        if (turn == 0) {
+            // Yes. Claim it
+            if (__atomic_compare_exchange_n(&(ring->enqueue), &position,
+                        position + 1, 1, __ATOMIC_RELAXED,
+                        __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (turn < 0) {
+            // No. Last lap was not consumed yet, we are full
+            return NULL;
+        } else {
+            // Someone else claimed it, catch up
+            position = __atomic_load_n(&(ring->enqueue), __ATOMIC_RELAXED);
+        }
+    }
+    __atomic_store_n(&(cell->node), node, __ATOMIC_RELAXED);
+    // Hand the cell to consumers
+    __atomic_store_n(&(cell->sequence), position + 1, __ATOMIC_RELEASE);
+    return node;
+}
+
+/**
+ * @brief Pop from the queue ring
+ *
+ * @return node or NULL when the ring is empty
+ */
+static struct cgre_node* cgre_queue_ring_pop(
+        struct cgre_queue_ring* ring)
+{
+    cgre_uintptr_t mask = ring->store.size - 1;
+    cgre_uintptr_t position = __atomic_load_n(&(ring->dequeue),
+            __ATOMIC_RELAXED);
+    struct cgre_queue_cell* cell;
+    for (;;) {
+        cell = &(ring->cell[position & mask]);
+        cgre_uintptr_t sequence = __atomic_load_n(&(cell->sequence),
+                __ATOMIC_ACQUIRE);
+        cgre_intptr_t turn = (cgre_intptr_t) (sequence - (position + 1));
+        // Has the cell been filled for this lap?
+        if (turn == 0) {
+            // Yes. Claim it
+            if (__atomic_compare_exchange_n(&(ring->dequeue), &position,
+                        position + 1, 1, __ATOMIC_RELAXED,
+                        __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (turn < 0) {
+            // No. We are empty
+            return NULL;
+        } else {
+            // Someone else claimed it, catch up
+            position = __atomic_load_n(&(ring->dequeue), __ATOMIC_RELAXED);
+        }
+    }
+    struct cgre_node* popped = __atomic_load_n(&(cell->node),
+            __ATOMIC_RELAXED);
+    // Hand the cell to producers for the next lap
+    __atomic_store_n(&(cell->sequence), position + mask + 1,
+            __ATOMIC_RELEASE);
+    return popped;
+}
+
+/**
+ * @brief Peek at the queue ring
+ *
+ * @return node or NULL when the ring is empty
+ */
+static struct cgre_node* cgre_queue_ring_peek(
+        struct cgre_queue_ring* ring)
+{
+    cgre_uintptr_t position = __atomic_load_n(&(ring->dequeue),
+            __ATOMIC_ACQUIRE);
+    struct cgre_queue_cell* cell =
+        &(ring->cell[position & (ring->store.size - 1)]);
+    if (__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) !=
+            position + 1) {
+        return NULL;
+    }
+    return __atomic_load_n(&(cell->node), __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Push a run of nodes onto the queue ring
+ *
+ * Claims as many free cells as it can with a single exchange.
+ *
+ * @return number of nodes pushed, 0 when the ring is full
+ */
+static cgre_uint_t cgre_queue_ring_push_many(
+        struct cgre_queue_ring* ring,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    cgre_uintptr_t mask = ring->store.size - 1;
+    cgre_uintptr_t position = __atomic_load_n(&(ring->enqueue),
+            __ATOMIC_RELAXED);
+    cgre_uint_t claimed;
+    for (;;) {
+        // Count the cells free for this lap from our position
+        for (claimed = 0; claimed < count && claimed <= mask; claimed++) {
+            if (__atomic_load_n(
+                        &(ring->cell[(position + claimed) & mask].sequence),
+                        __ATOMIC_ACQUIRE) != position + claimed) {
+                break;
+            }
+        }
+        if (claimed == 0) {
+            cgre_intptr_t turn = (cgre_intptr_t) (__atomic_load_n(
+                        &(ring->cell[position & mask].sequence),
+                        __ATOMIC_ACQUIRE) - position);
+            // Last lap was not consumed yet, we are full
+            if (turn < 0) {
+                return 0;
+            }
+            // Someone else claimed it, catch up
+            position = __atomic_load_n(&(ring->enqueue), __ATOMIC_RELAXED);
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&(ring->enqueue), &position,
+                    position + claimed, 1, __ATOMIC_RELAXED,
+                    __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    for (cgre_uint_t idx = 0; idx < claimed; idx++) {
+        struct cgre_queue_cell* cell = &(ring->cell[(position + idx) & mask]);
+        __atomic_store_n(&(cell->node), nodes[idx], __ATOMIC_RELAXED);
+        // Hand the cell to consumers
+        __atomic_store_n(&(cell->sequence), position + idx + 1,
+                __ATOMIC_RELEASE);
+    }
+    return claimed;
+}
+
+/**
+ * @brief Push a run of nodes onto the single producer ring
+ *
+ * Publishes the whole run with a single store.
+ *
+ * @return number of nodes pushed, 0 when the ring is full
+ */
+static cgre_uint_t cgre_queue_spsc_push_many(
+        struct cgre_queue_spsc* ring,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    cgre_uintptr_t size = ring->store.size;
+    cgre_uintptr_t position = ring->enqueue;
+    // Only look at the consumer when the ring seems too full
+    if (size - (position - ring->dequeue_seen) < count) {
+        ring->dequeue_seen = __atomic_load_n(&(ring->dequeue),
+                __ATOMIC_ACQUIRE);
+    }
+    cgre_uintptr_t room = size - (position - ring->dequeue_seen);
+    if (count > room) {
+        count = room;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        ring->slot[(position + idx) & (size - 1)] = nodes[idx];
+    }
+    // Hand the run to the consumer
+    __atomic_store_n(&(ring->enqueue), position + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+/**
+ * @brief Pop a run of nodes from the single consumer ring
+ *
+ * Releases the whole run with a single store.
+ *
+ * @return number of nodes popped, 0 when the ring is empty
+ */
+static cgre_uint_t cgre_queue_spsc_pop_many(
+        struct cgre_queue_spsc* ring,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    cgre_uintptr_t position = ring->dequeue;
+    // Only look at the producer when the ring seems too empty
+    if (ring->enqueue_seen - position < count) {
+        ring->enqueue_seen = __atomic_load_n(&(ring->enqueue),
+                __ATOMIC_ACQUIRE);
+    }
+    cgre_uintptr_t ready = ring->enqueue_seen - position;
+    if (count > ready) {
+        count = ready;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        nodes[idx] = ring->slot[(position + idx) & (ring->store.size - 1)];
+    }
+    // Hand the slots back to the producer
+    __atomic_store_n(&(ring->dequeue), position + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+/**
+ * @brief Peek at the single consumer ring
+ *
+ * @return node or NULL when the ring is empty
+ */
+static struct cgre_node* cgre_queue_spsc_peek(
+        struct cgre_queue_spsc* ring)
+{
+    cgre_uintptr_t position = ring->dequeue;
+    if (ring->enqueue_seen == position) {
+        ring->enqueue_seen = __atomic_load_n(&(ring->enqueue),
+                __ATOMIC_ACQUIRE);
+        if (ring->enqueue_seen == position) {
+            return NULL;
+        }
+    }
+    return ring->slot[position & (ring->store.size - 1)];
+}
+
+/**
+ * @brief Unlink the oldest member of a linked queue
+ *
+ * The queue lock must be held.
+ *
+ * @return node or NULL on empty
+ */
+static struct cgre_node* cgre_queue_list_pop(
+        struct cgre_node_set* queue)
+{
+    struct cgre_node* popped = NULL;
+    // Is there a queue?
+    if (queue->link[CGRE_NODE_TAIL] != NULL) {
+        popped = queue->link[CGRE_NODE_TAIL];
+        // Yes, is it the only item?
+        if ((cgre_intptr_t) queue->link[CGRE_NODE_HEAD] ^
+                (cgre_intptr_t) queue->link[CGRE_NODE_TAIL]) {
+            // No. We need to patch the chain
+            popped->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] = NULL;
+            queue->link[CGRE_NODE_TAIL] = popped->link[CGRE_NODE_HEAD];
+        } else {
+            // Queue is now empty
+            queue->link[CGRE_NODE_HEAD] = NULL;
+            queue->link[CGRE_NODE_TAIL] = NULL;
+        }
+        queue->count--;
+    }
+    return popped;
+}
+
 /**
  * @brief Queue list push
  *
  * @param[in] queue The Node Set to push to
  * @param[in] node The Node to push
+ * @return node or NULL on error or full ring
  */
 struct cgre_node* cgre_queue_push(
         struct cgre_node_set* queue,
         struct cgre_node* node)
 {
-    cgre_int_t fail = pthread_mutex_lock(&(queue->lock));
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_RING) {
+        return cgre_queue_ring_push(
+                (struct cgre_queue_ring*) queue->store, node);
+    }
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_SPSC &&
+            queue->store != NULL) {
+        return cgre_queue_spsc_push_many(
+                (struct cgre_queue_spsc*) queue->store, &node, 1) ?
+            node : NULL;
+    }
+    cgre_int_t fail = cgre_node_set_lock(queue);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(queue->state);
         return NULL;
@@ -57,13 +414,73 @@ struct cgre_node* cgre_queue_push(
         queue->link[CGRE_NODE_HEAD] = node;
     }
     queue->count++;
-    fail = pthread_mutex_unlock(&(queue->lock));
+    fail = cgre_node_set_unlock(queue);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(queue->state);
     }
     return node;
 }
 
+/**
+ * @brief Queue list push of many nodes under one lock
+ *
+ * @param[in] queue The Node Set to push to
+ * @param[in] nodes The Nodes to push in order
+ * @param[in] count Number of nodes
+ * @return number of nodes pushed, fewer than count on error or full ring
+ */
+cgre_uint_t cgre_queue_push_many(
+        struct cgre_node_set* queue,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    cgre_uint_t pushed = 0;
+    if (queue == NULL || nodes == NULL) {
+        return 0;
+    }
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_RING) {
+        while (pushed < count) {
+            cgre_uint_t run = cgre_queue_ring_push_many(
+                    (struct cgre_queue_ring*) queue->store, &(nodes[pushed]),
+                    count - pushed);
+            if (run == 0) {
+                break;
+            }
+            pushed += run;
+        }
+        return pushed;
+    }
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_SPSC &&
+            queue->store != NULL) {
+        return cgre_queue_spsc_push_many(
+                (struct cgre_queue_spsc*) queue->store, nodes, count);
+    }
+    cgre_int_t fail = cgre_node_set_lock(queue);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(queue->state);
+        return 0;
+    }
+    for (; pushed < count; pushed++) {
+        struct cgre_node* node = nodes[pushed];
+        // Is the list empty?
+        if (queue->link[CGRE_NODE_HEAD] != NULL) {
+            // No, need to push the reference down
+            queue->link[CGRE_NODE_HEAD]->link[CGRE_NODE_HEAD] = node;
+            node->link[CGRE_NODE_TAIL] = queue->link[CGRE_NODE_HEAD];
+            queue->link[CGRE_NODE_HEAD] = node;
+        } else {
+            queue->link[CGRE_NODE_TAIL] = node;
+            queue->link[CGRE_NODE_HEAD] = node;
+        }
+    }
+    queue->count += pushed;
+    fail = cgre_node_set_unlock(queue);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(queue->state);
+    }
+    return pushed;
+}
+
 /**
  * @brief Queue list pop
  *
@@ -77,29 +494,73 @@ struct cgre_node* cgre_queue_push(
 struct cgre_node* cgre_queue_pop(
         struct cgre_node_set* queue)
 {
-    struct cgre_node* popped = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(queue->lock));
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_RING) {
+        return cgre_queue_ring_pop((struct cgre_queue_ring*) queue->store);
+    }
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_SPSC &&
+            queue->store != NULL) {
+        struct cgre_node* popped = NULL;
+        cgre_queue_spsc_pop_many((struct cgre_queue_spsc*) queue->store,
+                &popped, 1);
+        return popped;
+    }
+    cgre_int_t fail = cgre_node_set_lock(queue);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(queue->state);
         return NULL;
     }
-    // Is there a queue?
-    if (queue->link[CGRE_NODE_TAIL] != NULL) {
-        popped = queue->link[CGRE_NODE_TAIL];
-        // Yes, is it the only item?
-        if ((cgre_intptr_t) queue->link[CGRE_NODE_HEAD] ^
-                (cgre_intptr_t) queue->link[CGRE_NODE_TAIL]) {
-            // No. We need to patch the chain
-            popped->link[CGRE_NODE_HEAD]->link[CGRE_NODE_TAIL] = NULL;
-            queue->link[CGRE_NODE_TAIL] = popped->link[CGRE_NODE_HEAD];
-        } else {
-            // Queue is now empty
-            queue->link[CGRE_NODE_HEAD] = NULL;
-            queue->link[CGRE_NODE_TAIL] = NULL;
+    struct cgre_node* popped = cgre_queue_list_pop(queue);
+    fail = cgre_node_set_unlock(queue);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(queue->state);
+    }
+    return popped;
+}
+
+/**
+ * @brief Queue list pop of many nodes under one lock
+ *
+ * @param[in] queue The Node Set to pop from
+ * @param[out] nodes Receives the popped Nodes in order
+ * @param[in] count Most nodes to pop
+ * @return number of nodes popped, fewer than count on empty or error
+ */
+cgre_uint_t cgre_queue_pop_many(
+        struct cgre_node_set* queue,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    cgre_uint_t popped = 0;
+    if (queue == NULL || nodes == NULL) {
+        return 0;
+    }
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_RING) {
+        for (; popped < count; popped++) {
+            nodes[popped] = cgre_queue_ring_pop(
+                    (struct cgre_queue_ring*) queue->store);
+            if (nodes[popped] == NULL) {
+                break;
+            }
         }
-        queue->count--;
+        return popped;
+    }
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_SPSC &&
+            queue->store != NULL) {
+        return cgre_queue_spsc_pop_many(
+                (struct cgre_queue_spsc*) queue->store, nodes, count);
     }
-    fail = pthread_mutex_unlock(&(queue->lock));
+    cgre_int_t fail = cgre_node_set_lock(queue);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(queue->state);
+        return 0;
+    }
+    for (; popped < count; popped++) {
+        nodes[popped] = cgre_queue_list_pop(queue);
+        if (nodes[popped] == NULL) {
+            break;
+        }
+    }
+    fail = cgre_node_set_unlock(queue);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(queue->state);
     }
@@ -107,15 +568,23 @@ struct cgre_node* cgre_queue_pop(
 }
 
 /**
- * @brief Get the next item on the queue with removing it
+ * @brief Get the next item on the queue without removing it
  *
  * @param[in] queue The Node Set to peek on
+ * @return node or NULL on empty or error
  */
 struct cgre_node* cgre_queue_peek(
         struct cgre_node_set* queue)
 {
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_RING) {
+        return cgre_queue_ring_peek((struct cgre_queue_ring*) queue->store);
+    }
+    if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_SPSC &&
+            queue->store != NULL) {
+        return cgre_queue_spsc_peek((struct cgre_queue_spsc*) queue->store);
+    }
     struct cgre_node* peek = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(queue->lock));
+    cgre_int_t fail = cgre_node_set_lock(queue);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(queue->state);
         return NULL;
@@ -125,9 +594,86 @@ struct cgre_node* cgre_queue_peek(
         // We are in business. Grab it and go
         peek = queue->link[CGRE_NODE_TAIL];
     }
-    fail = pthread_mutex_unlock(&(queue->lock));
+    fail = cgre_node_set_unlock(queue);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(queue->state);
     }
     return peek;
 }
+
+/**
+ * @brief Switch a queue to the lock-free ring mode
+ *
+ * A queue already set to `CGRE_QUEUE_SPSC` gets a single producer, single
+ * consumer ring instead. When no ring can be set up the queue is put back to
+ * `CGRE_QUEUE_LOCKED`.
+ *
+ * @param[in] queue The empty Node Set to switch
+ * @param[in] size Ring capacity, rounded up to a power of 2
+ * @return queue or NULL on error or a non empty queue
+ *
+ * @warning
+ * The queue must not be shared with other threads until this returns, nor
+ * used at all in `CGRE_QUEUE_SPSC` mode before it. Once the ring is full,
+ * `cgre_queue_push()` returns NULL until a member is popped.
+ */
+struct cgre_node_set* cgre_queue_reserve(
+        struct cgre_node_set* queue,
+        cgre_uint_t size)
+{
+    struct cgre_node_set* reserved = NULL;
+    cgre_int_t fail = cgre_node_set_lock(queue);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(queue->state);
+        return NULL;
+    }
+    // Only an empty queue can be switched
+    if (queue->count == 0 && queue->store == NULL && size > 0) {
+        cgre_uint_t capacity = 2;
+        while (capacity < size) {
+            capacity <<= 1;
+        }
+        struct cgre_queue_ring* ring = NULL;
+        struct cgre_queue_spsc* spsc = NULL;
+        if (CGRE_QUEUE_MODE(queue->state) == CGRE_QUEUE_SPSC) {
+            if (posix_memalign((void**) &spsc, CGRE_CACHE_LINE,
+                        sizeof(struct cgre_queue_spsc) +
+                        sizeof(struct cgre_node*) * capacity) == 0) {
+                spsc->store.next = NULL;
+                spsc->store.size = capacity;
+                spsc->store.used = 0;
+                spsc->enqueue = 0;
+                spsc->dequeue_seen = 0;
+                spsc->dequeue = 0;
+                spsc->enqueue_seen = 0;
+                queue->store = (struct cgre_node_store*) spsc;
+                reserved = queue;
+            }
+        } else if (posix_memalign((void**) &ring, CGRE_CACHE_LINE,
+                    sizeof(struct cgre_queue_ring) +
+                    sizeof(struct cgre_queue_cell) * capacity) == 0) {
+            ring->store.next = NULL;
+            ring->store.size = capacity;
+            ring->store.used = 0;
+            ring->enqueue = 0;
+            ring->dequeue = 0;
+            for (cgre_uint_t idx = 0; idx < capacity; idx++) {
+                ring->cell[idx].sequence = idx;
+                ring->cell[idx].node = NULL;
+            }
+            queue->store = (struct cgre_node_store*) ring;
+            CGRE_NODES_MODE_SET_VALUE(queue->state, CGRE_QUEUE_RING);
+            reserved = queue;
+        }
+    }
+    // A queue left without a ring stays usable as a locked queue
+    if (queue->store == NULL) {
+        CGRE_NODES_MODE_SET_VALUE(queue->state, CGRE_QUEUE_LOCKED);
+    }
+    fail = cgre_node_set_unlock(queue);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(queue->state);
+        return NULL;
+    }
+    return reserved;
+}
@@ -0,0 +1,224 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/core/set.h>
+
+#include <stdlib.h>
+
+/**
+ * @def CGRE_SHARD_MAP_SIZE 64
+ * @brief Shard count of a sharded map initialized with a size of 0
+ *
+ * Pick a few times the number of threads expected to share the map, so two
+ * of them seldom land on the same shard at once.
+ */
+
+/**
+ * @brief A shard, padded so no two shard locks share a cache line
+ */
+struct cgre_shard {
+    struct cgre_node_set set;
+} __attribute__((aligned(CGRE_CACHE_LINE)));
+
+/**
+ * @brief Find the shard holding a key
+ *
+ * The shard tables mask the low bits of the mixed key, so the shard is taken
+ * from the high bits to keep the two choices independent.
+ */
+static inline struct cgre_node_set* cgre_shard_map_pick(
+        struct cgre_shard_map* map,
+        cgre_uint_t key)
+{
+    uint64_t mixed = (uint64_t) key;
+    mixed ^= mixed >> 33;
+    mixed *= UINT64_C(0xff51afd7ed558ccd);
+    mixed ^= mixed >> 33;
+    mixed *= UINT64_C(0xc4ceb9fe1a85ec53);
+    mixed ^= mixed >> 33;
+    return &(map->shard[(cgre_uint_t) (mixed >> 32) & (map->size - 1)].set);
+}
+
+/**
+ * @brief Carry a lock failure of a shard over to the map
+ */
+static inline struct cgre_node* cgre_shard_map_check(
+        struct cgre_shard_map* map,
+        struct cgre_node_set* shard,
+        struct cgre_node* node)
+{
+    if (CGRE_NODES_LOCK(shard->state)) {
+        __atomic_fetch_or(&(map->state), CGRE_NODES_LOCK_FAIL,
+                __ATOMIC_RELAXED);
+    }
+    return node;
+}
+
+/**
+ * @brief Delete a node from the map
+ *
+ * @param[in] map The Sharded Map to operate on
+ * @param[in] key Key of the node to delete
+ * @return node deleted or NULL on not found or error
+ */
+struct cgre_node* cgre_shard_map_delete(
+        struct cgre_shard_map* map,
+        cgre_uint_t key)
+{
+    struct cgre_node_set* shard = cgre_shard_map_pick(map, key);
+    return cgre_shard_map_check(map, shard,
+            cgre_hash_list_delete(shard, key));
+}
+
+/**
+ * @brief Initialize a Sharded Map
+ *
+ * @param[in] map The Sharded Map to initialize
+ * @param[in] size Number of shards, rounded up to a power of 2, or 0 for
+ * `CGRE_SHARD_MAP_SIZE`
+ * @return map or NULL on error
+ *
+ * @code{.c}
+ * struct cgre_shard_map registry;
+ * cgre_shard_map_initialize(&registry, 0);
+ * cgre_shard_map_insert(&registry, &node);
+ * @endcode
+ */
+struct cgre_shard_map* cgre_shard_map_initialize(
+        struct cgre_shard_map* map,
+        cgre_uint_t size)
+{
+    cgre_uint_t shards = 1;
+    map->shard = NULL;
+    map->size = 0;
+    map->state = 0;
+    if (size == 0) {
+        size = CGRE_SHARD_MAP_SIZE;
+    }
+    for (; shards < size && shards <= (CGRE_UINT_MAX >> 1);) {
+        shards <<= 1;
+    }
+    struct cgre_shard* shard = NULL;
+    if (posix_memalign((void**) &shard, CGRE_CACHE_LINE,
+            sizeof(struct cgre_shard) * shards)) {
+        CGRE_NODES_LOCK_SET_FAIL(map->state);
+        return NULL;
+    }
+    for (cgre_uint_t idx = 0; idx < shards; idx++) {
+        if (cgre_node_set_initialize(&(shard[idx].set)) == NULL) {
+            for (; idx > 0; idx--) {
+                cgre_node_set_uninitialize(&(shard[idx - 1].set));
+            }
+            free(shard);
+            CGRE_NODES_LOCK_SET_FAIL(map->state);
+            return NULL;
+        }
+        CGRE_NODES_MODE_SET_VALUE(shard[idx].set.state, CGRE_HASH_LIST_TABLE);
+    }
+    map->shard = shard;
+    map->size = shards;
+    return map;
+}
+
+/**
+ * @brief Insert a node into the map
+ *
+ * @param[in] map The Sharded Map to operate on
+ * @param[in] node A node to insert
+ * @return node inserted or NULL on duplicate key or error
+ */
+struct cgre_node* cgre_shard_map_insert(
+        struct cgre_shard_map* map,
+        struct cgre_node* node)
+{
+    struct cgre_node_set* shard = cgre_shard_map_pick(map, node->key);
+    return cgre_shard_map_check(map, shard,
+            cgre_hash_list_insert(shard, node));
+}
+
+/**
+ * @brief Replace a node in the map
+ *
+ * @param[in] map The Sharded Map to operate on
+ * @param[in] node A node to replace
+ * @return found node or NULL on not found or error
+ */
+struct cgre_node* cgre_shard_map_replace(
+        struct cgre_shard_map* map,
+        struct cgre_node* node)
+{
+    struct cgre_node_set* shard = cgre_shard_map_pick(map, node->key);
+    return cgre_shard_map_check(map, shard,
+            cgre_hash_list_replace(shard, node));
+}
+
+/**
+ * @brief Search the map for a key
+ *
+ * @param[in] map The Sharded Map to operate on
+ * @param[in] key Key to search for
+ * @return found node or NULL on not found or error
+ */
+struct cgre_node* cgre_shard_map_search(
+        struct cgre_shard_map* map,
+        cgre_uint_t key)
+{
+    struct cgre_node_set* shard = cgre_shard_map_pick(map, key);
+    return cgre_shard_map_check(map, shard,
+            cgre_hash_list_search(shard, key));
+}
+
+/**
+ * @brief Uninitialize a Sharded Map
+ *
+ * @param[in] map The Sharded Map to uninitialize
+ * @return map or NULL on error
+ *
+ * @warning
+ * There must be no current operations on the map. The member nodes are left
+ * to the caller.
+ */
+struct cgre_shard_map* cgre_shard_map_uninitialize(
+        struct cgre_shard_map* map)
+{
+    cgre_uint_t fail = 0;
+    for (cgre_uint_t idx = 0; idx < map->size; idx++) {
+        fail |= cgre_node_set_uninitialize(&(map->shard[idx].set)) == NULL;
+    }
+    free(map->shard);
+    map->shard = NULL;
+    map->size = 0;
+    map->state = 0;
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(map->state);
+        return NULL;
+    }
+    return map;
+}
@@ -30,6 +30,114 @@ SOFTWARE.
 
 #include <cgre/core/set.h>
 
+/**
+ * @def CGRE_STACK_LOCKED 1
+ * @brief Locked mode of the stack
+ *
+ * Every operation holds the set lock and members are doubly linked.
+ */
+
+/**
+ * @def CGRE_STACK_TREIBER 2
+ * @brief Lock-free mode of the stack
+ *
+ * Push and pop swing the top of the stack with a compare and swap, without
+ * the set lock, and only the forward `link[CGRE_NODE_TAIL]` of members is
+ * written. The top is kept in `link[CGRE_NODE_HEAD]` of the set tagged with
+ * a counter in the upper 16 bits, bumped on every change, so a member popped
+ * and pushed back between another thread's read and swap cannot be mistaken
+ * for an unchanged top (ABA).
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&free_list);
+ * CGRE_NODES_MODE_SET_VALUE(free_list.state, CGRE_STACK_TREIBER);
+ * @endcode
+ *
+ * @remark
+ * `cgre_node_set.count` is not maintained in this mode.
+ *
+ * @warning
+ * A popping thread may still read the next link of a member another thread
+ * just popped, so members must stay addressable while the stack is shared.
+ * This holds for free lists, whose members are never released. Platforms
+ * without spare pointer bits use the locked mode.
+ */
+
+/**
+ * @def CGRE_STACK_MODE(N)
+ * @brief Compute the effective mode of a stack from its state
+ */
+
+#if UINTPTR_MAX > 0xFFFFFFFFu
+
+#define CGRE_STACK_TAG_SHIFT 48
+#define CGRE_STACK_TOP(T) ((struct cgre_node*) ((cgre_uintptr_t) (T) & \
+            ((((cgre_uintptr_t) 1) << CGRE_STACK_TAG_SHIFT) - 1)))
+#define CGRE_STACK_TAGGED(N, T) ((struct cgre_node*) ((cgre_uintptr_t) (N) | \
+            ((((cgre_uintptr_t) (T) >> CGRE_STACK_TAG_SHIFT) + 1) << \
+             CGRE_STACK_TAG_SHIFT)))
+
+/**
+ * @brief Push onto the lock-free stack
+ */
+static struct cgre_node* cgre_stack_treiber_push(
+        struct cgre_node_set* stack,
+        struct cgre_node* node)
+{
+    struct cgre_node* top = __atomic_load_n(&(stack->link[CGRE_NODE_HEAD]),
+            __ATOMIC_RELAXED);
+    do {
+        __atomic_store_n(&(node->link[CGRE_NODE_TAIL]), CGRE_STACK_TOP(top),
+                __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&(stack->link[CGRE_NODE_HEAD]),
+                &top, CGRE_STACK_TAGGED(node, top), 1, __ATOMIC_RELEASE,
+                __ATOMIC_RELAXED));
+    return node;
+}
+
+/**
+ * @brief Pop from the lock-free stack
+ */
+static struct cgre_node* cgre_stack_treiber_pop(
+        struct cgre_node_set* stack)
+{
+    struct cgre_node* top = __atomic_load_n(&(stack->link[CGRE_NODE_HEAD]),
+            __ATOMIC_ACQUIRE);
+    struct cgre_node* removed;
+    do {
+        removed = CGRE_STACK_TOP(top);
+        if (removed == NULL) {
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&(stack->link[CGRE_NODE_HEAD]),
+                &top, CGRE_STACK_TAGGED(__atomic_load_n(
+                        &(removed->link[CGRE_NODE_TAIL]), __ATOMIC_RELAXED),
+                    top), 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+    return removed;
+}
+
+/**
+ * @brief Peek at the lock-free stack
+ */
+static struct cgre_node* cgre_stack_treiber_peek(
+        struct cgre_node_set* stack)
+{
+    return CGRE_STACK_TOP(__atomic_load_n(&(stack->link[CGRE_NODE_HEAD]),
+                __ATOMIC_ACQUIRE));
+}
+
+#define CGRE_STACK_LOCK_FREE(S) \
+    (CGRE_STACK_MODE((S)->state) == CGRE_STACK_TREIBER)
+
+#else
+
+#define CGRE_STACK_LOCK_FREE(S) 0
+#define cgre_stack_treiber_push(S, N) NULL
+#define cgre_stack_treiber_pop(S) NULL
+#define cgre_stack_treiber_peek(S) NULL
+
+#endif /* if UINTPTR_MAX > 0xFFFFFFFFu */
+
 /**
  * @brief Add a node to the stack
  *
@@ -44,8 +152,11 @@ struct cgre_node* cgre_stack_push(
         struct cgre_node_set* stack,
         struct cgre_node* node)
 {
+    if (CGRE_STACK_LOCK_FREE(stack)) {
+        return cgre_stack_treiber_push(stack, node);
+    }
     struct cgre_node* pushed = node;
-    cgre_int_t fail = pthread_mutex_lock(&(stack->lock));
+    cgre_int_t fail = cgre_node_set_lock(stack);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(stack->state);
         return NULL;
@@ -61,7 +172,7 @@ struct cgre_node* cgre_stack_push(
         stack->link[CGRE_NODE_TAIL] = node;
     }
     stack->count++;
-    fail = pthread_mutex_unlock(&(stack->lock));
+    fail = cgre_node_set_unlock(stack);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(stack->state);
     }
@@ -77,8 +188,11 @@ struct cgre_node* cgre_stack_push(
 struct cgre_node* cgre_stack_pop(
         struct cgre_node_set* stack)
 {
+    if (CGRE_STACK_LOCK_FREE(stack)) {
+        return cgre_stack_treiber_pop(stack);
+    }
     struct cgre_node* removed = NULL;
-    cgre_int_t fail = pthread_mutex_lock(&(stack->lock));
+    cgre_int_t fail = cgre_node_set_lock(stack);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(stack->state);
         return NULL;
@@ -101,7 +215,7 @@ struct cgre_node* cgre_stack_pop(
         }
         stack->count--;
     }
-    fail = pthread_mutex_unlock(&(stack->lock));
+    fail = cgre_node_set_unlock(stack);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(stack->state);
     }
@@ -117,14 +231,17 @@ struct cgre_node* cgre_stack_pop(
 struct cgre_node* cgre_stack_peek(
         struct cgre_node_set* stack)
 {
-    cgre_int_t fail = pthread_mutex_lock(&(stack->lock));
+    if (CGRE_STACK_LOCK_FREE(stack)) {
+        return cgre_stack_treiber_peek(stack);
+    }
+    cgre_int_t fail = cgre_node_set_lock(stack);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(stack->state);
         return NULL;
     }
     // We just want to get the value at the list head, nothing else is done 
     struct cgre_node* node = stack->link[CGRE_NODE_HEAD];
-    fail = pthread_mutex_unlock(&(stack->lock));
+    fail = cgre_node_set_unlock(stack);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(stack->state);
     }
@@ -30,6 +30,1352 @@ SOFTWARE.
 
 #include <cgre/core/set.h>
 
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @def CGRE_TREE_LOCKED 1
+ * @brief Locked mode of the tree
+ *
+ * Searches hold the set lock like every other operation.
+ */
+
+/**
+ * @def CGRE_TREE_OPTIMISTIC 2
+ * @brief Optimistic read mode of the tree
+ *
+ * Searches do not take the set lock, so they never block each other.
+ * Writers still serialize on the lock and make `cgre_node_set.sequence` odd
+ * while they change the tree. A search reads the sequence, walks the tree and
+ * only trusts its result if the sequence was even and unchanged, otherwise it
+ * walks again, and takes the lock after `CGRE_TREE_OPTIMISTIC_RETRIES` tries.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&tree);
+ * CGRE_NODES_MODE_SET_VALUE(tree.state, CGRE_TREE_OPTIMISTIC);
+ * @endcode
+ *
+ * @warning
+ * A search may be walking through a member while it is deleted, deleted
+ * members must not be released while searches can still reach them.
+ */
+
+/**
+ * @def CGRE_TREE_MODE(N)
+ * @brief Compute the effective mode of a tree from its state
+ */
+
+/**
+ * @def CGRE_TREE_OPTIMISTIC_RETRIES 8
+ * @brief Optimistic walks a search tries before taking the lock
+ */
+
+/**
+ * @brief Start changing a locked tree, optimistic searches will retry
+ */
+static inline void cgre_tree_write_begin(
+        struct cgre_node_set* tree)
+{
+    __atomic_store_n(&(tree->sequence), tree->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Done changing a locked tree
+ */
+static inline void cgre_tree_write_end(
+        struct cgre_node_set* tree)
+{
+    __atomic_store_n(&(tree->sequence), tree->sequence + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Search the tree without the lock
+ *
+ * @param[out] found Node found or NULL
+ * @return 1 when `found` can be trusted or 0 when writers kept interfering
+ */
+static cgre_int_t cgre_tree_search_optimistic(
+        struct cgre_node_set* tree,
+        cgre_uint_t key,
+        struct cgre_node** found)
+{
+    for (cgre_int_t attempt = 0; attempt < CGRE_TREE_OPTIMISTIC_RETRIES;
+            attempt++) {
+        cgre_uint_t begin = __atomic_load_n(&(tree->sequence),
+                __ATOMIC_ACQUIRE);
+        // Is a writer busy?
+        if (begin & 1) {
+            continue;
+        }
+        struct cgre_node* node = __atomic_load_n(
+                &(tree->link[CGRE_NODE_HEAD]), __ATOMIC_RELAXED);
+        for (cgre_uint_t steps = 0; node != NULL && node->key != key;
+                steps++) {
+            // Deeper than any balanced tree? We met a rotation
+            if (steps == CGRE_TREE_MAX_HEIGHT) {
+                node = NULL;
+                break;
+            }
+            node = __atomic_load_n(&(node->link[key > node->key]),
+                    __ATOMIC_RELAXED);
+        }
+        // Did a writer pass by while we walked?
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&(tree->sequence), __ATOMIC_RELAXED) == begin) {
+            *found = node;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @def CGRE_TREE_RANKED 8
+ * @brief State flag keeping subtree sizes in the red-black tree
+ *
+ * Every member then counts the members of its subtree in the bits of `dir`
+ * above its color, kept through inserts, deletes and rotations, so
+ * `cgre_tree_select()` and `cgre_tree_rank()` take a single root to leaf
+ * walk. Set it while the tree is empty. A ranked tree holds up to
+ * `CGRE_UINT_MAX >> 2` members.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&tree);
+ * tree.state |= CGRE_TREE_RANKED;
+ * @endcode
+ */
+
+/**
+ * @brief Color of a member, leaving the subtree size out
+ */
+static inline cgre_uint_t cgre_tree_color(
+        struct cgre_node* node)
+{
+    return node->dir & 3;
+}
+
+/**
+ * @brief Color a member, keeping its subtree size
+ */
+static inline void cgre_tree_paint(
+        struct cgre_node* node,
+        cgre_uint_t color)
+{
+    node->dir = (node->dir & ~3u) | color;
+}
+
+/**
+ * @brief Members in the subtree of a member of a ranked tree
+ */
+static inline cgre_uint_t cgre_tree_size(
+        struct cgre_node* node)
+{
+    return node == NULL ? 0 : node->dir >> 2;
+}
+
+/**
+ * @brief Recount the subtree of a member of a ranked tree from its children
+ */
+static inline void cgre_tree_resize(
+        struct cgre_node* node)
+{
+    node->dir = cgre_tree_color(node) | ((cgre_tree_size(node->link[0]) +
+            cgre_tree_size(node->link[1]) + 1) << 2);
+}
+
+/**
+ * @def CGRE_TREE_BTREE 3
+ * @brief Cache conscious B+tree mode of the tree
+ *
+ * Members are held in B+tree pages owned by the set instead of being linked
+ * through their own `link`. A page packs up to `CGRE_TREE_BTREE_ORDER` keys
+ * into a few cache lines and is searched without branching on the keys, with
+ * SSE2 where available, so a search costs a couple of cache misses on each
+ * level of a tree only a handful of levels deep. Leaf pages are chained in
+ * key order for scans. Member links and colors are left untouched.
+ *
+ * @code{.c}
+ * cgre_node_set_initialize(&tree);
+ * CGRE_NODES_MODE_SET_VALUE(tree.state, CGRE_TREE_BTREE);
+ * @endcode
+ */
+
+/**
+ * @def CGRE_TREE_BTREE_ORDER 32
+ * @brief Keys held by a B+tree page, must be an even multiple of 4
+ */
+
+/**
+ * @def CGRE_TREE_BUILD_PARALLEL 65536
+ * @brief Members from which `cgre_tree_build()` sorts in parallel
+ */
+
+/**
+ * @def CGRE_TREE_BUILD_THREADS 8
+ * @brief Most threads `cgre_tree_build()` sorts with
+ */
+
+/**
+ * @def CGRE_TREE_BTREE_MAX_HEIGHT
+ * @brief Bound on the levels of a B+tree
+ *
+ * Pages other than the root stay at least half full, so each level at least
+ * halves the members below it.
+ */
+
+#if defined(__SSE2__) && CGRE_UINT_MAX == 0xFFFFFFFFu
+#include <emmintrin.h>
+#define CGRE_TREE_BTREE_SSE2 1
+#endif /* if defined(__SSE2__) && CGRE_UINT_MAX == 0xFFFFFFFFu */
+
+/**
+ * @brief B+tree page
+ *
+ * A leaf holds `count` members in `slot` with their keys in `key`. A branch
+ * at `level` above the leaves holds `count` pages in `slot` and the first
+ * key of every page but the first in `key`. Leaves chain through `next`,
+ * released pages wait for reuse on the same link.
+ */
+struct cgre_btree_page {
+    cgre_uint_t key[CGRE_TREE_BTREE_ORDER];
+    void* slot[CGRE_TREE_BTREE_ORDER];
+    struct cgre_btree_page* next;
+    cgre_uint_t count;
+    cgre_uint_t level;
+} __attribute__((aligned(CGRE_CACHE_LINE)));
+
+struct cgre_btree_chunk {
+    struct cgre_node_store store;
+    struct cgre_btree_page page[];
+};
+
+/**
+ * @brief B+tree owned by a set, first block of its store
+ *
+ * Pages are carved from chunks chained after this block, `store.used`
+ * counts the pages in the tree.
+ */
+struct cgre_btree {
+    struct cgre_node_store store;
+    struct cgre_btree_page* root;
+    struct cgre_btree_page* first;
+    struct cgre_btree_page* free;
+};
+
+/**
+ * @brief Count the keys of a page below a key
+ *
+ * @param[in] keys Sorted keys of a page
+ * @param[in] count Number of keys to consider
+ * @param[in] key Key to rank
+ */
+static inline cgre_uint_t cgre_btree_below(
+        const cgre_uint_t* keys,
+        cgre_uint_t count,
+        cgre_uint_t key)
+{
+    cgre_uint_t below = 0;
+#ifdef CGRE_TREE_BTREE_SSE2
+    // SSE2 only compares signed lanes, flipping the top bit orders unsigned
+    const __m128i flip = _mm_set1_epi32((int) 0x80000000u);
+    const __m128i probe = _mm_xor_si128(_mm_set1_epi32((int) key), flip);
+    for (cgre_uint_t idx = 0; idx < count; idx += 4) {
+        __m128i block = _mm_xor_si128(
+                _mm_load_si128((const __m128i*) &(keys[idx])), flip);
+        cgre_uint_t mask = (cgre_uint_t) _mm_movemask_ps(
+                _mm_castsi128_ps(_mm_cmpgt_epi32(probe, block)));
+        // Lanes past the count hold stale keys
+        if (count - idx < 4) {
+            mask &= (1u << (count - idx)) - 1;
+        }
+        below += __builtin_popcount(mask);
+    }
+#else
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        below += keys[idx] < key;
+    }
+#endif /* ifdef CGRE_TREE_BTREE_SSE2 */
+    return below;
+}
+
+/**
+ * @brief Pick the slot of a branch page that leads to a key
+ */
+static inline cgre_uint_t cgre_btree_branch(
+        const struct cgre_btree_page* page,
+        cgre_uint_t key)
+{
+    if (key == CGRE_UINT_MAX) {
+        return page->count - 1;
+    }
+    return cgre_btree_below(page->key, page->count - 1, key + 1);
+}
+
+/**
+ * @brief Take a cleared page from the free pages or the newest chunk
+ *
+ * @return page or NULL on allocation error
+ */
+static struct cgre_btree_page* cgre_btree_page_create(
+        struct cgre_btree* btree,
+        cgre_uint_t level)
+{
+    struct cgre_btree_page* page = btree->free;
+    if (page != NULL) {
+        btree->free = page->next;
+    } else {
+        struct cgre_btree_chunk* chunk =
+                (struct cgre_btree_chunk*) btree->store.next;
+        if (chunk == NULL || chunk->store.used == chunk->store.size) {
+            // Chunks double up to a thousand pages, so there are few of them
+            cgre_uint_t size = chunk == NULL ? 8 : chunk->store.size * 2;
+            if (size > 1024) {
+                size = 1024;
+            }
+            if (posix_memalign((void**) &chunk, CGRE_CACHE_LINE,
+                    sizeof(struct cgre_btree_chunk) +
+                    sizeof(struct cgre_btree_page) * size)) {
+                return NULL;
+            }
+            chunk->store.next = btree->store.next;
+            chunk->store.size = size;
+            chunk->store.used = 0;
+            btree->store.next = (struct cgre_node_store*) chunk;
+        }
+        page = &(chunk->page[chunk->store.used++]);
+    }
+    memset(page, 0, sizeof(struct cgre_btree_page));
+    page->level = level;
+    btree->store.used++;
+    return page;
+}
+
+static void cgre_btree_page_release(
+        struct cgre_btree* btree,
+        struct cgre_btree_page* page)
+{
+    page->next = btree->free;
+    btree->free = page;
+    btree->store.used--;
+}
+
+/**
+ * @brief Walk down to the leaf that holds or would hold a key
+ *
+ * @param[out] path Pages from the root to the leaf or NULL
+ * @param[out] index Slot taken on every page of `path`
+ * @param[out] depth Position of the leaf in `path`
+ */
+static struct cgre_btree_page* cgre_btree_leaf(
+        struct cgre_btree* btree,
+        cgre_uint_t key,
+        struct cgre_btree_page** path,
+        cgre_uint_t* index,
+        cgre_uint_t* depth)
+{
+    struct cgre_btree_page* page = btree->root;
+    cgre_uint_t height = 0;
+    while (page->level) {
+        cgre_uint_t idx = cgre_btree_branch(page, key);
+        if (path != NULL) {
+            path[height] = page;
+            index[height++] = idx;
+        }
+        page = (struct cgre_btree_page*) page->slot[idx];
+    }
+    if (path != NULL) {
+        path[height] = page;
+        *depth = height;
+    }
+    return page;
+}
+
+/**
+ * @brief Find the member slot of a key
+ *
+ * @return slot holding the member or NULL
+ */
+static void** cgre_btree_find(
+        struct cgre_btree* btree,
+        cgre_uint_t key)
+{
+    if (btree == NULL || btree->root == NULL) {
+        return NULL;
+    }
+    struct cgre_btree_page* leaf = cgre_btree_leaf(btree, key, NULL, NULL,
+            NULL);
+    cgre_uint_t pos = cgre_btree_below(leaf->key, leaf->count, key);
+    if (pos < leaf->count && leaf->key[pos] == key) {
+        return &(leaf->slot[pos]);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Insert a node into a locked B+tree
+ *
+ * Full pages are split on the way back up, every page the split needs is
+ * taken up front so an allocation error leaves the tree unchanged.
+ *
+ * @return existing or inserted node or NULL on allocation error
+ */
+static struct cgre_node* cgre_btree_place(
+        struct cgre_node_set* tree,
+        struct cgre_node* node)
+{
+    struct cgre_btree_page* path[CGRE_TREE_BTREE_MAX_HEIGHT];
+    cgre_uint_t index[CGRE_TREE_BTREE_MAX_HEIGHT];
+    struct cgre_btree_page* spare[CGRE_TREE_BTREE_MAX_HEIGHT + 1];
+    cgre_uint_t depth, spares = 0;
+    if (tree->store == NULL) {
+        tree->store = calloc(1, sizeof(struct cgre_btree));
+        if (tree->store == NULL) {
+            return NULL;
+        }
+    }
+    struct cgre_btree* btree = (struct cgre_btree*) tree->store;
+    if (btree->root == NULL) {
+        btree->root = cgre_btree_page_create(btree, 0);
+        if (btree->root == NULL) {
+            return NULL;
+        }
+        btree->first = btree->root;
+    }
+    struct cgre_btree_page* page = cgre_btree_leaf(btree, node->key, path,
+            index, &depth);
+    cgre_uint_t pos = cgre_btree_below(page->key, page->count, node->key);
+    if (pos < page->count && page->key[pos] == node->key) {
+        return (struct cgre_node*) page->slot[pos];
+    }
+    // Every full page on the path splits, a full root also needs a new root
+    for (cgre_uint_t height = depth + 1;
+            height > 0 && path[height - 1]->count == CGRE_TREE_BTREE_ORDER;
+            height--) {
+        spares += 1 + (height == 1);
+    }
+    for (cgre_uint_t idx = 0; idx < spares; idx++) {
+        spare[idx] = cgre_btree_page_create(btree, 0);
+        if (spare[idx] == NULL) {
+            while (idx > 0) {
+                cgre_btree_page_release(btree, spare[--idx]);
+            }
+            return NULL;
+        }
+    }
+
+    cgre_uint_t key = node->key;
+    void* slot = node;
+    for (;;) {
+        cgre_uint_t count = page->count;
+        if (page->level == 0 && count < CGRE_TREE_BTREE_ORDER) {
+            memmove(&(page->key[pos + 1]), &(page->key[pos]),
+                    sizeof(cgre_uint_t) * (count - pos));
+            memmove(&(page->slot[pos + 1]), &(page->slot[pos]),
+                    sizeof(void*) * (count - pos));
+            page->key[pos] = key;
+            page->slot[pos] = slot;
+            page->count++;
+            break;
+        }
+        if (page->level != 0 && count < CGRE_TREE_BTREE_ORDER) {
+            // The new page goes right of the slot we came down through
+            memmove(&(page->key[pos + 1]), &(page->key[pos]),
+                    sizeof(cgre_uint_t) * (count - 1 - pos));
+            memmove(&(page->slot[pos + 2]), &(page->slot[pos + 1]),
+                    sizeof(void*) * (count - 1 - pos));
+            page->key[pos] = key;
+            page->slot[pos + 1] = slot;
+            page->count++;
+            break;
+        }
+
+        // Full, lay out the pieces in order and split them over two pages
+        cgre_uint_t keys[CGRE_TREE_BTREE_ORDER + 1];
+        void* slots[CGRE_TREE_BTREE_ORDER + 1];
+        struct cgre_btree_page* right = spare[--spares];
+        right->level = page->level;
+        cgre_uint_t left = (CGRE_TREE_BTREE_ORDER + 1) / 2;
+        if (page->level == 0) {
+            memcpy(keys, page->key, sizeof(cgre_uint_t) * pos);
+            memcpy(slots, page->slot, sizeof(void*) * pos);
+            keys[pos] = key;
+            slots[pos] = slot;
+            memcpy(&(keys[pos + 1]), &(page->key[pos]),
+                    sizeof(cgre_uint_t) * (count - pos));
+            memcpy(&(slots[pos + 1]), &(page->slot[pos]),
+                    sizeof(void*) * (count - pos));
+            memcpy(page->key, keys, sizeof(cgre_uint_t) * left);
+            memcpy(page->slot, slots, sizeof(void*) * left);
+            right->count = count + 1 - left;
+            memcpy(right->key, &(keys[left]),
+                    sizeof(cgre_uint_t) * right->count);
+            memcpy(right->slot, &(slots[left]),
+                    sizeof(void*) * right->count);
+            right->next = page->next;
+            page->next = right;
+            key = right->key[0];
+        } else {
+            memcpy(keys, page->key, sizeof(cgre_uint_t) * pos);
+            memcpy(slots, page->slot, sizeof(void*) * (pos + 1));
+            keys[pos] = key;
+            slots[pos + 1] = slot;
+            memcpy(&(keys[pos + 1]), &(page->key[pos]),
+                    sizeof(cgre_uint_t) * (count - 1 - pos));
+            memcpy(&(slots[pos + 2]), &(page->slot[pos + 1]),
+                    sizeof(void*) * (count - 1 - pos));
+            // The key between the halves moves up instead of staying
+            memcpy(page->key, keys, sizeof(cgre_uint_t) * (left - 1));
+            memcpy(page->slot, slots, sizeof(void*) * left);
+            right->count = count + 1 - left;
+            memcpy(right->key, &(keys[left]),
+                    sizeof(cgre_uint_t) * (right->count - 1));
+            memcpy(right->slot, &(slots[left]),
+                    sizeof(void*) * right->count);
+            key = keys[left - 1];
+        }
+        page->count = left;
+        slot = right;
+
+        if (depth == 0) {
+            struct cgre_btree_page* root = spare[--spares];
+            root->level = page->level + 1;
+            root->count = 2;
+            root->key[0] = key;
+            root->slot[0] = page;
+            root->slot[1] = right;
+            btree->root = root;
+            break;
+        }
+        page = path[--depth];
+        pos = index[depth];
+    }
+    tree->count++;
+    return node;
+}
+
+/**
+ * @brief Delete a key from a locked B+tree
+ *
+ * Pages left less than half full borrow from or merge with a neighbour.
+ *
+ * @return removed node or NULL
+ */
+static struct cgre_node* cgre_btree_remove(
+        struct cgre_node_set* tree,
+        cgre_uint_t key)
+{
+    struct cgre_btree_page* path[CGRE_TREE_BTREE_MAX_HEIGHT];
+    cgre_uint_t index[CGRE_TREE_BTREE_MAX_HEIGHT];
+    cgre_uint_t depth;
+    struct cgre_btree* btree = (struct cgre_btree*) tree->store;
+    if (btree == NULL || btree->root == NULL) {
+        return NULL;
+    }
+    struct cgre_btree_page* page = cgre_btree_leaf(btree, key, path, index,
+            &depth);
+    cgre_uint_t pos = cgre_btree_below(page->key, page->count, key);
+    if (pos == page->count || page->key[pos] != key) {
+        return NULL;
+    }
+    struct cgre_node* removed = (struct cgre_node*) page->slot[pos];
+    page->count--;
+    memmove(&(page->key[pos]), &(page->key[pos + 1]),
+            sizeof(cgre_uint_t) * (page->count - pos));
+    memmove(&(page->slot[pos]), &(page->slot[pos + 1]),
+            sizeof(void*) * (page->count - pos));
+    tree->count--;
+
+    for (; depth > 0 && page->count < CGRE_TREE_BTREE_ORDER / 2; depth--) {
+        struct cgre_btree_page* parent = path[depth - 1];
+        cgre_uint_t idx = index[depth - 1];
+        struct cgre_btree_page* left = idx > 0 ?
+                (struct cgre_btree_page*) parent->slot[idx - 1] : NULL;
+        struct cgre_btree_page* right = idx + 1 < parent->count ?
+                (struct cgre_btree_page*) parent->slot[idx + 1] : NULL;
+        if (left != NULL && left->count > CGRE_TREE_BTREE_ORDER / 2) {
+            // Borrow the last slot of the left neighbour
+            memmove(&(page->slot[1]), page->slot,
+                    sizeof(void*) * page->count);
+            page->slot[0] = left->slot[left->count - 1];
+            if (page->level == 0) {
+                memmove(&(page->key[1]), page->key,
+                        sizeof(cgre_uint_t) * page->count);
+                page->key[0] = left->key[left->count - 1];
+                parent->key[idx - 1] = page->key[0];
+            } else {
+                memmove(&(page->key[1]), page->key,
+                        sizeof(cgre_uint_t) * (page->count - 1));
+                page->key[0] = parent->key[idx - 1];
+                parent->key[idx - 1] = left->key[left->count - 2];
+            }
+            left->count--;
+            page->count++;
+            break;
+        }
+        if (right != NULL && right->count > CGRE_TREE_BTREE_ORDER / 2) {
+            // Borrow the first slot of the right neighbour
+            page->slot[page->count] = right->slot[0];
+            if (page->level == 0) {
+                page->key[page->count] = right->key[0];
+                memmove(right->key, &(right->key[1]),
+                        sizeof(cgre_uint_t) * (right->count - 1));
+                parent->key[idx] = right->key[0];
+            } else {
+                page->key[page->count - 1] = parent->key[idx];
+                parent->key[idx] = right->key[0];
+                memmove(right->key, &(right->key[1]),
+                        sizeof(cgre_uint_t) * (right->count - 2));
+            }
+            memmove(right->slot, &(right->slot[1]),
+                    sizeof(void*) * (right->count - 1));
+            right->count--;
+            page->count++;
+            break;
+        }
+        // Neither neighbour can spare a slot, merge the right page into
+        // the left one
+        if (left == NULL) {
+            left = page;
+            idx++;
+        } else {
+            right = page;
+        }
+        if (left->level == 0) {
+            memcpy(&(left->key[left->count]), right->key,
+                    sizeof(cgre_uint_t) * right->count);
+            left->next = right->next;
+        } else {
+            left->key[left->count - 1] = parent->key[idx - 1];
+            memcpy(&(left->key[left->count]), right->key,
+                    sizeof(cgre_uint_t) * (right->count - 1));
+        }
+        memcpy(&(left->slot[left->count]), right->slot,
+                sizeof(void*) * right->count);
+        left->count += right->count;
+        cgre_btree_page_release(btree, right);
+        // The parent forgets the right page and the key before it
+        parent->count--;
+        memmove(&(parent->key[idx - 1]), &(parent->key[idx]),
+                sizeof(cgre_uint_t) * (parent->count - idx));
+        memmove(&(parent->slot[idx]), &(parent->slot[idx + 1]),
+                sizeof(void*) * (parent->count - idx));
+        page = parent;
+    }
+
+    // A root down to one page hands over to it
+    page = btree->root;
+    if (page->level != 0 && page->count == 1) {
+        btree->root = (struct cgre_btree_page*) page->slot[0];
+        cgre_btree_page_release(btree, page);
+    } else if (page->count == 0) {
+        btree->root = NULL;
+        btree->first = NULL;
+        cgre_btree_page_release(btree, page);
+    }
+    return removed;
+}
+
+/**
+ * @brief Delete a key from the B+tree
+ */
+static struct cgre_node* cgre_btree_delete(
+        struct cgre_node_set* tree,
+        cgre_uint_t key)
+{
+    struct cgre_node* result = NULL;
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
+    }
+    result = cgre_btree_remove(tree, key);
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return result;
+}
+
+/**
+ * @brief Insert a node into the B+tree
+ */
+static struct cgre_node* cgre_btree_insert(
+        struct cgre_node_set* tree,
+        struct cgre_node* node)
+{
+    struct cgre_node* result = NULL;
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
+    }
+    result = cgre_btree_place(tree, node);
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return result;
+}
+
+/**
+ * @brief Replace the member of the B+tree with the key of a node
+ */
+static struct cgre_node* cgre_btree_replace(
+        struct cgre_node_set* tree,
+        struct cgre_node* node)
+{
+    struct cgre_node* result = NULL;
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
+    }
+    void** slot = cgre_btree_find((struct cgre_btree*) tree->store,
+            node->key);
+    if (slot != NULL) {
+        result = (struct cgre_node*) *slot;
+        *slot = node;
+    }
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return result;
+}
+
+/**
+ * @brief Search the B+tree for a key
+ */
+static struct cgre_node* cgre_btree_search(
+        struct cgre_node_set* tree,
+        cgre_uint_t key)
+{
+    struct cgre_node* result = NULL;
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
+    }
+    void** slot = cgre_btree_find((struct cgre_btree*) tree->store, key);
+    if (slot != NULL) {
+        result = (struct cgre_node*) *slot;
+    }
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return result;
+}
+
+/**
+ * @brief Copy the members of a locked B+tree from `low` to `last` in order
+ *
+ * @return number of members copied
+ */
+static cgre_uint_t cgre_btree_collect(
+        struct cgre_btree* btree,
+        cgre_uint_t low,
+        cgre_uint_t last,
+        struct cgre_node** members,
+        cgre_uint_t size)
+{
+    cgre_uint_t found = 0;
+    if (btree == NULL || btree->root == NULL) {
+        return 0;
+    }
+    struct cgre_btree_page* page = cgre_btree_leaf(btree, low, NULL, NULL,
+            NULL);
+    cgre_uint_t pos = cgre_btree_below(page->key, page->count, low);
+    // The leaves are chained in key order, no need to climb back up
+    for (; page != NULL && found < size; page = page->next, pos = 0) {
+        for (; pos < page->count && found < size; pos++) {
+            if (page->key[pos] > last) {
+                return found;
+            }
+            members[found++] = (struct cgre_node*) page->slot[pos];
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Copy the members of a locked tree from `low` to `last` in order
+ *
+ * @return number of members copied
+ */
+static cgre_uint_t cgre_tree_collect(
+        struct cgre_node_set* tree,
+        cgre_uint_t low,
+        cgre_uint_t last,
+        struct cgre_node** members,
+        cgre_uint_t size)
+{
+    struct cgre_node *nodes[CGRE_TREE_MAX_HEIGHT];
+    cgre_int_t height = 0;
+    cgre_uint_t found = 0;
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        return cgre_btree_collect((struct cgre_btree*) tree->store, low, last,
+                members, size);
+    }
+    // Stack the members at or above low whose left side is still to visit
+    for (struct cgre_node* node = tree->link[CGRE_NODE_HEAD]; node != NULL;) {
+        if (node->key >= low) {
+            nodes[height++] = node;
+            node = node->link[0];
+        } else {
+            node = node->link[1];
+        }
+    }
+    while (height > 0 && found < size) {
+        struct cgre_node* node = nodes[--height];
+        if (node->key > last) {
+            break;
+        }
+        members[found++] = node;
+        for (node = node->link[1]; node != NULL; node = node->link[0]) {
+            nodes[height++] = node;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Find the member at an index in key order of a locked tree
+ *
+ * Ranked trees descend by subtree sizes, B+trees skip whole leaves and other
+ * trees walk their members in order.
+ */
+static struct cgre_node* cgre_tree_nth(
+        struct cgre_node_set* tree,
+        cgre_uint_t index)
+{
+    struct cgre_node *nodes[CGRE_TREE_MAX_HEIGHT];
+    cgre_int_t height = 0;
+    if (index >= tree->count) {
+        return NULL;
+    }
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        struct cgre_btree_page* page =
+            ((struct cgre_btree*) tree->store)->first;
+        for (; index >= page->count; page = page->next) {
+            index -= page->count;
+        }
+        return (struct cgre_node*) page->slot[index];
+    }
+    if (tree->state & CGRE_TREE_RANKED) {
+        struct cgre_node* node = tree->link[CGRE_NODE_HEAD];
+        for (cgre_uint_t left = cgre_tree_size(node->link[0]); index != left;
+                left = cgre_tree_size(node->link[0])) {
+            if (index < left) {
+                node = node->link[0];
+            } else {
+                index -= left + 1;
+                node = node->link[1];
+            }
+        }
+        return node;
+    }
+    for (struct cgre_node* node = tree->link[CGRE_NODE_HEAD]; node != NULL;
+            node = node->link[0]) {
+        nodes[height++] = node;
+    }
+    for (;;) {
+        struct cgre_node* node = nodes[--height];
+        if (index-- == 0) {
+            return node;
+        }
+        for (node = node->link[1]; node != NULL; node = node->link[0]) {
+            nodes[height++] = node;
+        }
+    }
+}
+
+/**
+ * @brief Count the members of a locked tree with keys below a key
+ */
+static cgre_uint_t cgre_tree_below(
+        struct cgre_node_set* tree,
+        cgre_uint_t key)
+{
+    struct cgre_node *nodes[CGRE_TREE_MAX_HEIGHT];
+    cgre_int_t height = 0;
+    cgre_uint_t below = 0;
+    if (tree->count == 0) {
+        return 0;
+    }
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        struct cgre_btree* btree = (struct cgre_btree*) tree->store;
+        for (struct cgre_btree_page* page = btree->first; page != NULL;
+                page = page->next) {
+            if (page->key[page->count - 1] >= key) {
+                return below + cgre_btree_below(page->key, page->count, key);
+            }
+            below += page->count;
+        }
+        return below;
+    }
+    if (tree->state & CGRE_TREE_RANKED) {
+        for (struct cgre_node* node = tree->link[CGRE_NODE_HEAD];
+                node != NULL;) {
+            if (key > node->key) {
+                below += cgre_tree_size(node->link[0]) + 1;
+                node = node->link[1];
+            } else {
+                node = node->link[0];
+            }
+        }
+        return below;
+    }
+    for (struct cgre_node* node = tree->link[CGRE_NODE_HEAD]; node != NULL;
+            node = node->link[0]) {
+        nodes[height++] = node;
+    }
+    while (height > 0) {
+        struct cgre_node* node = nodes[--height];
+        if (node->key >= key) {
+            break;
+        }
+        below++;
+        for (node = node->link[1]; node != NULL; node = node->link[0]) {
+            nodes[height++] = node;
+        }
+    }
+    return below;
+}
+
+struct cgre_tree_sort_pair {
+    cgre_uint_t key;
+    struct cgre_node* node;
+};
+
+struct cgre_tree_sort_run {
+    struct cgre_tree_sort_pair* pairs;
+    struct cgre_tree_sort_pair* spare;
+    cgre_uint_t middle;
+    cgre_uint_t count;
+};
+
+/**
+ * @brief Radix sort a run 11 bits at a time, or merge its two sorted halves
+ * when it has a middle
+ *
+ * Both keep pairs with equal keys in their order.
+ */
+static void* cgre_tree_sort_worker(
+        void* arg)
+{
+    struct cgre_tree_sort_run* run = (struct cgre_tree_sort_run*) arg;
+    struct cgre_tree_sort_pair* from = run->pairs;
+    struct cgre_tree_sort_pair* to = run->spare;
+    if (run->middle == 0) {
+        for (cgre_uint_t shift = 0; shift < 8 * sizeof(cgre_uint_t);
+                shift += 11) {
+            cgre_uint_t bucket[2048] = {0};
+            for (cgre_uint_t idx = 0; idx < run->count; idx++) {
+                bucket[(from[idx].key >> shift) & 2047]++;
+            }
+            // Skip digits every key shares, small keys need few passes
+            if (bucket[(from[0].key >> shift) & 2047] == run->count) {
+                continue;
+            }
+            for (cgre_uint_t idx = 0, sum = 0; idx < 2048; idx++) {
+                cgre_uint_t size = bucket[idx];
+                bucket[idx] = sum;
+                sum += size;
+            }
+            for (cgre_uint_t idx = 0; idx < run->count; idx++) {
+                to[bucket[(from[idx].key >> shift) & 2047]++] = from[idx];
+            }
+            struct cgre_tree_sort_pair* swap = from;
+            from = to;
+            to = swap;
+        }
+        if (from != run->pairs) {
+            memcpy(run->pairs, from,
+                    sizeof(struct cgre_tree_sort_pair) * run->count);
+        }
+        return NULL;
+    }
+    cgre_uint_t left = 0, right = run->middle, out = 0;
+    while (left < run->middle && right < run->count) {
+        if (from[right].key < from[left].key) {
+            to[out++] = from[right++];
+        } else {
+            to[out++] = from[left++];
+        }
+    }
+    while (left < run->middle) {
+        to[out++] = from[left++];
+    }
+    while (right < run->count) {
+        to[out++] = from[right++];
+    }
+    memcpy(from, to, sizeof(struct cgre_tree_sort_pair) * out);
+    return NULL;
+}
+
+/**
+ * @brief Run sort workers on threads, in this thread if none can start
+ */
+static void cgre_tree_sort_workers(
+        struct cgre_tree_sort_run* runs,
+        cgre_uint_t count)
+{
+    pthread_t threads[CGRE_TREE_BUILD_THREADS];
+    cgre_int_t started[CGRE_TREE_BUILD_THREADS];
+    for (cgre_uint_t idx = 1; idx < count; idx++) {
+        started[idx] = pthread_create(&(threads[idx]), NULL,
+                cgre_tree_sort_worker, &(runs[idx])) == 0;
+        if (!started[idx]) {
+            cgre_tree_sort_worker(&(runs[idx]));
+        }
+    }
+    cgre_tree_sort_worker(&(runs[0]));
+    for (cgre_uint_t idx = 1; idx < count; idx++) {
+        if (started[idx]) {
+            pthread_join(threads[idx], NULL);
+        }
+    }
+}
+
+/**
+ * @brief Sort nodes by key and move the repeats of a key to the end
+ *
+ * Sorted input is detected and left in place. Keys are copied next to their
+ * nodes so the sort never chases node pointers. Large inputs are cut into
+ * runs sorted on their own threads, then merged pairwise, also in parallel.
+ * Nodes with equal keys keep their order.
+ *
+ * @param[out] unique Number of nodes with distinct keys
+ * @return 1 or 0 on allocation error
+ */
+static cgre_int_t cgre_tree_sort(
+        struct cgre_node** nodes,
+        cgre_uint_t count,
+        cgre_uint_t* unique)
+{
+    struct cgre_tree_sort_run runs[CGRE_TREE_BUILD_THREADS];
+    cgre_uint_t idx = 1;
+    *unique = count;
+    while (idx < count && nodes[idx - 1]->key < nodes[idx]->key) {
+        idx++;
+    }
+    if (idx >= count) {
+        return 1;
+    }
+    struct cgre_tree_sort_pair* pairs = malloc(
+            sizeof(struct cgre_tree_sort_pair) * 2 * (size_t) count);
+    if (pairs == NULL) {
+        return 0;
+    }
+    for (idx = 0; idx < count; idx++) {
+        pairs[idx].key = nodes[idx]->key;
+        pairs[idx].node = nodes[idx];
+    }
+    cgre_uint_t threads = 1;
+    if (count >= CGRE_TREE_BUILD_PARALLEL) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        while (threads * 2 <= CGRE_TREE_BUILD_THREADS &&
+                threads * 2 <= online) {
+            threads *= 2;
+        }
+    }
+    for (idx = 0; idx < threads; idx++) {
+        cgre_uint_t start = (cgre_uint_t) ((uint64_t) count * idx / threads);
+        cgre_uint_t end = (cgre_uint_t) ((uint64_t) count * (idx + 1) /
+                threads);
+        runs[idx].pairs = &(pairs[start]);
+        runs[idx].spare = &(pairs[count + start]);
+        runs[idx].middle = 0;
+        runs[idx].count = end - start;
+    }
+    cgre_tree_sort_workers(runs, threads);
+    // Each round merges neighbouring runs, halving their number
+    for (; threads > 1; threads /= 2) {
+        for (idx = 0; idx < threads / 2; idx++) {
+            runs[idx].pairs = runs[idx * 2].pairs;
+            runs[idx].spare = runs[idx * 2].spare;
+            runs[idx].middle = runs[idx * 2].count;
+            runs[idx].count = runs[idx * 2].count + runs[idx * 2 + 1].count;
+        }
+        cgre_tree_sort_workers(runs, threads / 2);
+    }
+    // Distinct keys first, then the repeats
+    *unique = 0;
+    for (idx = 0; idx < count; idx++) {
+        if (idx == 0 || pairs[idx].key != pairs[idx - 1].key) {
+            nodes[(*unique)++] = pairs[idx].node;
+        }
+    }
+    for (cgre_uint_t repeat = *unique, idx = 1; idx < count; idx++) {
+        if (pairs[idx].key == pairs[idx - 1].key) {
+            nodes[repeat++] = pairs[idx].node;
+        }
+    }
+    free(pairs);
+    return 1;
+}
+
+/**
+ * @brief Link sorted nodes into a perfectly balanced red-black subtree
+ *
+ * Halving the nodes at every level leaves all empty links one or two levels
+ * below `bottom`, so the members on `bottom` are red and every path counts
+ * the same black members.
+ */
+static struct cgre_node* cgre_tree_build_nodes(
+        struct cgre_node** nodes,
+        cgre_uint_t count,
+        cgre_uint_t depth,
+        cgre_uint_t bottom)
+{
+    if (count == 0) {
+        return NULL;
+    }
+    cgre_uint_t middle = count / 2;
+    struct cgre_node* node = nodes[middle];
+    node->link[0] = cgre_tree_build_nodes(nodes, middle, depth + 1, bottom);
+    node->link[1] = cgre_tree_build_nodes(&(nodes[middle + 1]),
+            count - middle - 1, depth + 1, bottom);
+    node->dir = ((depth == bottom && depth > 0) ?
+            CGRE_TREE_RED : CGRE_TREE_BLACK) | (count << 2);
+    return node;
+}
+
+/**
+ * @brief Pack sorted nodes into the pages of an empty locked B+tree
+ *
+ * Pages of a level are filled evenly, which keeps every one of them at
+ * least half full, then the level above is built over their first keys.
+ *
+ * @return 1 or 0 on allocation error with the tree left empty
+ */
+static cgre_int_t cgre_btree_build(
+        struct cgre_node_set* tree,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    if (tree->store == NULL) {
+        tree->store = calloc(1, sizeof(struct cgre_btree));
+        if (tree->store == NULL) {
+            return 0;
+        }
+    }
+    struct cgre_btree* btree = (struct cgre_btree*) tree->store;
+    cgre_uint_t pages = (count + CGRE_TREE_BTREE_ORDER - 1) /
+            CGRE_TREE_BTREE_ORDER;
+    struct cgre_btree_page** level = malloc(
+            sizeof(struct cgre_btree_page*) * pages);
+    cgre_uint_t* first = malloc(sizeof(cgre_uint_t) * pages);
+    cgre_int_t built = level != NULL && first != NULL;
+    struct cgre_btree_page* last = NULL;
+    for (cgre_uint_t idx = 0, taken = 0; built && idx < pages; idx++) {
+        struct cgre_btree_page* page = cgre_btree_page_create(btree, 0);
+        if (page == NULL) {
+            built = 0;
+            break;
+        }
+        cgre_uint_t end = (cgre_uint_t) ((uint64_t) count * (idx + 1) /
+                pages);
+        for (; taken < end; taken++) {
+            page->key[page->count] = nodes[taken]->key;
+            page->slot[page->count++] = nodes[taken];
+        }
+        if (last == NULL) {
+            btree->first = page;
+        } else {
+            last->next = page;
+        }
+        last = page;
+        level[idx] = page;
+        first[idx] = page->key[0];
+    }
+    for (cgre_uint_t height = 1; built && pages > 1; height++) {
+        cgre_uint_t above = (pages + CGRE_TREE_BTREE_ORDER - 1) /
+                CGRE_TREE_BTREE_ORDER;
+        for (cgre_uint_t idx = 0, taken = 0; idx < above; idx++) {
+            struct cgre_btree_page* page = cgre_btree_page_create(btree,
+                    height);
+            if (page == NULL) {
+                built = 0;
+                break;
+            }
+            cgre_uint_t end = (cgre_uint_t) ((uint64_t) pages * (idx + 1) /
+                    above);
+            cgre_uint_t lowest = first[taken];
+            for (; taken < end; taken++) {
+                if (page->count > 0) {
+                    page->key[page->count - 1] = first[taken];
+                }
+                page->slot[page->count++] = level[taken];
+            }
+            // The level is rewritten in place, it is read ahead of writes
+            level[idx] = page;
+            first[idx] = lowest;
+        }
+        pages = above;
+    }
+    if (built) {
+        btree->root = level[0];
+        tree->count = count;
+    } else {
+        // The tree was empty, its store holds nothing worth keeping
+        for (struct cgre_node_store* block = tree->store; block != NULL;) {
+            struct cgre_node_store* next = block->next;
+            free(block);
+            block = next;
+        }
+        tree->store = NULL;
+    }
+    free(level);
+    free(first);
+    return built;
+}
+
+/**
+ * @brief Build an empty tree from an array of nodes at once
+ *
+ * The nodes are sorted by key, in parallel from `CGRE_TREE_BUILD_PARALLEL`
+ * nodes, then linked into a balanced tree under a single lock in O(n).
+ * Sorted input skips the sort.
+ *
+ * @param[in] tree Empty tree to build
+ * @param[in,out] nodes Nodes to insert, left sorted by key
+ * @param[in] count Number of nodes
+ * @return tree or NULL if the tree is not empty or error
+ *
+ * @note Only the first node of each key in `nodes` is inserted, the nodes
+ * with repeated keys are moved to the end of `nodes`.
+ */
+struct cgre_node_set* cgre_tree_build(
+        struct cgre_node_set* tree,
+        struct cgre_node** nodes,
+        cgre_uint_t count)
+{
+    if (tree == NULL || (nodes == NULL && count > 0)) {
+        return NULL;
+    }
+    cgre_uint_t unique;
+    if (!cgre_tree_sort(nodes, count, &unique)) {
+        return NULL;
+    }
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
+    }
+    struct cgre_node_set* built = NULL;
+    if (tree->count == 0) {
+        built = tree;
+        if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+            if (unique > 0 && !cgre_btree_build(tree, nodes, unique)) {
+                built = NULL;
+            }
+        } else {
+            cgre_uint_t bottom = 0;
+            while ((((cgre_uint_t) 2) << bottom) - 1 < unique) {
+                bottom++;
+            }
+            cgre_tree_write_begin(tree);
+            tree->link[CGRE_NODE_HEAD] = cgre_tree_build_nodes(nodes, unique,
+                    0, bottom);
+            tree->count = unique;
+            cgre_tree_write_end(tree);
+        }
+    }
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return built;
+}
+
+/**
+ * @brief Search a locked B+tree for a group of keys walking in step
+ *
+ * All searches cross the same number of levels, so each level fetches the
+ * pages of the whole group before any of them is read.
+ */
+static void cgre_btree_search_group(
+        struct cgre_btree* btree,
+        const cgre_uint_t* keys,
+        struct cgre_node** found,
+        cgre_uint_t count)
+{
+    struct cgre_btree_page* pages[CGRE_NODES_PREFETCH];
+    if (btree == NULL || btree->root == NULL) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            found[idx] = NULL;
+        }
+        return;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        pages[idx] = btree->root;
+    }
+    for (cgre_uint_t level = btree->root->level; level > 0; level--) {
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            pages[idx] = (struct cgre_btree_page*) pages[idx]->slot[
+                    cgre_btree_branch(pages[idx], keys[idx])];
+            __builtin_prefetch(pages[idx]->key);
+            __builtin_prefetch(&(pages[idx]->key[CGRE_TREE_BTREE_ORDER - 1]));
+        }
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        struct cgre_btree_page* leaf = pages[idx];
+        cgre_uint_t pos = cgre_btree_below(leaf->key, leaf->count, keys[idx]);
+        found[idx] = (pos < leaf->count && leaf->key[pos] == keys[idx]) ?
+                (struct cgre_node*) leaf->slot[pos] : NULL;
+    }
+}
+
+/**
+ * @brief Search a locked tree for a group of keys walking in step
+ *
+ * Every search takes one step per round and fetches the member it steps
+ * to, so the cache misses of the group overlap.
+ */
+static void cgre_tree_search_group(
+        struct cgre_node_set* tree,
+        const cgre_uint_t* keys,
+        struct cgre_node** found,
+        cgre_uint_t count)
+{
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        cgre_btree_search_group((struct cgre_btree*) tree->store, keys, found,
+                count);
+        return;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        found[idx] = tree->link[CGRE_NODE_HEAD];
+    }
+    for (cgre_int_t walking = 1; walking;) {
+        walking = 0;
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            struct cgre_node* node = found[idx];
+            if (node != NULL && node->key != keys[idx]) {
+                node = node->link[keys[idx] > node->key];
+                if (node != NULL) {
+                    __builtin_prefetch(node);
+                }
+                found[idx] = node;
+                walking = 1;
+            }
+        }
+    }
+}
+
 /**
  * @brief Delete a node from a tree
  *
@@ -43,15 +1389,29 @@ struct cgre_node* cgre_tree_delete(
 {
     struct cgre_node *nodes[CGRE_TREE_MAX_HEIGHT];
     unsigned char direction[CGRE_TREE_MAX_HEIGHT];
+    struct cgre_node root;
     struct cgre_node* delete_point;
+    struct cgre_node* moved = NULL;
     cgre_int_t height, cmp;
+    cgre_uint_t ranked;
+    if (tree == NULL) {
+        return NULL;
+    }
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        return cgre_btree_delete(tree, key);
+    }
     // We are going to be working on this tree
-    cgre_int_t fail = pthread_mutex_lock(&(tree->lock));
+    cgre_int_t fail = cgre_node_set_lock(tree);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
     }
+    cgre_tree_write_begin(tree);
+    ranked = tree->state & CGRE_TREE_RANKED;
+    // Our root hangs left of a stand-in, so it has a parent like any other
+    root.link[0] = tree->link[CGRE_NODE_HEAD];
     height = 0;
-    delete_point = tree->link[CGRE_NODE_HEAD];
+    delete_point = &root;
     for (cmp = -1; cmp != 0;
          cmp = CGRE_NODE_KEY_CMP(key, delete_point->key))
       {
@@ -61,13 +1421,15 @@ struct cgre_node* cgre_tree_delete(
         direction[height++] = dir;
 
         delete_point = delete_point->link[dir];
-        if (delete_point == NULL)
+        if (delete_point == NULL) {
             // We are done working on this tree
-            fail = pthread_mutex_unlock(&(tree->lock));
+            cgre_tree_write_end(tree);
+            fail = cgre_node_set_unlock(tree);
             if (fail) {
                 CGRE_NODES_LOCK_SET_FAIL(tree->state);
             }
             return NULL;
+        }
       }
 
     if (delete_point->link[1] == NULL) {
@@ -79,12 +1441,13 @@ struct cgre_node* cgre_tree_delete(
 
         if (r->link[0] == NULL) {
             r->link[0] = delete_point->link[0];
-            color = r->dir;
-            r->dir = delete_point->dir;
-            delete_point->dir = color;
+            color = cgre_tree_color(r);
+            cgre_tree_paint(r, cgre_tree_color(delete_point));
+            cgre_tree_paint(delete_point, color);
             nodes[height - 1]->link[direction[height - 1]] = r;
             direction[height] = 1;
             nodes[height++] = r;
+            moved = r;
         } else {
             struct cgre_node *s;
             cgre_int_t j = height++;
@@ -108,9 +1471,21 @@ struct cgre_node* cgre_tree_delete(
             r->link[0] = s->link[1];
             s->link[1] = delete_point->link[1];
 
-            color = s->dir;
-            s->dir = delete_point->dir;
-            delete_point->dir = color;
+            color = cgre_tree_color(s);
+            cgre_tree_paint(s, cgre_tree_color(delete_point));
+            cgre_tree_paint(delete_point, color);
+            moved = s;
+        }
+    }
+    if (ranked) {
+        // The path lost one below it, a successor moved up takes the place
+        for (cgre_int_t idx = 1; idx < height; idx++) {
+            if (nodes[idx] == moved) {
+                nodes[idx]->dir = cgre_tree_color(moved) |
+                    ((cgre_tree_size(delete_point) - 1) << 2);
+            } else {
+                nodes[idx]->dir -= 1 << 2;
+            }
         }
     }
 
@@ -119,7 +1494,7 @@ struct cgre_node* cgre_tree_delete(
             struct cgre_node *x = \
                     nodes[height - 1]->link[direction[height - 1]];
             if (x != NULL && (x->dir & CGRE_TREE_RED)) {
-                x->dir = CGRE_TREE_BLACK;
+                cgre_tree_paint(x, CGRE_TREE_BLACK);
                 break;
             }
             if (height < 2) {
@@ -129,12 +1504,16 @@ struct cgre_node* cgre_tree_delete(
                 struct cgre_node *w = nodes[height - 1]->link[1];
 
                 if (w->dir & CGRE_TREE_RED) {
-                    w->dir = CGRE_TREE_BLACK;
-                    nodes[height - 1]->dir = CGRE_TREE_RED;
+                    cgre_tree_paint(w, CGRE_TREE_BLACK);
+                    cgre_tree_paint(nodes[height - 1], CGRE_TREE_RED);
 
                     nodes[height - 1]->link[1] = w->link[0];
                     w->link[0] = nodes[height - 1];
                     nodes[height - 2]->link[direction[height - 2]] = w;
+                    if (ranked) {
+                        cgre_tree_resize(nodes[height - 1]);
+                        cgre_tree_resize(w);
+                    }
 
                     nodes[height] = nodes[height - 1];
                     direction[height] = 0;
@@ -147,36 +1526,48 @@ struct cgre_node* cgre_tree_delete(
                      || w->link[0]->dir & CGRE_TREE_BLACK)
                     && (w->link[1] == NULL
                         || w->link[1]->dir & CGRE_TREE_BLACK)) {
-                    w->dir = CGRE_TREE_RED;
+                    cgre_tree_paint(w, CGRE_TREE_RED);
                 } else {
                     if (w->link[1] == NULL
                         || w->link[1]->dir & CGRE_TREE_BLACK) {
                         struct cgre_node *y = w->link[0];
-                        y->dir = CGRE_TREE_BLACK;
-                        w->dir = CGRE_TREE_RED;
+                        cgre_tree_paint(y, CGRE_TREE_BLACK);
+                        cgre_tree_paint(w, CGRE_TREE_RED);
                         w->link[0] = y->link[1];
                         y->link[1] = w;
+                        if (ranked) {
+                            // y is recounted by the rotation below
+                            cgre_tree_resize(w);
+                        }
                         w = nodes[height - 1]->link[1] = y;
                     }
-                    w->dir = nodes[height - 1]->dir;
-                    nodes[height -1]->dir = CGRE_TREE_BLACK;
-                    w->link[1]->dir = CGRE_TREE_BLACK;
+                    cgre_tree_paint(w, cgre_tree_color(nodes[height - 1]));
+                    cgre_tree_paint(nodes[height - 1], CGRE_TREE_BLACK);
+                    cgre_tree_paint(w->link[1], CGRE_TREE_BLACK);
 
                     nodes[height - 1]->link[1] = w->link[0];
                     w->link[0] = nodes[height - 1];
                     nodes[height - 2]->link[direction[height - 2]] = w;
+                    if (ranked) {
+                        cgre_tree_resize(nodes[height - 1]);
+                        cgre_tree_resize(w);
+                    }
                     break;
                 }
             } else {
                 struct cgre_node *w = nodes[height - 1]->link[0];
 
                 if (w->dir & CGRE_TREE_RED) {
-                    w->dir = CGRE_TREE_BLACK;
-                    nodes[height - 1]->dir = CGRE_TREE_RED;
+                    cgre_tree_paint(w, CGRE_TREE_BLACK);
+                    cgre_tree_paint(nodes[height - 1], CGRE_TREE_RED);
 
                     nodes[height - 1]->link[0] = w->link[1];
                     w->link[1] = nodes[height - 1];
                     nodes[height - 2]->link[direction[height - 2]] = w;
+                    if (ranked) {
+                        cgre_tree_resize(nodes[height - 1]);
+                        cgre_tree_resize(w);
+                    }
 
                     nodes[height] = nodes[height - 1];
                     direction[height] = 1;
@@ -189,24 +1580,32 @@ struct cgre_node* cgre_tree_delete(
                      || w->link[0]->dir & CGRE_TREE_BLACK)
                     && (w->link[1] == NULL
                         || w->link[1]->dir & CGRE_TREE_BLACK)) {
-                    w->dir = CGRE_TREE_RED;
+                    cgre_tree_paint(w, CGRE_TREE_RED);
                 } else {
                     if (w->link[0] == NULL
                         || w->link[0]->dir & CGRE_TREE_BLACK) {
                         struct cgre_node *y = w->link[1];
-                        y->dir = CGRE_TREE_BLACK;
-                        w->dir = CGRE_TREE_RED;
+                        cgre_tree_paint(y, CGRE_TREE_BLACK);
+                        cgre_tree_paint(w, CGRE_TREE_RED);
                         w->link[1] = y->link[0];
                         y->link[0] = w;
+                        if (ranked) {
+                            // y is recounted by the rotation below
+                            cgre_tree_resize(w);
+                        }
                         w = nodes[height - 1]->link[0] = y;
                     }
-                    w->dir = nodes[height - 1]->dir;
-                    nodes[height - 1]->dir = CGRE_TREE_BLACK;
-                    w->link[0]->dir = CGRE_TREE_BLACK;
+                    cgre_tree_paint(w, cgre_tree_color(nodes[height - 1]));
+                    cgre_tree_paint(nodes[height - 1], CGRE_TREE_BLACK);
+                    cgre_tree_paint(w->link[0], CGRE_TREE_BLACK);
 
                     nodes[height - 1]->link[0] = w->link[1];
                     w->link[1] = nodes[height - 1];
                     nodes[height - 2]->link[direction[height - 2]] = w;
+                    if (ranked) {
+                        cgre_tree_resize(nodes[height - 1]);
+                        cgre_tree_resize(w);
+                    }
                     break;
                 }
             }
@@ -215,9 +1614,11 @@ struct cgre_node* cgre_tree_delete(
 
       }
 
+    tree->link[CGRE_NODE_HEAD] = root.link[0];
     tree->count--;
     // We are done working on this tree
-    fail = pthread_mutex_unlock(&(tree->lock));
+    cgre_tree_write_end(tree);
+    fail = cgre_node_set_unlock(tree);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(tree->state);
     }
@@ -232,12 +1633,9 @@ struct cgre_node* cgre_tree_delete(
  * @return cgre_node pointer of existing or inserted node
  * or NULL if error
  *
- * @note The red-black BST implementation supports a default maximum height of
- * 18, allowing 262144 members.
- *
- * @warning If you are observing segfaults in here,  and you are exceeding 2^18
- * members, try compiling a larger max height with the configuration
- * option `--with-tree-max-height`
+ * @note The red-black tree is kept balanced, so its height never exceeds
+ * twice the bits of `cgre_node_set.count`. The path stacks of insert and
+ * delete are sized from that bound, see `CGRE_TREE_MAX_HEIGHT`.
  */
 struct cgre_node* cgre_tree_insert(
         struct cgre_node_set* tree,
@@ -245,36 +1643,40 @@ struct cgre_node* cgre_tree_insert(
 {
     struct cgre_node *nodes[CGRE_TREE_MAX_HEIGHT];
     unsigned char direction[CGRE_TREE_MAX_HEIGHT];
+    struct cgre_node root;
     cgre_int_t height, cmp;
     struct cgre_node *insert_point;
+    cgre_uint_t ranked;
 
     if (tree == NULL || node == NULL) {
         return NULL;
     }
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        return cgre_btree_insert(tree, node);
+    }
     // We are going to be working on this tree
-    cgre_int_t fail = pthread_mutex_lock(&(tree->lock));
+    cgre_int_t fail = cgre_node_set_lock(tree);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(tree->state);
         return NULL;
     }
+    cgre_tree_write_begin(tree);
+    ranked = tree->state & CGRE_TREE_RANKED;
 
-    // Set the root node if empty 
-    if (tree->link[CGRE_NODE_HEAD] == NULL) {
-        tree->link[CGRE_NODE_HEAD] = node;
-        tree->count++;
-    }
-
-    nodes[0] = tree->link[CGRE_NODE_HEAD];
+    // Our root hangs left of a stand-in, so it has a parent like any other
+    root.link[0] = tree->link[CGRE_NODE_HEAD];
+    nodes[0] = &root;
     direction[0] = 0;
     height = 1;
-    for (insert_point = tree->link[CGRE_NODE_HEAD];
+    for (insert_point = root.link[0];
         insert_point != NULL;
         insert_point = insert_point->link[direction[height - 1]]) {
         // Does this key already exist?
-        cmp = CGRE_NODE_KEY_CMP(insert_point->key, node->key);
+        cmp = CGRE_NODE_KEY_CMP(node->key, insert_point->key);
         if (cmp == 0) {
             // Yes. We are done working on this tree
-            fail = pthread_mutex_unlock(&(tree->lock));
+            cgre_tree_write_end(tree);
+            fail = cgre_node_set_unlock(tree);
             if (fail) {
                 CGRE_NODES_LOCK_SET_FAIL(tree->state);
             }
@@ -286,18 +1688,28 @@ struct cgre_node* cgre_tree_insert(
         direction[height++] = cmp > 0;
     }
 
+    node->link[0] = NULL;
+    node->link[1] = NULL;
+    node->dir = CGRE_TREE_RED | (1 << 2);
     nodes[height - 1]->link[direction[height - 1]] = node;
-    node->dir = CGRE_TREE_BLACK;
     tree->count++;
+    if (ranked) {
+        // Every member on the way down gains one below it
+        for (cgre_int_t idx = 1; idx < height; idx++) {
+            nodes[idx]->dir += 1 << 2;
+        }
+    }
 
+    // Fix up red parents of red nodes
     while (height >= 3 && nodes[height - 1]->dir & CGRE_TREE_RED) {
-        if (nodes[height - 2] == 0) {
+        if (direction[height - 2] == 0) {
             struct cgre_node *y = nodes[height - 2]->link[1];
 
             if (y != NULL && y->dir & CGRE_TREE_RED) {
-                nodes[height - 1]->dir = CGRE_TREE_BLACK;
-                y->dir = CGRE_TREE_BLACK;
-                nodes[height - 2]->dir = CGRE_TREE_RED;
+                // Red uncle, push the red up
+                cgre_tree_paint(nodes[height - 1], CGRE_TREE_BLACK);
+                cgre_tree_paint(y, CGRE_TREE_BLACK);
+                cgre_tree_paint(nodes[height - 2], CGRE_TREE_RED);
                 height -= 2;
             } else {
                 struct cgre_node *x;
@@ -310,23 +1722,32 @@ struct cgre_node* cgre_tree_insert(
                     x->link[1] = y->link[0];
                     y->link[0] = x;
                     nodes[height - 2]->link[0] = y;
+                    if (ranked) {
+                        // y is recounted by the rotation below
+                        cgre_tree_resize(x);
+                    }
                 }
 
                 x = nodes[height - 2];
-                x->dir = CGRE_TREE_RED;
-                y->dir = CGRE_TREE_BLACK;
+                cgre_tree_paint(x, CGRE_TREE_RED);
+                cgre_tree_paint(y, CGRE_TREE_BLACK);
 
                 x->link[0] = y->link[1];
                 y->link[1] = x;
                 nodes[height - 3]->link[direction[height - 3]] = y;
+                if (ranked) {
+                    cgre_tree_resize(x);
+                    cgre_tree_resize(y);
+                }
                 break;
             }
         } else {
             struct cgre_node *y = nodes[height - 2]->link[0];
             if (y != NULL && y->dir & CGRE_TREE_RED) {
-                nodes[height - 1]->dir = CGRE_TREE_BLACK;
-                y->dir = CGRE_TREE_BLACK;
-                nodes[height - 2]->dir = CGRE_TREE_RED;
+                // Red uncle, push the red up
+                cgre_tree_paint(nodes[height - 1], CGRE_TREE_BLACK);
+                cgre_tree_paint(y, CGRE_TREE_BLACK);
+                cgre_tree_paint(nodes[height - 2], CGRE_TREE_RED);
                 height -= 2;
             } else {
                 struct cgre_node *x;
@@ -339,22 +1760,32 @@ struct cgre_node* cgre_tree_insert(
                     x->link[0] = y->link[1];
                     y->link[1] = x;
                     nodes[height - 2]->link[1] = y;
+                    if (ranked) {
+                        // y is recounted by the rotation below
+                        cgre_tree_resize(x);
+                    }
                 }
 
                 x = nodes[height - 2];
-                x->dir = CGRE_TREE_RED;
-                y->dir = CGRE_TREE_BLACK;
+                cgre_tree_paint(x, CGRE_TREE_RED);
+                cgre_tree_paint(y, CGRE_TREE_BLACK);
 
                 x->link[1] = y->link[0];
                 y->link[0] = x;
                 nodes[height - 3]->link[direction[height - 3]] = y;
+                if (ranked) {
+                    cgre_tree_resize(x);
+                    cgre_tree_resize(y);
+                }
                 break;
             }
         }
     }
-    tree->link[CGRE_NODE_HEAD]->dir = CGRE_TREE_BLACK;
+    tree->link[CGRE_NODE_HEAD] = root.link[0];
+    cgre_tree_paint(tree->link[CGRE_NODE_HEAD], CGRE_TREE_BLACK);
     // We are done working on this tree
-    fail = pthread_mutex_unlock(&(tree->lock));
+    cgre_tree_write_end(tree);
+    fail = cgre_node_set_unlock(tree);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(tree->state);
     }
@@ -362,6 +1793,121 @@ struct cgre_node* cgre_tree_insert(
     return node;
 }
 
+/**
+ * @brief Find the member with the lowest key at or above a key
+ *
+ * @param[in] tree Tree for search
+ * @param[in] key Lowest key to accept
+ * @return cgre_node pointer or NULL if no key qualifies or error
+ */
+struct cgre_node* cgre_tree_lower_bound(
+        struct cgre_node_set* tree,
+        cgre_uint_t key)
+{
+    struct cgre_node* found = NULL;
+    if (tree == NULL) {
+        return NULL;
+    }
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
+    }
+    cgre_tree_collect(tree, key, CGRE_UINT_MAX, &found, 1);
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return found;
+}
+
+/**
+ * @brief Copy the members with keys in [low, high) in key order
+ *
+ * The tree is locked once for the whole scan. A scan stops when `members`
+ * is full, continue it from just past the last key copied.
+ *
+ * @code{.c}
+ * struct cgre_node* band[64];
+ * cgre_uint_t found;
+ * do {
+ *     found = cgre_tree_range(&tree, low, high, band, 64);
+ *     // Use band[0] to band[found - 1]
+ *     if (found > 0) {
+ *         low = band[found - 1]->key + 1;
+ *     }
+ * } while (found == 64);
+ * @endcode
+ *
+ * @param[in] tree Tree to scan
+ * @param[in] low Lowest key to copy
+ * @param[in] high Key past the highest key to copy
+ * @param[out] members Buffer for the members found
+ * @param[in] size Number of members the buffer holds
+ * @return number of members copied or 0 on error
+ */
+cgre_uint_t cgre_tree_range(
+        struct cgre_node_set* tree,
+        cgre_uint_t low,
+        cgre_uint_t high,
+        struct cgre_node** members,
+        cgre_uint_t size)
+{
+    cgre_uint_t found;
+    if (tree == NULL || members == NULL || low >= high) {
+        return 0;
+    }
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return 0;
+    }
+    found = cgre_tree_collect(tree, low, high - 1, members, size);
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return found;
+}
+
+/**
+ * @brief Count the members with keys below a key
+ *
+ * The count is also the index `cgre_tree_select()` finds the member with
+ * that key at. O(log n) with `CGRE_TREE_RANKED`, otherwise a walk over the
+ * members below the key.
+ *
+ * @param[in] tree Tree to count in
+ * @param[in] key Key to rank, need not be a member
+ * @return number of members with lower keys or 0 on error
+ */
+cgre_uint_t cgre_tree_rank(
+        struct cgre_node_set* tree,
+        cgre_uint_t key)
+{
+    cgre_uint_t below;
+    if (tree == NULL) {
+        return 0;
+    }
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return 0;
+    }
+    below = cgre_tree_below(tree, key);
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return below;
+}
+
 /**
  * @brief Replace existing node with same key
  *
@@ -374,16 +1920,21 @@ struct cgre_node* cgre_tree_replace(
         struct cgre_node* node)
 {
     struct cgre_node *old;
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        return cgre_btree_replace(tree, node);
+    }
     old = cgre_tree_search(tree, node->key);
     // We will be working on this tree
-    cgre_int_t fail = pthread_mutex_lock(&(tree->lock));
+    cgre_int_t fail = cgre_node_set_lock(tree);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(tree->state);
         return NULL;
     }
+    cgre_tree_write_begin(tree);
     if (old != NULL) {
         node->link[0] = old->link[0];
         node->link[1] = old->link[1];
+        node->dir = old->dir;
         if (old == tree->link[CGRE_NODE_HEAD]) {
             tree->link[CGRE_NODE_HEAD] = node;
         } else {
@@ -410,7 +1961,8 @@ struct cgre_node* cgre_tree_replace(
         }
     }
     // We are done working on this tree
-    fail = pthread_mutex_unlock(&(tree->lock));
+    cgre_tree_write_end(tree);
+    fail = cgre_node_set_unlock(tree);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(tree->state);
     }
@@ -431,8 +1983,17 @@ struct cgre_node* cgre_tree_search(
     if (tree == NULL) {
         return NULL;
     }
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_BTREE) {
+        return cgre_btree_search(tree, key);
+    }
+    if (CGRE_TREE_MODE(tree->state) == CGRE_TREE_OPTIMISTIC) {
+        struct cgre_node* found;
+        if (cgre_tree_search_optimistic(tree, key, &found)) {
+            return found;
+        }
+    }
     // We are going to be working on this tree
-    cgre_int_t fail = pthread_mutex_lock(&(tree->lock));
+    cgre_int_t fail = cgre_node_set_lock(tree);
     if (fail) {
         CGRE_NODES_LOCK_SET_FAIL(tree->state);
         return NULL;
@@ -444,11 +2005,105 @@ struct cgre_node* cgre_tree_search(
             node = node->link[1];
         } else if (key == node->key) {
             // We are done working on this tree
-            pthread_mutex_unlock(&tree->lock);
+            cgre_node_set_unlock(tree);
             return node;
         }
     }
     // We are done working on this tree
-    pthread_mutex_unlock(&tree->lock);
+    cgre_node_set_unlock(tree);
     return NULL;
 }
+
+/**
+ * @brief Search for many keys under one lock
+ *
+ * Keys are searched `CGRE_NODES_PREFETCH` at a time with their walks
+ * interleaved, which hides much of the latency of each step.
+ *
+ * @param[in] tree Tree for search
+ * @param[in] keys Keys to find
+ * @param[out] found Node found for each key or NULL
+ * @param[in] count Number of keys
+ * @return number of keys found
+ */
+cgre_uint_t cgre_tree_search_many(
+        struct cgre_node_set* tree,
+        const cgre_uint_t* keys,
+        struct cgre_node** found,
+        cgre_uint_t count)
+{
+    cgre_uint_t hits = 0;
+    if (tree == NULL || keys == NULL || found == NULL) {
+        return 0;
+    }
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return 0;
+    }
+    for (cgre_uint_t idx = 0; idx < count; idx += CGRE_NODES_PREFETCH) {
+        cgre_uint_t group = count - idx < CGRE_NODES_PREFETCH ?
+                count - idx : CGRE_NODES_PREFETCH;
+        cgre_tree_search_group(tree, &(keys[idx]), &(found[idx]), group);
+        for (cgre_uint_t member = idx; member < idx + group; member++) {
+            hits += found[member] != NULL;
+        }
+    }
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return hits;
+}
+
+/**
+ * @brief Find the member at an index in key order
+ *
+ * O(log n) with `CGRE_TREE_RANKED`, otherwise a walk over the members below
+ * the index.
+ *
+ * @param[in] tree Tree to search
+ * @param[in] index Position from the lowest key, starting at 0
+ * @return cgre_node pointer or NULL if index is past the last member or error
+ */
+struct cgre_node* cgre_tree_select(
+        struct cgre_node_set* tree,
+        cgre_uint_t index)
+{
+    struct cgre_node* found;
+    if (tree == NULL) {
+        return NULL;
+    }
+    // We are going to be working on this tree
+    cgre_int_t fail = cgre_node_set_lock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+        return NULL;
+    }
+    found = cgre_tree_nth(tree, index);
+    // We are done working on this tree
+    fail = cgre_node_set_unlock(tree);
+    if (fail) {
+        CGRE_NODES_LOCK_SET_FAIL(tree->state);
+    }
+    return found;
+}
+
+/**
+ * @brief Find the member with the lowest key above a key
+ *
+ * @param[in] tree Tree for search
+ * @param[in] key Key to pass
+ * @return cgre_node pointer or NULL if no key qualifies or error
+ */
+struct cgre_node* cgre_tree_upper_bound(
+        struct cgre_node_set* tree,
+        cgre_uint_t key)
+{
+    if (key == CGRE_UINT_MAX) {
+        return NULL;
+    }
+    return cgre_tree_lower_bound(tree, key + 1);
+}
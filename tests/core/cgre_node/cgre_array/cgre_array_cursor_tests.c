@@ -0,0 +1,109 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+int cgre_array_cursor_tests();
+
+int cgre_array_cursor_mode_tests(
+        cgre_uint_t mode);
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_array_cursor_tests()
+    );
+}
+
+int cgre_array_cursor_mode_tests(
+        cgre_uint_t mode)
+{
+    const cgre_uint_t total = 100;
+    struct cgre_node_set array;
+    struct cgre_array_cursor cursor;
+    cgre_node_set_initialize(&array);
+    CGRE_NODES_MODE_SET_VALUE(array.state, mode);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * total);
+    // Check that an empty array has nothing to walk
+    if (cgre_array_cursor_begin(&cursor, &array) != NULL ||
+            cgre_array_cursor_next(&cursor) != NULL ||
+            cgre_array_cursor_prev(&cursor) != NULL) {
+        return 1;
+    }
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+        cgre_array_add(&array, &(items[idx]));
+    }
+    // Check that next visits every member in order then stops
+    cgre_uint_t idx = 0;
+    for (struct cgre_node* node = cgre_array_cursor_begin(&cursor, &array);
+            node != NULL;
+            node = cgre_array_cursor_next(&cursor)) {
+        if (node != &(items[idx]) || cursor.index != idx) {
+            return 2;
+        }
+        idx++;
+    }
+    if (idx != total || cgre_array_cursor_next(&cursor) != NULL ||
+            cursor.index != total) {
+        return 4;
+    }
+    // Check that prev from past the tail visits every member in reverse
+    for (struct cgre_node* node = cgre_array_cursor_prev(&cursor);
+            node != NULL;
+            node = cgre_array_cursor_prev(&cursor)) {
+        idx--;
+        if (node != &(items[idx]) || cursor.index != idx) {
+            return 8;
+        }
+    }
+    if (idx != 0 || cgre_array_cursor_prev(&cursor) != NULL ||
+            cursor.index != CGRE_ARRAY_CURSOR_BEFORE) {
+        return 16;
+    }
+    // Check that next from before the head is the head again
+    if (cgre_array_cursor_next(&cursor) != &(items[0]) ||
+            cgre_array_cursor_next(&cursor) != &(items[1]) ||
+            cgre_array_cursor_prev(&cursor) != &(items[0])) {
+        return 32;
+    }
+    cgre_node_set_uninitialize(&array);
+    free(items);
+    return 0;
+}
+
+int cgre_array_cursor_tests()
+{
+    return (
+        cgre_array_cursor_mode_tests(CGRE_ARRAY_LINKED) |
+        (cgre_array_cursor_mode_tests(CGRE_ARRAY_VECTOR) << 6)
+    );
+}
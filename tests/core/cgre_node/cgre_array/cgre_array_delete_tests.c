@@ -73,8 +73,8 @@ int cgre_array_delete_tests()
         return 8;
     }
     // Check that middle is correctly updated
-    if (array.link[CGRE_NODE_MIDDLE] != &item1 ||
-            array.link[CGRE_NODE_MIDDLE] != &item1) {
+    if (array.link[CGRE_NODE_MIDDLE] != &item2 ||
+            array.link[CGRE_NODE_MIDDLE] != &item2) {
         return 32;
     }
     return 0;
@@ -0,0 +1,124 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+int cgre_array_finger_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_array_finger_tests()
+    );
+}
+
+int cgre_array_finger_tests()
+{
+    const cgre_uint_t total = 500;
+    struct cgre_node_set array;
+    cgre_node_set_initialize(&array);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * total * 2);
+    struct cgre_node** expect = malloc(sizeof(struct cgre_node*) * total);
+    cgre_uint_t count = 0;
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+        cgre_array_add(&array, &(items[idx]));
+        expect[count++] = &(items[idx]);
+    }
+    // Check that nearby and far accesses agree with the members in order
+    srand(17);
+    for (cgre_uint_t round = 0; round < total * 4; round++) {
+        cgre_uint_t index = (round & 1) ?
+            (cgre_uint_t) rand() % count :
+            (cgre_uint_t) (round >> 1) % count;
+        if (cgre_array_get(&array, index) != expect[index]) {
+            return 1;
+        }
+    }
+    // Check that sets keep the walk consistent, including the ends
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        cgre_uint_t index = (idx < 2) ?
+            idx * (count - 1) : (cgre_uint_t) rand() % count;
+        cgre_node_initialize(&(items[total + idx]), total + idx, NULL);
+        if (cgre_array_set(&array, &(items[total + idx]), index) !=
+                expect[index]) {
+            return 2;
+        }
+        expect[index] = &(items[total + idx]);
+        if (cgre_array_get(&array, (index + 1) % count) !=
+                expect[(index + 1) % count]) {
+            return 4;
+        }
+    }
+    // Check that deletes anywhere keep every index and the ends reachable
+    cgre_uint_t last = 0;
+    while (count > 0) {
+        cgre_uint_t index = (count % 3 == 0) ? 0 :
+            (count % 3 == 1) ? count - 1 : (cgre_uint_t) rand() % count;
+        // Delete the same index twice in a row now and then
+        if ((count & 4) && last < count) {
+            index = last;
+        }
+        last = index;
+        if (cgre_array_delete(&array, index) != expect[index]) {
+            return 8;
+        }
+        for (cgre_uint_t move = index; move + 1 < count; move++) {
+            expect[move] = expect[move + 1];
+        }
+        count--;
+        if (array.count != count) {
+            return 16;
+        }
+        // Leave the finger where the delete put it for the next one
+        if (count & 4) {
+            continue;
+        }
+        for (cgre_uint_t idx = 0; idx < count; idx += 1 + (count >> 4)) {
+            if (cgre_array_get(&array, idx) != expect[idx]) {
+                return 32;
+            }
+        }
+        if (count > 0 && (array.link[CGRE_NODE_HEAD] != expect[0] ||
+                array.link[CGRE_NODE_TAIL] != expect[count - 1] ||
+                array.link[CGRE_NODE_MIDDLE] !=
+                    expect[(count - 1) >> 1])) {
+            return 64;
+        }
+    }
+    if (cgre_array_get(&array, 0) != NULL) {
+        return 128;
+    }
+    cgre_node_set_uninitialize(&array);
+    free(expect);
+    free(items);
+    return 0;
+}
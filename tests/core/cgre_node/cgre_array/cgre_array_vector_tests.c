@@ -0,0 +1,91 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+int cgre_array_vector_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_array_vector_tests()
+    );
+}
+
+int cgre_array_vector_tests()
+{
+    const cgre_uint_t total = 1000;
+    struct cgre_node_set array;
+    cgre_node_set_initialize(&array);
+    CGRE_NODES_MODE_SET_VALUE(array.state, CGRE_ARRAY_VECTOR);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * total);
+    struct cgre_node swap;
+    cgre_node_initialize(&swap, total, NULL);
+    // Check that adds succeed while the buffer grows
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+        if (cgre_array_add(&array, &(items[idx])) != &(items[idx])) {
+            return 1;
+        }
+    }
+    if (array.count != total || items[1].link[CGRE_NODE_HEAD] != NULL) {
+        return 2;
+    }
+    // Check that every index is reachable and out of bounds is not
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        if (cgre_array_get(&array, idx) != &(items[idx])) {
+            return 4;
+        }
+    }
+    if (cgre_array_get(&array, total) != NULL) {
+        return 8;
+    }
+    // Check that set replaces in place
+    if (cgre_array_set(&array, &swap, 10) != &(items[10]) ||
+            cgre_array_get(&array, 10) != &swap ||
+            cgre_array_set(&array, &swap, total) != NULL) {
+        return 16;
+    }
+    // Check that delete closes the gap
+    if (cgre_array_delete(&array, 0) != &(items[0]) ||
+            cgre_array_get(&array, 0) != &(items[1]) ||
+            cgre_array_delete(&array, total - 2) != &(items[total - 1]) ||
+            cgre_array_get(&array, total - 3) != &(items[total - 2]) ||
+            cgre_array_delete(&array, total) != NULL ||
+            array.count != total - 2) {
+        return 32;
+    }
+    if (cgre_node_set_uninitialize(&array) == NULL || array.store != NULL) {
+        return 64;
+    }
+    free(items);
+    return 0;
+}
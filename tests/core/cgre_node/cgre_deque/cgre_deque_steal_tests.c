@@ -0,0 +1,117 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#define STEAL_THREADS 4
+#define STEAL_MEMBERS 200000
+
+int cgre_deque_steal_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_deque_steal_tests()
+    );
+}
+
+struct steal_worker {
+    struct cgre_node_set* deque;
+    cgre_uint_t* seen;
+    cgre_uint_t* done;
+};
+
+void* steal_thief(void* arg)
+{
+    struct steal_worker* worker = (struct steal_worker*) arg;
+    for (;;) {
+        struct cgre_node* node = cgre_deque_steal(worker->deque);
+        if (node != NULL) {
+            __atomic_fetch_add(&(worker->seen[node->key]), 1,
+                    __ATOMIC_RELAXED);
+        } else if (__atomic_load_n(worker->done, __ATOMIC_ACQUIRE)) {
+            break;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+int cgre_deque_steal_tests()
+{
+    struct cgre_node_set deque;
+    cgre_node_set_initialize(&deque);
+    // Start small so the ring grows while thieves are reading it
+    cgre_deque_reserve(&deque, 2);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * STEAL_MEMBERS);
+    cgre_uint_t* seen = calloc(STEAL_MEMBERS, sizeof(cgre_uint_t));
+    cgre_uint_t done = 0;
+    struct steal_worker worker = {&deque, seen, &done};
+    pthread_t thieves[STEAL_THREADS];
+    for (cgre_uint_t idx = 0; idx < STEAL_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+    }
+    for (int thread = 0; thread < STEAL_THREADS; thread++) {
+        pthread_create(&(thieves[thread]), NULL, steal_thief, &worker);
+    }
+    // Check that the owner and the thieves take every member exactly once
+    for (cgre_uint_t idx = 0; idx < STEAL_MEMBERS; idx++) {
+        if (cgre_deque_push(&deque, &(items[idx])) != &(items[idx])) {
+            return 1;
+        }
+        // Work through some of our own members now and then
+        if ((idx % 7) == 0) {
+            for (int pops = 0; pops < 3; pops++) {
+                struct cgre_node* node = cgre_deque_pop(&deque);
+                if (node != NULL) {
+                    __atomic_fetch_add(&(seen[node->key]), 1,
+                            __ATOMIC_RELAXED);
+                }
+            }
+        }
+    }
+    __atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+    for (int thread = 0; thread < STEAL_THREADS; thread++) {
+        pthread_join(thieves[thread], NULL);
+    }
+    for (cgre_uint_t idx = 0; idx < STEAL_MEMBERS; idx++) {
+        if (seen[idx] != 1) {
+            return 2;
+        }
+    }
+    cgre_node_set_uninitialize(&deque);
+    free(seen);
+    free(items);
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+#define DEQUE_MEMBERS 1000
+
+int cgre_deque_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_deque_tests()
+    );
+}
+
+int cgre_deque_tests()
+{
+    struct cgre_node_set deque;
+    cgre_node_set_initialize(&deque);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * DEQUE_MEMBERS);
+    for (cgre_uint_t idx = 0; idx < DEQUE_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+    }
+    // Check that an unreserved set is refused
+    if (cgre_deque_push(&deque, &(items[0])) != NULL ||
+            cgre_deque_pop(&deque) != NULL ||
+            cgre_deque_steal(&deque) != NULL) {
+        return 1;
+    }
+    // Check that reserve only prepares the set once
+    if (cgre_deque_reserve(&deque, 0) != NULL ||
+            cgre_deque_reserve(&deque, 3) != &deque ||
+            cgre_deque_reserve(&deque, 8) != NULL) {
+        return 2;
+    }
+    // Check that an empty deque stays empty from both ends
+    if (cgre_deque_pop(&deque) != NULL ||
+            cgre_deque_steal(&deque) != NULL ||
+            cgre_deque_pop(&deque) != NULL) {
+        return 4;
+    }
+    // Check that pushes grow the ring well past its capacity
+    for (cgre_uint_t idx = 0; idx < DEQUE_MEMBERS; idx++) {
+        if (cgre_deque_push(&deque, &(items[idx])) != &(items[idx])) {
+            return 8;
+        }
+    }
+    // Check that thieves take the oldest and the owner the newest
+    for (cgre_uint_t idx = 0; idx < DEQUE_MEMBERS / 2; idx++) {
+        if (cgre_deque_steal(&deque) != &(items[idx]) ||
+                cgre_deque_pop(&deque) != &(items[DEQUE_MEMBERS - 1 - idx])) {
+            return 16;
+        }
+    }
+    if (cgre_deque_pop(&deque) != NULL || cgre_deque_steal(&deque) != NULL) {
+        return 32;
+    }
+    // Check that the ends wrap around the ring as members come and go
+    struct cgre_node** model = malloc(
+            sizeof(struct cgre_node*) * DEQUE_MEMBERS);
+    cgre_uint_t top = 0;
+    cgre_uint_t bottom = 0;
+    for (cgre_uint_t idx = 0; idx < DEQUE_MEMBERS; idx++) {
+        cgre_deque_push(&deque, &(items[idx]));
+        model[bottom++] = &(items[idx]);
+        if ((idx & 3) == 3 && (cgre_deque_steal(&deque) != model[top++] ||
+                    cgre_deque_pop(&deque) != model[--bottom])) {
+            return 64;
+        }
+    }
+    while (top < bottom) {
+        if (cgre_deque_steal(&deque) != model[top++]) {
+            return 128;
+        }
+    }
+    if (cgre_deque_steal(&deque) != NULL) {
+        return 128;
+    }
+    free(model);
+    cgre_node_set_uninitialize(&deque);
+    free(items);
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#define EPOCH_READERS 3
+#define EPOCH_ROUNDS 20000
+#define EPOCH_POISON 0xdead
+
+int cgre_epoch_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_epoch_tests()
+    );
+}
+
+struct epoch_shared {
+    struct cgre_epoch* epoch;
+    struct cgre_node* current;
+    cgre_uint_t stage;
+    cgre_uint_t done;
+    cgre_uint_t failed;
+};
+
+void epoch_count(void* context, struct cgre_node* node)
+{
+    *((cgre_uint_t*) context) += 1;
+}
+
+void epoch_poison(void* context, struct cgre_node* node)
+{
+    __atomic_add_fetch((cgre_uint_t*) context, 1, __ATOMIC_RELAXED);
+    node->key = EPOCH_POISON;
+    free(node);
+}
+
+void* epoch_holder_run(void* arg)
+{
+    struct epoch_shared* shared = (struct epoch_shared*) arg;
+    cgre_epoch_enter(shared->epoch);
+    __atomic_store_n(&(shared->stage), 1, __ATOMIC_RELEASE);
+    while (__atomic_load_n(&(shared->stage), __ATOMIC_ACQUIRE) != 2) {
+        sched_yield();
+    }
+    cgre_epoch_leave(shared->epoch);
+    return NULL;
+}
+
+void* epoch_reader_run(void* arg)
+{
+    struct epoch_shared* shared = (struct epoch_shared*) arg;
+    while (!__atomic_load_n(&(shared->done), __ATOMIC_ACQUIRE)) {
+        cgre_epoch_enter(shared->epoch);
+        struct cgre_node* node = __atomic_load_n(&(shared->current),
+                __ATOMIC_ACQUIRE);
+        // A node released under the reader would read as poisoned
+        if (node->key == EPOCH_POISON) {
+            __atomic_store_n(&(shared->failed), 1, __ATOMIC_RELAXED);
+        }
+        cgre_epoch_leave(shared->epoch);
+    }
+    return NULL;
+}
+
+int cgre_epoch_tests()
+{
+    struct cgre_epoch epoch;
+    struct cgre_node items[10];
+    cgre_uint_t released = 0;
+    if (cgre_epoch_initialize(&epoch, epoch_count, &released) != &epoch) {
+        return 1;
+    }
+    // Retired nodes wait until they are collected
+    for (cgre_uint_t idx = 0; idx < 10; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+        if (cgre_epoch_retire(&epoch, &(items[idx])) != &(items[idx]) ||
+                released != 0) {
+            return 2;
+        }
+    }
+    // Without readers everything goes at once
+    if (cgre_epoch_collect(&epoch) != 10 || released != 10) {
+        return 4;
+    }
+    // Critical sections nest
+    cgre_epoch_enter(&epoch);
+    cgre_epoch_enter(&epoch);
+    cgre_epoch_leave(&epoch);
+    cgre_epoch_leave(&epoch);
+    // A reader inside its critical section holds back the release
+    struct epoch_shared shared = {&epoch, NULL, 0, 0, 0};
+    pthread_t holder;
+    pthread_create(&holder, NULL, epoch_holder_run, &shared);
+    while (__atomic_load_n(&(shared.stage), __ATOMIC_ACQUIRE) != 1) {
+        sched_yield();
+    }
+    for (cgre_uint_t idx = 0; idx < 10; idx++) {
+        cgre_epoch_retire(&epoch, &(items[idx]));
+    }
+    if (cgre_epoch_collect(&epoch) != 0 || released != 10) {
+        return 8;
+    }
+    __atomic_store_n(&(shared.stage), 2, __ATOMIC_RELEASE);
+    pthread_join(holder, NULL);
+    if (cgre_epoch_collect(&epoch) != 10 || released != 20) {
+        return 16;
+    }
+    // Nodes still in limbo are released with the domain
+    cgre_epoch_retire(&epoch, &(items[0]));
+    cgre_epoch_uninitialize(&epoch);
+    if (released != 21) {
+        return 32;
+    }
+    // Readers never see a node released while a writer replaces it
+    released = 0;
+    cgre_epoch_initialize(&epoch, epoch_poison, &released);
+    shared.current = malloc(sizeof(struct cgre_node));
+    cgre_node_initialize(shared.current, 0, NULL);
+    pthread_t readers[EPOCH_READERS];
+    for (int idx = 0; idx < EPOCH_READERS; idx++) {
+        pthread_create(&(readers[idx]), NULL, epoch_reader_run, &shared);
+    }
+    for (cgre_uint_t idx = 1; idx <= EPOCH_ROUNDS; idx++) {
+        struct cgre_node* node = malloc(sizeof(struct cgre_node));
+        cgre_node_initialize(node, idx, NULL);
+        struct cgre_node* old = __atomic_exchange_n(&(shared.current), node,
+                __ATOMIC_ACQ_REL);
+        if (cgre_epoch_retire(&epoch, old) != old) {
+            return 64;
+        }
+    }
+    __atomic_store_n(&(shared.done), 1, __ATOMIC_RELEASE);
+    for (int idx = 0; idx < EPOCH_READERS; idx++) {
+        pthread_join(readers[idx], NULL);
+    }
+    cgre_epoch_collect(&epoch);
+    cgre_epoch_uninitialize(&epoch);
+    free(shared.current);
+    if (shared.failed ||
+            __atomic_load_n(&released, __ATOMIC_RELAXED) != EPOCH_ROUNDS) {
+        return 128;
+    }
+    return 0;
+}
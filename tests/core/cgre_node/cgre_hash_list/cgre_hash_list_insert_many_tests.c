@@ -0,0 +1,92 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+
+#define MANY_MEMBERS 500
+
+int cgre_hash_list_insert_many_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_hash_list_insert_many_tests()
+    );
+}
+
+int cgre_hash_list_insert_many_mode_tests(cgre_uint_t mode)
+{
+    struct cgre_node_set list1;
+    struct cgre_node members[MANY_MEMBERS];
+    struct cgre_node repeat1;
+    struct cgre_node* batch[MANY_MEMBERS];
+    cgre_node_set_initialize(&list1);
+    CGRE_NODES_MODE_SET_VALUE(list1.state, mode);
+    for (cgre_uint_t idx = 0; idx < MANY_MEMBERS; idx++) {
+        cgre_node_initialize(&(members[idx]), idx * 3 + 1, NULL);
+        batch[idx] = &(members[idx]);
+    }
+    // The batch repeats a key it already holds
+    cgre_node_initialize(&repeat1, members[5].key, NULL);
+    batch[MANY_MEMBERS - 1] = &repeat1;
+    if (cgre_hash_list_insert_many(&list1, batch, MANY_MEMBERS) !=
+            MANY_MEMBERS - 1 || list1.count != MANY_MEMBERS - 1 ||
+            batch[MANY_MEMBERS - 1] != NULL || batch[5] != &(members[5])) {
+        return 1;
+    }
+    for (cgre_uint_t idx = 0; idx + 1 < MANY_MEMBERS; idx++) {
+        if (cgre_hash_list_search(&list1, members[idx].key) !=
+                &(members[idx])) {
+            return 2;
+        }
+    }
+    // Nothing new the second time
+    batch[0] = &repeat1;
+    if (cgre_hash_list_insert_many(&list1, batch, 1) != 0 ||
+            batch[0] != NULL) {
+        return 4;
+    }
+    cgre_node_set_uninitialize(&list1);
+    return 0;
+}
+
+int cgre_hash_list_insert_many_tests()
+{
+    int fail;
+    if ((fail = cgre_hash_list_insert_many_mode_tests(
+                    CGRE_HASH_LIST_SORTED)) ||
+            (fail = cgre_hash_list_insert_many_mode_tests(
+                    CGRE_HASH_LIST_TABLE)) ||
+            (fail = cgre_hash_list_insert_many_mode_tests(
+                    CGRE_HASH_LIST_SKIP))) {
+        return fail;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+#define SKIP_MEMBERS 5000
+
+int cgre_hash_list_skip_tests();
+int cgre_hash_list_skip_churn_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_hash_list_skip_tests() | // Error 1-256
+        cgre_hash_list_skip_churn_tests() // Error 512
+    );
+}
+
+int cgre_hash_list_skip_tests()
+{
+    struct cgre_node_set list;
+    cgre_node_set_initialize(&list);
+    CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_SKIP);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * SKIP_MEMBERS);
+    struct cgre_node dupe;
+    cgre_node_initialize(&dupe, 7 * 10, NULL);
+    struct cgre_node swap;
+    cgre_node_initialize(&swap, 7 * 20, NULL);
+    if (cgre_hash_list_search(&list, 7) != NULL ||
+            cgre_hash_list_delete(&list, 7) != NULL) {
+        return 1;
+    }
+    // Check that inserts out of order succeed
+    for (cgre_uint_t idx = 0; idx < SKIP_MEMBERS; idx++) {
+        cgre_uint_t slot = (idx * 7919) % SKIP_MEMBERS;
+        cgre_node_initialize(&(items[slot]), slot * 7, NULL);
+        if (cgre_hash_list_insert(&list, &(items[slot])) != &(items[slot])) {
+            return 1;
+        }
+    }
+    if (list.count != SKIP_MEMBERS) {
+        return 2;
+    }
+    // Check that duplicate key insert is NULL
+    if (cgre_hash_list_insert(&list, &dupe) != NULL) {
+        return 4;
+    }
+    // Check that every member is found and missing keys are not
+    for (cgre_uint_t idx = 0; idx < SKIP_MEMBERS; idx++) {
+        if (cgre_hash_list_search(&list, idx * 7) != &(items[idx]) ||
+                cgre_hash_list_search(&list, idx * 7 + 1) != NULL) {
+            return 8;
+        }
+    }
+    // Check that replace swaps the member in place
+    if (cgre_hash_list_replace(&list, &swap) != &(items[20]) ||
+            cgre_hash_list_search(&list, 7 * 20) != &swap ||
+            items[19].link[CGRE_NODE_TAIL] != &swap) {
+        return 16;
+    }
+    // Check that deletes only remove their own key
+    for (cgre_uint_t idx = 1; idx < SKIP_MEMBERS; idx += 2) {
+        if (cgre_hash_list_delete(&list, idx * 7) != &(items[idx])) {
+            return 32;
+        }
+    }
+    if (cgre_hash_list_delete(&list, 7) != NULL ||
+            list.count != SKIP_MEMBERS - (SKIP_MEMBERS >> 1)) {
+        return 64;
+    }
+    // Check that the members are still linked in key order both ways
+    cgre_uint_t seen = 0;
+    for (struct cgre_node* node = list.link[CGRE_NODE_HEAD]; node != NULL;
+            node = node->link[CGRE_NODE_TAIL]) {
+        if (node->key != seen * 14 || (node->link[CGRE_NODE_TAIL] == NULL ?
+                list.link[CGRE_NODE_TAIL] != node :
+                node->link[CGRE_NODE_TAIL]->link[CGRE_NODE_HEAD] != node)) {
+            return 128;
+        }
+        seen++;
+    }
+    if (seen != list.count) {
+        return 128;
+    }
+    if (cgre_node_set_uninitialize(&list) == NULL || list.store != NULL) {
+        return 256;
+    }
+    free(items);
+    return 0;
+}
+
+int cgre_hash_list_skip_churn_tests()
+{
+    struct cgre_node_set list;
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * SKIP_MEMBERS);
+    char* present = calloc(SKIP_MEMBERS, 1);
+    cgre_uint_t seed = 1;
+    cgre_node_set_initialize(&list);
+    CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_SKIP);
+    for (cgre_uint_t idx = 0; idx < SKIP_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+    }
+    // Random inserts and deletes, towers are released and reused
+    for (cgre_uint_t idx = 0; idx < 20 * SKIP_MEMBERS; idx++) {
+        seed = seed * 1664525u + 1013904223u;
+        cgre_uint_t slot = (seed >> 8) % SKIP_MEMBERS;
+        struct cgre_node* expected = present[slot] ? &(items[slot]) : NULL;
+        if (cgre_hash_list_search(&list, slot) != expected) {
+            return 512;
+        }
+        if (present[slot]) {
+            if (cgre_hash_list_delete(&list, slot) != expected) {
+                return 512;
+            }
+        } else if (cgre_hash_list_insert(&list, &(items[slot])) !=
+                &(items[slot])) {
+            return 512;
+        }
+        present[slot] = !present[slot];
+    }
+    cgre_node_set_uninitialize(&list);
+    free(present);
+    free(items);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+int cgre_hash_list_table_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_hash_list_table_tests()
+    );
+}
+
+int cgre_hash_list_table_tests()
+{
+    const cgre_uint_t total = 5000;
+    struct cgre_node_set list;
+    cgre_node_set_initialize(&list);
+    CGRE_NODES_MODE_SET_VALUE(list.state, CGRE_HASH_LIST_TABLE);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * total);
+    struct cgre_node dupe;
+    cgre_node_initialize(&dupe, 7 * 10, NULL);
+    struct cgre_node swap;
+    cgre_node_initialize(&swap, 7 * 20, NULL);
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        cgre_node_initialize(&(items[idx]), idx * 7, NULL);
+    }
+    // Check that inserts succeed while the table grows
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        if (cgre_hash_list_insert(&list, &(items[idx])) != &(items[idx])) {
+            return 1;
+        }
+    }
+    if (list.count != total) {
+        return 2;
+    }
+    // Check that duplicate key insert is NULL
+    if (cgre_hash_list_insert(&list, &dupe) != NULL) {
+        return 4;
+    }
+    // Check that every member is found and missing keys are not
+    for (cgre_uint_t idx = 0; idx < total; idx++) {
+        if (cgre_hash_list_search(&list, idx * 7) != &(items[idx]) ||
+                cgre_hash_list_search(&list, idx * 7 + 1) != NULL) {
+            return 8;
+        }
+    }
+    // Check that replace swaps the member in place
+    if (cgre_hash_list_replace(&list, &swap) != &(items[20]) ||
+            cgre_hash_list_search(&list, 7 * 20) != &swap) {
+        return 16;
+    }
+    // Check that deletes only remove their own key
+    for (cgre_uint_t idx = 1; idx < total; idx += 2) {
+        if (cgre_hash_list_delete(&list, idx * 7) != &(items[idx])) {
+            return 32;
+        }
+    }
+    if (cgre_hash_list_delete(&list, 7) != NULL ||
+            list.count != total - (total >> 1)) {
+        return 64;
+    }
+    for (cgre_uint_t idx = 0; idx < total; idx += 2) {
+        if (cgre_hash_list_search(&list, idx * 7) == NULL) {
+            return 128;
+        }
+    }
+    if (cgre_node_set_uninitialize(&list) == NULL || list.store != NULL) {
+        return 256;
+    }
+    free(items);
+    return 0;
+}
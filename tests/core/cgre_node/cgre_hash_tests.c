@@ -0,0 +1,127 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HASH_NAMES 100000
+
+int cgre_hash_bytes_tests();
+int cgre_hash_avalanche_tests();
+int cgre_hash_collision_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+            cgre_hash_bytes_tests() |  // Error 1
+            cgre_hash_avalanche_tests() | // Error 2
+            cgre_hash_collision_tests() // Error 4
+   );
+}
+
+int cgre_hash_bytes_tests()
+{
+    unsigned char bytes[256];
+    uint64_t seen[257];
+    for (int idx = 0; idx < 256; idx++) {
+        bytes[idx] = (unsigned char) idx;
+    }
+    if (cgre_hash_bytes("cgre", 4, 0) != cgre_hash_bytes("cgre", 4, 0) ||
+            cgre_hash_bytes("cgre", 4, 0) == cgre_hash_bytes("cgre", 4, 1) ||
+            cgre_hash("cgre") != (cgre_uint_t) cgre_hash_bytes("cgre", 4, 0)) {
+        return 1;
+    }
+    // Every prefix of the same bytes hashes apart, embedded NULs included
+    for (int length = 0; length <= 256; length++) {
+        seen[length] = cgre_hash_bytes(bytes, length, 0);
+        for (int other = 0; other < length; other++) {
+            if (seen[other] == seen[length]) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int cgre_hash_avalanche_tests()
+{
+    unsigned char bytes[100];
+    uint64_t flipped = 0, trials = 0;
+    memset(bytes, 'a', sizeof(bytes));
+    // Lengths hitting each branch of the hash
+    const int lengths[] = {1, 3, 4, 8, 13, 16, 17, 40, 48, 49, 100};
+    for (int test = 0; test < (int) (sizeof(lengths) / sizeof(int)); test++) {
+        int length = lengths[test];
+        uint64_t base = cgre_hash_bytes(bytes, length, 0);
+        for (int bit = 0; bit < length * 8; bit++) {
+            bytes[bit >> 3] ^= (unsigned char) (1 << (bit & 7));
+            flipped += __builtin_popcountll(
+                    base ^ cgre_hash_bytes(bytes, length, 0));
+            trials++;
+            bytes[bit >> 3] ^= (unsigned char) (1 << (bit & 7));
+        }
+    }
+    // A flipped input bit should flip close to half the output bits
+    if (flipped < trials * 30 || flipped > trials * 34) {
+        return 2;
+    }
+    return 0;
+}
+
+int cgre_hash_compare(const void* first, const void* second)
+{
+    uint64_t a = *(const uint64_t*) first, b = *(const uint64_t*) second;
+    return (a > b) - (a < b);
+}
+
+int cgre_hash_collision_tests()
+{
+    char name[32];
+    uint64_t* hashes = malloc(sizeof(uint64_t) * HASH_NAMES);
+    if (hashes == NULL) {
+        return 4;
+    }
+    // Names that differ in a character or two, as scene names do
+    for (int idx = 0; idx < HASH_NAMES; idx++) {
+        int length = snprintf(name, sizeof(name), "node%d", idx);
+        hashes[idx] = cgre_hash_bytes(name, length, 0);
+    }
+    qsort(hashes, HASH_NAMES, sizeof(uint64_t), cgre_hash_compare);
+    for (int idx = 1; idx < HASH_NAMES; idx++) {
+        if (hashes[idx] == hashes[idx - 1]) {
+            free(hashes);
+            return 4;
+        }
+    }
+    free(hashes);
+    return 0;
+}
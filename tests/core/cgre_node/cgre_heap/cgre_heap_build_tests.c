@@ -0,0 +1,97 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+#define HEAP_BUILD_MEMBERS 1000
+
+int cgre_heap_build_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_heap_build_tests()
+    );
+}
+
+int cgre_heap_build_tests()
+{
+    struct cgre_node_set heap;
+    cgre_node_set_initialize(&heap);
+    struct cgre_node* items = malloc(
+            sizeof(struct cgre_node) * HEAP_BUILD_MEMBERS);
+    struct cgre_node** nodes = malloc(
+            sizeof(struct cgre_node*) * HEAP_BUILD_MEMBERS);
+    srand(21);
+    for (cgre_uint_t idx = 0; idx < HEAP_BUILD_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), (cgre_uint_t) rand() % 300 + 1,
+                NULL);
+        nodes[idx] = &(items[idx]);
+    }
+    // Check that every size builds a valid heap
+    for (cgre_uint_t count = 0; count <= 40; count++) {
+        if (cgre_heap_build(&heap, nodes, count) != &heap ||
+                heap.count != count) {
+            return 1;
+        }
+        cgre_uint_t last = 0;
+        for (cgre_uint_t idx = 0; idx < count; idx++) {
+            struct cgre_node* popped = cgre_heap_pop(&heap);
+            if (popped == NULL || popped->key < last) {
+                return 2;
+            }
+            last = popped->key;
+        }
+    }
+    // Check that only an empty heap is built
+    if (cgre_heap_build(&heap, nodes, HEAP_BUILD_MEMBERS) != &heap ||
+            cgre_heap_build(&heap, nodes, 1) != NULL) {
+        return 4;
+    }
+    // Check that built members can be decreased and popped in order
+    if (cgre_heap_decrease(&heap, &(items[HEAP_BUILD_MEMBERS - 1]), 0) !=
+            &(items[HEAP_BUILD_MEMBERS - 1]) ||
+            cgre_heap_pop(&heap) != &(items[HEAP_BUILD_MEMBERS - 1])) {
+        return 8;
+    }
+    cgre_uint_t last = 0;
+    for (cgre_uint_t idx = 1; idx < HEAP_BUILD_MEMBERS; idx++) {
+        struct cgre_node* popped = cgre_heap_pop(&heap);
+        if (popped == NULL || popped->key < last) {
+            return 16;
+        }
+        last = popped->key;
+    }
+    cgre_node_set_uninitialize(&heap);
+    free(nodes);
+    free(items);
+    return 0;
+}
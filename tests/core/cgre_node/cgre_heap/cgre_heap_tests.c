@@ -0,0 +1,109 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+#define HEAP_MEMBERS 2000
+
+int cgre_heap_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_heap_tests()
+    );
+}
+
+int cgre_heap_tests()
+{
+    struct cgre_node_set heap;
+    cgre_node_set_initialize(&heap);
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * HEAP_MEMBERS);
+    struct cgre_node outsider;
+    cgre_node_initialize(&outsider, 0, NULL);
+    // Check that an empty heap has nothing to give
+    if (cgre_heap_peek(&heap) != NULL || cgre_heap_pop(&heap) != NULL) {
+        return 1;
+    }
+    // Check that pushes with repeated keys keep the smallest on top
+    srand(20);
+    cgre_uint_t smallest = (cgre_uint_t) -1;
+    for (cgre_uint_t idx = 0; idx < HEAP_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), (cgre_uint_t) rand() % 5000,
+                NULL);
+        if (items[idx].key < smallest) {
+            smallest = items[idx].key;
+        }
+        if (cgre_heap_push(&heap, &(items[idx])) != &(items[idx]) ||
+                cgre_heap_peek(&heap)->key != smallest) {
+            return 2;
+        }
+    }
+    if (heap.count != HEAP_MEMBERS) {
+        return 4;
+    }
+    // Check that decrease only accepts members going down
+    struct cgre_node* member = &(items[HEAP_MEMBERS / 2]);
+    if (cgre_heap_decrease(&heap, &outsider, 0) != NULL ||
+            cgre_heap_decrease(&heap, member, member->key + 1) != NULL ||
+            cgre_heap_decrease(&heap, member, 0) != member ||
+            cgre_heap_peek(&heap)->key != 0) {
+        return 8;
+    }
+    // Check that decreases anywhere keep the order
+    for (cgre_uint_t idx = 0; idx < HEAP_MEMBERS; idx += 7) {
+        cgre_heap_decrease(&heap, &(items[idx]), items[idx].key >> 1);
+    }
+    // Check that pops come out in key order and empty the heap
+    cgre_uint_t last = 0;
+    for (cgre_uint_t idx = 0; idx < HEAP_MEMBERS; idx++) {
+        struct cgre_node* popped = cgre_heap_pop(&heap);
+        if (popped == NULL || popped->key < last) {
+            return 16;
+        }
+        last = popped->key;
+    }
+    if (heap.count != 0 || cgre_heap_pop(&heap) != NULL ||
+            cgre_heap_decrease(&heap, member, 0) != NULL) {
+        return 32;
+    }
+    // Check that pops and pushes can interleave
+    for (cgre_uint_t idx = 0; idx < HEAP_MEMBERS; idx++) {
+        items[idx].key = HEAP_MEMBERS - idx;
+        cgre_heap_push(&heap, &(items[idx]));
+        if ((idx & 1) && cgre_heap_pop(&heap) != &(items[idx])) {
+            return 64;
+        }
+    }
+    cgre_node_set_uninitialize(&heap);
+    free(items);
+    return 0;
+}
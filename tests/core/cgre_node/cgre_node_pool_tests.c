@@ -0,0 +1,222 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#define POOL_NODES 5000
+#define POOL_THREADS 4
+
+int cgre_node_pool_alloc_tests();
+int cgre_node_pool_free_tests();
+int cgre_node_pool_thread_tests();
+int cgre_node_pool_exit_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+            cgre_node_pool_alloc_tests() |  // Error 1
+            cgre_node_pool_free_tests() | // Error 2
+            cgre_node_pool_thread_tests() | // Error 4
+            cgre_node_pool_exit_tests() // Error 8
+   );
+}
+
+int cgre_node_pool_compare(const void* first, const void* second)
+{
+    const struct cgre_node* a = *(const struct cgre_node* const*) first;
+    const struct cgre_node* b = *(const struct cgre_node* const*) second;
+    return (a > b) - (a < b);
+}
+
+int cgre_node_pool_alloc_tests()
+{
+    int i;
+    struct cgre_node_pool pool;
+    struct cgre_node_set tree;
+    struct cgre_node** nodes = malloc(sizeof(struct cgre_node*) * POOL_NODES);
+    if (cgre_node_pool_initialize(&pool) != &pool) {
+        return 1;
+    }
+    cgre_node_set_initialize(&tree);
+    // Check that nodes come out initialized and usable as members
+    for (cgre_uint_t idx = 0; idx < POOL_NODES; idx++) {
+        nodes[idx] = cgre_node_pool_alloc(&pool, idx, &i);
+        if (nodes[idx] == NULL || nodes[idx]->key != idx ||
+                nodes[idx]->value != &i || nodes[idx]->link[0] != NULL ||
+                nodes[idx]->link[1] != NULL ||
+                cgre_tree_insert(&tree, nodes[idx]) != nodes[idx]) {
+            return 1;
+        }
+    }
+    // Check that consecutive nodes are neighbours in memory
+    if (nodes[1] != nodes[0] + 1) {
+        return 1;
+    }
+    // Check that no node was handed out twice
+    qsort(nodes, POOL_NODES, sizeof(struct cgre_node*), cgre_node_pool_compare);
+    for (cgre_uint_t idx = 1; idx < POOL_NODES; idx++) {
+        if (nodes[idx] == nodes[idx - 1]) {
+            return 1;
+        }
+    }
+    // Check that the pool releases the members of a set in bulk
+    if (cgre_node_set_uninitialize(&tree) != &tree ||
+            cgre_node_pool_uninitialize(&pool) != &pool ||
+            pool.store != NULL) {
+        return 1;
+    }
+    free(nodes);
+    return 0;
+}
+
+int cgre_node_pool_free_tests()
+{
+    struct cgre_node_pool pool;
+    struct cgre_node** nodes = malloc(sizeof(struct cgre_node*) * POOL_NODES);
+    cgre_node_pool_initialize(&pool);
+    for (cgre_uint_t idx = 0; idx < POOL_NODES; idx++) {
+        nodes[idx] = cgre_node_pool_alloc(&pool, idx, NULL);
+    }
+    // Check that released nodes are handed out again before new slabs
+    struct cgre_node_store* slabs = pool.store;
+    for (cgre_uint_t idx = 0; idx < POOL_NODES; idx++) {
+        cgre_node_pool_free(&pool, nodes[idx]);
+    }
+    for (cgre_uint_t idx = 0; idx < POOL_NODES; idx++) {
+        if (cgre_node_pool_alloc(&pool, idx, NULL) == NULL) {
+            return 2;
+        }
+    }
+    if (pool.store != slabs || pool.state != 0) {
+        return 2;
+    }
+    // Check that a new pool at the same address starts clean
+    cgre_node_pool_uninitialize(&pool);
+    cgre_node_pool_initialize(&pool);
+    if (cgre_node_pool_alloc(&pool, 1, NULL) == NULL ||
+            pool.store == NULL || pool.store->used == 0) {
+        return 2;
+    }
+    cgre_node_pool_uninitialize(&pool);
+    free(nodes);
+    return 0;
+}
+
+struct pool_work {
+    struct cgre_node_pool* pool;
+    struct cgre_node_set* queue;
+    cgre_uint_t errors;
+};
+
+static void* pool_worker(void* argument)
+{
+    struct pool_work* work = argument;
+    // Nodes are freed by whichever thread pops them, not their allocator
+    for (cgre_uint_t idx = 0; idx < POOL_NODES; idx++) {
+        struct cgre_node* node = cgre_node_pool_alloc(work->pool, idx, NULL);
+        if (node == NULL || cgre_queue_push(work->queue, node) != node) {
+            work->errors++;
+        }
+        if (idx & 1) {
+            node = cgre_queue_pop(work->queue);
+            if (node == NULL) {
+                work->errors++;
+            } else {
+                cgre_node_pool_free(work->pool, node);
+            }
+        }
+    }
+    return NULL;
+}
+
+int cgre_node_pool_thread_tests()
+{
+    struct cgre_node_pool pool;
+    struct cgre_node_set queue;
+    struct pool_work work[POOL_THREADS];
+    pthread_t threads[POOL_THREADS];
+    cgre_uint_t errors = 0;
+    cgre_node_pool_initialize(&pool);
+    cgre_node_set_initialize(&queue);
+    for (cgre_uint_t idx = 0; idx < POOL_THREADS; idx++) {
+        work[idx].pool = &pool;
+        work[idx].queue = &queue;
+        work[idx].errors = 0;
+        pthread_create(&(threads[idx]), NULL, pool_worker, &(work[idx]));
+    }
+    for (cgre_uint_t idx = 0; idx < POOL_THREADS; idx++) {
+        pthread_join(threads[idx], NULL);
+        errors += work[idx].errors;
+    }
+    if (errors || queue.count != POOL_THREADS * POOL_NODES / 2) {
+        return 4;
+    }
+    cgre_node_set_uninitialize(&queue);
+    cgre_node_pool_uninitialize(&pool);
+    return 0;
+}
+
+static void* pool_visitor(void* argument)
+{
+    struct cgre_node_pool* pool = argument;
+    struct cgre_node* nodes[10];
+    for (cgre_uint_t idx = 0; idx < 10; idx++) {
+        nodes[idx] = cgre_node_pool_alloc(pool, idx, NULL);
+    }
+    for (cgre_uint_t idx = 0; idx < 10; idx++) {
+        cgre_node_pool_free(pool, nodes[idx]);
+    }
+    return NULL;
+}
+
+int cgre_node_pool_exit_tests()
+{
+    struct cgre_node_pool pool;
+    pthread_t thread;
+    cgre_node_pool_initialize(&pool);
+    // Check that an exiting thread hands its whole magazine back
+    for (cgre_uint_t round = 0; round < 8; round++) {
+        pthread_create(&thread, NULL, pool_visitor, &pool);
+        pthread_join(thread, NULL);
+        cgre_uint_t count = 0;
+        for (struct cgre_node* node = pool.free; node != NULL;
+                node = node->link[0]) {
+            count++;
+        }
+        if (count != CGRE_NODE_POOL_MAGAZINE ||
+                pool.store->next != NULL) {
+            return 8;
+        }
+    }
+    cgre_node_pool_uninitialize(&pool);
+    return 0;
+}
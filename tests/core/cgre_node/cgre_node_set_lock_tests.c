@@ -0,0 +1,116 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+
+#define LOCK_THREADS 4
+#define LOCK_ROUNDS 100000
+
+int cgre_node_set_lock_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_node_set_lock_tests()
+    );
+}
+
+struct lock_worker {
+    struct cgre_node_set* set;
+    cgre_uint_t* counter;
+};
+
+void* lock_worker_run(void* arg)
+{
+    struct lock_worker* worker = (struct lock_worker*) arg;
+    for (cgre_uint_t idx = 0; idx < LOCK_ROUNDS; idx++) {
+        cgre_node_set_lock(worker->set);
+        // Not atomic, only the lock keeps the count right
+        *(worker->counter) = *(worker->counter) + 1;
+        cgre_node_set_unlock(worker->set);
+    }
+    return NULL;
+}
+
+int cgre_node_set_lock_tests()
+{
+    const cgre_uint_t policies[4] = {
+        CGRE_LOCK_MUTEX, CGRE_LOCK_FUTEX, CGRE_LOCK_SPIN, CGRE_LOCK_NONE
+    };
+    struct cgre_node items[3];
+    for (int policy = 0; policy < 4; policy++) {
+        struct cgre_node_set set;
+        // Check that the policy is kept next to the collection mode
+        if (cgre_node_set_initialize_lock(&set, policies[policy]) != &set ||
+                CGRE_NODES_LOCK(set.state) ||
+                CGRE_NODES_MODE(set.state) != 0) {
+            return 1;
+        }
+        if (policies[policy] != CGRE_LOCK_MUTEX &&
+                CGRE_NODES_LOCK_POLICY(set.state) != policies[policy]) {
+            return 1;
+        }
+        // Check that collections work under every policy
+        CGRE_NODES_MODE_SET_VALUE(set.state, CGRE_HASH_LIST_TABLE);
+        for (cgre_uint_t idx = 0; idx < 3; idx++) {
+            cgre_node_initialize(&(items[idx]), idx, NULL);
+            cgre_hash_list_insert(&set, &(items[idx]));
+        }
+        if (cgre_hash_list_search(&set, 1) != &(items[1]) ||
+                cgre_hash_list_delete(&set, 1) != &(items[1]) ||
+                cgre_hash_list_search(&set, 1) != NULL ||
+                CGRE_NODES_LOCK(set.state)) {
+            return 2;
+        }
+        if (cgre_node_set_uninitialize(&set) != &set) {
+            return 4;
+        }
+        if (policies[policy] == CGRE_LOCK_NONE) {
+            continue;
+        }
+        // Check that threads take turns
+        cgre_uint_t counter = 0;
+        struct lock_worker worker = {&set, &counter};
+        pthread_t threads[LOCK_THREADS];
+        cgre_node_set_initialize_lock(&set, policies[policy]);
+        for (int thread = 0; thread < LOCK_THREADS; thread++) {
+            pthread_create(&(threads[thread]), NULL, lock_worker_run, &worker);
+        }
+        for (int thread = 0; thread < LOCK_THREADS; thread++) {
+            pthread_join(threads[thread], NULL);
+        }
+        if (counter != LOCK_THREADS * LOCK_ROUNDS) {
+            return 8;
+        }
+        cgre_node_set_uninitialize(&set);
+    }
+    return 0;
+}
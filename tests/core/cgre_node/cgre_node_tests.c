@@ -33,12 +33,14 @@ SOFTWARE.
 
 int cgre_node_initialize_tests();
 int cgre_node_uninitialize_tests();
+int cgre_node_lock_tests();
 
 int main(int argc, char** argv)
 {
     return (
             cgre_node_initialize_tests() |  // Error 1
-            cgre_node_uninitialize_tests() // Error 2
+            cgre_node_uninitialize_tests() | // Error 2
+            cgre_node_lock_tests() // Error 4
    );
 }
 
@@ -79,3 +81,25 @@ int cgre_node_uninitialize_tests()
     }
     return 0;
 }
+
+int cgre_node_lock_tests()
+{
+    struct cgre_node node1;
+    cgre_node_initialize(&node1, 80, NULL);
+#ifdef CGRE_NODE_COMPACT
+    // Compact nodes pack into 40 bytes on LP64
+    if (sizeof(void*) == 8 && sizeof(struct cgre_node) > 40) {
+        return 4;
+    }
+#else
+    pthread_mutex_init(&(node1.lock), NULL);
+#endif /* ifdef CGRE_NODE_COMPACT */
+    pthread_mutex_t* lock = cgre_node_lock(&node1);
+    // The same node always maps to the same usable mutex
+    if (lock == NULL || cgre_node_lock(&node1) != lock ||
+            pthread_mutex_lock(lock) != 0 ||
+            pthread_mutex_unlock(lock) != 0) {
+        return 4;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+
+int cgre_queue_pop_many_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_queue_pop_many_tests()
+    );
+}
+
+int cgre_queue_pop_many_tests()
+{
+    struct cgre_node_set queue1, queue2;
+    struct cgre_node items[6];
+    struct cgre_node* batch[6];
+    struct cgre_node* popped[8];
+    cgre_node_set_initialize(&queue1);
+    cgre_node_set_initialize(&queue2);
+    cgre_queue_reserve(&queue2, 8);
+    for (cgre_uint_t idx = 0; idx < 6; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+        batch[idx] = &(items[idx]);
+    }
+    // Check first in first out across a batch in both modes
+    struct cgre_node_set* queues[2] = {&queue1, &queue2};
+    for (int mode = 0; mode < 2; mode++) {
+        struct cgre_node_set* queue = queues[mode];
+        if (cgre_queue_pop_many(queue, popped, 8) != 0 ||
+                cgre_queue_push_many(queue, batch, 6) != 6 ||
+                cgre_queue_pop_many(queue, popped, 4) != 4) {
+            return 1;
+        }
+        for (cgre_uint_t idx = 0; idx < 4; idx++) {
+            if (popped[idx] != &(items[idx])) {
+                return 2;
+            }
+        }
+        // Check that only what is queued is popped
+        if (cgre_queue_pop_many(queue, popped, 8) != 2 ||
+                popped[0] != &(items[4]) ||
+                popped[1] != &(items[5]) ||
+                cgre_queue_pop(queue) != NULL) {
+            return 4;
+        }
+    }
+    if (queue1.count != 0) {
+        return 8;
+    }
+    cgre_node_set_uninitialize(&queue1);
+    cgre_node_set_uninitialize(&queue2);
+    return 0;
+}
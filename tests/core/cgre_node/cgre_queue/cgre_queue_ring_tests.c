@@ -0,0 +1,151 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#define RING_THREADS 4
+#define RING_MEMBERS 20000
+
+int cgre_queue_ring_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_queue_ring_tests()
+    );
+}
+
+struct ring_worker {
+    struct cgre_node_set* queue;
+    struct cgre_node* items;
+    cgre_uint_t* seen;
+};
+
+void* ring_producer(void* arg)
+{
+    struct ring_worker* worker = (struct ring_worker*) arg;
+    for (cgre_uint_t idx = 0; idx < RING_MEMBERS; idx++) {
+        while (cgre_queue_push(worker->queue, &(worker->items[idx])) == NULL) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+void* ring_consumer(void* arg)
+{
+    struct ring_worker* worker = (struct ring_worker*) arg;
+    for (cgre_uint_t idx = 0; idx < RING_MEMBERS;) {
+        struct cgre_node* node = cgre_queue_pop(worker->queue);
+        if (node == NULL) {
+            sched_yield();
+            continue;
+        }
+        __atomic_fetch_add(&(worker->seen[node->key]), 1, __ATOMIC_RELAXED);
+        idx++;
+    }
+    return NULL;
+}
+
+int cgre_queue_ring_tests()
+{
+    struct cgre_node_set queue;
+    cgre_node_set_initialize(&queue);
+    struct cgre_node item1;
+    cgre_node_initialize(&item1, 1, NULL);
+    struct cgre_node item2;
+    cgre_node_initialize(&item2, 2, NULL);
+    struct cgre_node item3;
+    cgre_node_initialize(&item3, 3, NULL);
+    // Check that the ring is selected and rounded to 2 cells
+    if (cgre_queue_reserve(&queue, 2) != &queue ||
+            CGRE_QUEUE_MODE(queue.state) != CGRE_QUEUE_RING ||
+            cgre_queue_reserve(&queue, 8) != NULL) {
+        return 1;
+    }
+    // Check first in first out and the full ring
+    if (cgre_queue_peek(&queue) != NULL ||
+            cgre_queue_push(&queue, &item1) != &item1 ||
+            cgre_queue_push(&queue, &item2) != &item2 ||
+            cgre_queue_push(&queue, &item3) != NULL ||
+            cgre_queue_peek(&queue) != &item1) {
+        return 2;
+    }
+    if (cgre_queue_pop(&queue) != &item1 ||
+            cgre_queue_push(&queue, &item3) != &item3 ||
+            cgre_queue_pop(&queue) != &item2 ||
+            cgre_queue_pop(&queue) != &item3 ||
+            cgre_queue_pop(&queue) != NULL) {
+        return 4;
+    }
+    cgre_node_set_uninitialize(&queue);
+    // Check that every member pushed by every producer is popped once
+    struct cgre_node_set shared;
+    cgre_node_set_initialize(&shared);
+    cgre_queue_reserve(&shared, 64);
+    struct cgre_node* items = malloc(
+            sizeof(struct cgre_node) * RING_THREADS * RING_MEMBERS);
+    cgre_uint_t* seen = calloc(RING_THREADS * RING_MEMBERS,
+            sizeof(cgre_uint_t));
+    struct ring_worker workers[RING_THREADS];
+    pthread_t producers[RING_THREADS];
+    pthread_t consumers[RING_THREADS];
+    for (cgre_uint_t idx = 0; idx < RING_THREADS * RING_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+    }
+    for (int thread = 0; thread < RING_THREADS; thread++) {
+        workers[thread].queue = &shared;
+        workers[thread].items = &(items[thread * RING_MEMBERS]);
+        workers[thread].seen = seen;
+        pthread_create(&(consumers[thread]), NULL, ring_consumer,
+                &(workers[thread]));
+        pthread_create(&(producers[thread]), NULL, ring_producer,
+                &(workers[thread]));
+    }
+    for (int thread = 0; thread < RING_THREADS; thread++) {
+        pthread_join(producers[thread], NULL);
+        pthread_join(consumers[thread], NULL);
+    }
+    for (cgre_uint_t idx = 0; idx < RING_THREADS * RING_MEMBERS; idx++) {
+        if (seen[idx] != 1) {
+            return 8;
+        }
+    }
+    if (cgre_queue_pop(&shared) != NULL) {
+        return 16;
+    }
+    cgre_node_set_uninitialize(&shared);
+    free(items);
+    free(seen);
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#define SPSC_MEMBERS 200000
+
+int cgre_queue_spsc_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_queue_spsc_tests()
+    );
+}
+
+struct spsc_worker {
+    struct cgre_node_set* queue;
+    struct cgre_node* items;
+    cgre_uint_t failed;
+};
+
+void* spsc_producer(void* arg)
+{
+    struct spsc_worker* worker = (struct spsc_worker*) arg;
+    struct cgre_node* batch[16];
+    for (cgre_uint_t idx = 0; idx < SPSC_MEMBERS;) {
+        // Alternate single pushes with batches
+        if (idx & 1) {
+            if (cgre_queue_push(worker->queue, &(worker->items[idx])) != NULL) {
+                idx++;
+            } else {
+                sched_yield();
+            }
+            continue;
+        }
+        cgre_uint_t count = 0;
+        for (; count < 16 && idx + count < SPSC_MEMBERS; count++) {
+            batch[count] = &(worker->items[idx + count]);
+        }
+        cgre_uint_t pushed = cgre_queue_push_many(worker->queue, batch,
+                count);
+        if (pushed == 0) {
+            sched_yield();
+        }
+        idx += pushed;
+    }
+    return NULL;
+}
+
+void* spsc_consumer(void* arg)
+{
+    struct spsc_worker* worker = (struct spsc_worker*) arg;
+    struct cgre_node* batch[8];
+    for (cgre_uint_t idx = 0; idx < SPSC_MEMBERS;) {
+        cgre_uint_t popped = cgre_queue_pop_many(worker->queue, batch, 8);
+        if (popped == 0) {
+            sched_yield();
+        }
+        for (cgre_uint_t run = 0; run < popped; run++, idx++) {
+            if (batch[run]->key != idx) {
+                worker->failed = 1;
+            }
+        }
+    }
+    return NULL;
+}
+
+int cgre_queue_spsc_tests()
+{
+    struct cgre_node_set queue;
+    struct cgre_node items[5];
+    struct cgre_node* batch[5];
+    cgre_node_set_initialize(&queue);
+    CGRE_NODES_MODE_SET_VALUE(queue.state, CGRE_QUEUE_SPSC);
+    for (cgre_uint_t idx = 0; idx < 5; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+        batch[idx] = &(items[idx]);
+    }
+    // Check that the mode is kept and the ring rounded to 4 slots
+    if (cgre_queue_reserve(&queue, 3) != &queue ||
+            CGRE_QUEUE_MODE(queue.state) != CGRE_QUEUE_SPSC ||
+            cgre_queue_reserve(&queue, 8) != NULL) {
+        return 1;
+    }
+    // Check first in first out and the full ring
+    if (cgre_queue_peek(&queue) != NULL ||
+            cgre_queue_pop(&queue) != NULL ||
+            cgre_queue_push(&queue, &(items[0])) != &(items[0]) ||
+            cgre_queue_push_many(&queue, &(batch[1]), 4) != 3 ||
+            cgre_queue_push(&queue, &(items[4])) != NULL ||
+            cgre_queue_peek(&queue) != &(items[0])) {
+        return 2;
+    }
+    // Check that slots come back as members leave and the ring wraps
+    if (cgre_queue_pop(&queue) != &(items[0]) ||
+            cgre_queue_pop(&queue) != &(items[1]) ||
+            cgre_queue_push_many(&queue, batch, 5) != 2) {
+        return 4;
+    }
+    struct cgre_node* popped[5];
+    if (cgre_queue_pop_many(&queue, popped, 5) != 4 ||
+            popped[0] != &(items[2]) || popped[1] != &(items[3]) ||
+            popped[2] != &(items[0]) || popped[3] != &(items[1]) ||
+            cgre_queue_peek(&queue) != NULL) {
+        return 8;
+    }
+    cgre_node_set_uninitialize(&queue);
+    // Check that a queue without a ring works locked and a failed reserve
+    // puts it back to locked
+    cgre_node_set_initialize(&queue);
+    CGRE_NODES_MODE_SET_VALUE(queue.state, CGRE_QUEUE_SPSC);
+    if (cgre_queue_push(&queue, &(items[0])) != &(items[0]) ||
+            cgre_queue_reserve(&queue, 4) != NULL ||
+            CGRE_QUEUE_MODE(queue.state) != CGRE_QUEUE_LOCKED ||
+            cgre_queue_pop(&queue) != &(items[0]) ||
+            cgre_queue_reserve(&queue, 0) != NULL ||
+            cgre_queue_pop(&queue) != NULL) {
+        return 32;
+    }
+    cgre_node_set_uninitialize(&queue);
+    // Check that a producer and a consumer thread keep the order
+    struct cgre_node_set shared;
+    cgre_node_set_initialize(&shared);
+    CGRE_NODES_MODE_SET_VALUE(shared.state, CGRE_QUEUE_SPSC);
+    cgre_queue_reserve(&shared, 64);
+    struct cgre_node* members = malloc(sizeof(struct cgre_node) * SPSC_MEMBERS);
+    for (cgre_uint_t idx = 0; idx < SPSC_MEMBERS; idx++) {
+        cgre_node_initialize(&(members[idx]), idx, NULL);
+    }
+    struct spsc_worker worker = {&shared, members, 0};
+    pthread_t producer, consumer;
+    pthread_create(&consumer, NULL, spsc_consumer, &worker);
+    pthread_create(&producer, NULL, spsc_producer, &worker);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    if (worker.failed || cgre_queue_pop(&shared) != NULL) {
+        return 16;
+    }
+    cgre_node_set_uninitialize(&shared);
+    free(members);
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#define SHARD_THREADS 4
+#define SHARD_MEMBERS 4000
+
+int cgre_shard_map_tests();
+int cgre_shard_map_thread_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+            cgre_shard_map_tests() |  // Error 1-64
+            cgre_shard_map_thread_tests() // Error 128
+   );
+}
+
+int cgre_shard_map_tests()
+{
+    struct cgre_shard_map map;
+    struct cgre_node* items = malloc(sizeof(struct cgre_node) * SHARD_MEMBERS);
+    struct cgre_node dupe;
+    cgre_node_initialize(&dupe, 7 * 10, NULL);
+    struct cgre_node swap;
+    cgre_node_initialize(&swap, 7 * 20, NULL);
+    // Check that the shard count is rounded up to a power of 2
+    if (cgre_shard_map_initialize(&map, 5) != &map || map.size != 8 ||
+            cgre_shard_map_uninitialize(&map) != &map ||
+            cgre_shard_map_initialize(&map, 0) != &map ||
+            map.size != CGRE_SHARD_MAP_SIZE) {
+        return 1;
+    }
+    for (cgre_uint_t idx = 0; idx < SHARD_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), idx * 7, NULL);
+        if (cgre_shard_map_insert(&map, &(items[idx])) != &(items[idx])) {
+            return 2;
+        }
+    }
+    // Check that duplicate key insert is NULL
+    if (cgre_shard_map_insert(&map, &dupe) != NULL) {
+        return 4;
+    }
+    // Check that every member is found and missing keys are not
+    for (cgre_uint_t idx = 0; idx < SHARD_MEMBERS; idx++) {
+        if (cgre_shard_map_search(&map, idx * 7) != &(items[idx]) ||
+                cgre_shard_map_search(&map, idx * 7 + 1) != NULL) {
+            return 8;
+        }
+    }
+    // Check that replace swaps the member in place
+    if (cgre_shard_map_replace(&map, &swap) != &(items[20]) ||
+            cgre_shard_map_search(&map, 7 * 20) != &swap) {
+        return 16;
+    }
+    // Check that deletes only remove their own key
+    for (cgre_uint_t idx = 1; idx < SHARD_MEMBERS; idx += 2) {
+        if (cgre_shard_map_delete(&map, idx * 7) != &(items[idx]) ||
+                cgre_shard_map_delete(&map, idx * 7) != NULL) {
+            return 32;
+        }
+    }
+    for (cgre_uint_t idx = 2; idx < SHARD_MEMBERS; idx += 2) {
+        if (idx != 20 && cgre_shard_map_search(&map, idx * 7) != &(items[idx])) {
+            return 32;
+        }
+    }
+    if (map.state != 0 || cgre_shard_map_uninitialize(&map) != &map ||
+            map.shard != NULL) {
+        return 64;
+    }
+    free(items);
+    return 0;
+}
+
+struct shard_work {
+    struct cgre_shard_map* map;
+    struct cgre_node* items;
+    cgre_uint_t first;
+    cgre_uint_t errors;
+};
+
+static void* shard_worker(void* argument)
+{
+    struct shard_work* work = argument;
+    // Each thread owns a slice of keys spread over every shard
+    for (cgre_uint_t idx = 0; idx < SHARD_MEMBERS; idx++) {
+        struct cgre_node* node = &(work->items[idx]);
+        cgre_node_initialize(node, idx * SHARD_THREADS + work->first, NULL);
+        work->errors += cgre_shard_map_insert(work->map, node) != node;
+    }
+    for (cgre_uint_t idx = 0; idx < SHARD_MEMBERS; idx += 2) {
+        work->errors += cgre_shard_map_delete(work->map,
+                idx * SHARD_THREADS + work->first) != &(work->items[idx]);
+    }
+    return NULL;
+}
+
+int cgre_shard_map_thread_tests()
+{
+    struct cgre_shard_map map;
+    struct shard_work work[SHARD_THREADS];
+    pthread_t threads[SHARD_THREADS];
+    struct cgre_node* items = malloc(
+            sizeof(struct cgre_node) * SHARD_MEMBERS * SHARD_THREADS);
+    cgre_uint_t errors = 0;
+    cgre_shard_map_initialize(&map, 4);
+    for (cgre_uint_t idx = 0; idx < SHARD_THREADS; idx++) {
+        work[idx].map = &map;
+        work[idx].items = &(items[idx * SHARD_MEMBERS]);
+        work[idx].first = idx;
+        work[idx].errors = 0;
+        pthread_create(&(threads[idx]), NULL, shard_worker, &(work[idx]));
+    }
+    for (cgre_uint_t idx = 0; idx < SHARD_THREADS; idx++) {
+        pthread_join(threads[idx], NULL);
+        errors += work[idx].errors;
+    }
+    // Only the odd members of every slice remain
+    for (cgre_uint_t idx = 0; idx < SHARD_MEMBERS * SHARD_THREADS; idx++) {
+        struct cgre_node* found = cgre_shard_map_search(&map, idx);
+        cgre_uint_t slice = idx % SHARD_THREADS;
+        struct cgre_node* expected = (idx / SHARD_THREADS) & 1 ?
+            &(items[slice * SHARD_MEMBERS + idx / SHARD_THREADS]) : NULL;
+        errors += found != expected;
+    }
+    cgre_shard_map_uninitialize(&map);
+    free(items);
+    return errors ? 128 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#define TREIBER_THREADS 4
+#define TREIBER_MEMBERS 64
+#define TREIBER_ROUNDS 50000
+
+int cgre_stack_treiber_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_stack_treiber_tests()
+    );
+}
+
+void* treiber_churn(void* arg)
+{
+    struct cgre_node_set* stack = (struct cgre_node_set*) arg;
+    // Borrow and return members like a shared free list
+    for (int round = 0; round < TREIBER_ROUNDS; round++) {
+        struct cgre_node* first = cgre_stack_pop(stack);
+        struct cgre_node* second = cgre_stack_pop(stack);
+        if (first != NULL) {
+            cgre_stack_push(stack, first);
+        }
+        if (second != NULL) {
+            cgre_stack_push(stack, second);
+        }
+    }
+    return NULL;
+}
+
+int cgre_stack_treiber_tests()
+{
+    struct cgre_node_set stack;
+    cgre_node_set_initialize(&stack);
+    CGRE_NODES_MODE_SET_VALUE(stack.state, CGRE_STACK_TREIBER);
+    struct cgre_node items[TREIBER_MEMBERS];
+    int seen[TREIBER_MEMBERS] = { 0 };
+    pthread_t threads[TREIBER_THREADS];
+    for (int idx = 0; idx < TREIBER_MEMBERS; idx++) {
+        cgre_node_initialize(&(items[idx]), idx, NULL);
+    }
+    // Check last in first out and the empty stack
+    if (cgre_stack_peek(&stack) != NULL ||
+            cgre_stack_push(&stack, &(items[0])) != &(items[0]) ||
+            cgre_stack_push(&stack, &(items[1])) != &(items[1]) ||
+            cgre_stack_peek(&stack) != &(items[1])) {
+        return 1;
+    }
+    // Check that only the forward link is written
+    if (items[1].link[CGRE_NODE_TAIL] != &(items[0]) ||
+            items[0].link[CGRE_NODE_HEAD] != NULL) {
+        return 2;
+    }
+    if (cgre_stack_pop(&stack) != &(items[1]) ||
+            cgre_stack_pop(&stack) != &(items[0]) ||
+            cgre_stack_pop(&stack) != NULL) {
+        return 4;
+    }
+    // Check that concurrent churn neither loses nor duplicates members
+    for (int idx = 0; idx < TREIBER_MEMBERS; idx++) {
+        cgre_stack_push(&stack, &(items[idx]));
+    }
+    for (int thread = 0; thread < TREIBER_THREADS; thread++) {
+        pthread_create(&(threads[thread]), NULL, treiber_churn, &stack);
+    }
+    for (int thread = 0; thread < TREIBER_THREADS; thread++) {
+        pthread_join(threads[thread], NULL);
+    }
+    for (struct cgre_node* node = cgre_stack_pop(&stack); node != NULL;
+            node = cgre_stack_pop(&stack)) {
+        seen[node->key]++;
+    }
+    for (int idx = 0; idx < TREIBER_MEMBERS; idx++) {
+        if (seen[idx] != 1) {
+            return 8;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+#define BTREE_MEMBERS 100000
+
+int cgre_tree_btree_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_tree_btree_tests()
+    );
+}
+
+int cgre_tree_btree_tests()
+{
+    struct cgre_node_set tree1;
+    struct cgre_node* members;
+    struct cgre_node swap1;
+    cgre_node_set_initialize(&tree1);
+    CGRE_NODES_MODE_SET_VALUE(tree1.state, CGRE_TREE_BTREE);
+    members = malloc(sizeof(struct cgre_node) * BTREE_MEMBERS);
+    if (members == NULL) {
+        return 1;
+    }
+    // Scatter the keys so pages split everywhere
+    for (cgre_uint_t idx = 0; idx < BTREE_MEMBERS; idx++) {
+        cgre_node_initialize(&(members[idx]), idx * 2654435761u, NULL);
+        if (cgre_tree_insert(&tree1, &(members[idx])) != &(members[idx])) {
+            return 2;
+        }
+    }
+    // Existing keys are returned instead of inserted
+    cgre_node_initialize(&swap1, members[7].key, NULL);
+    if (tree1.count != BTREE_MEMBERS ||
+            cgre_tree_insert(&tree1, &swap1) != &(members[7]) ||
+            cgre_tree_replace(&tree1, &swap1) != &(members[7]) ||
+            cgre_tree_search(&tree1, swap1.key) != &swap1 ||
+            cgre_tree_replace(&tree1, &(members[7])) != &swap1) {
+        return 4;
+    }
+    for (cgre_uint_t idx = 0; idx < BTREE_MEMBERS; idx++) {
+        if (cgre_tree_search(&tree1, members[idx].key) != &(members[idx])) {
+            return 8;
+        }
+    }
+    // Delete every odd member, pages merge and borrow
+    for (cgre_uint_t idx = 1; idx < BTREE_MEMBERS; idx += 2) {
+        if (cgre_tree_delete(&tree1, members[idx].key) != &(members[idx])) {
+            return 16;
+        }
+    }
+    for (cgre_uint_t idx = 0; idx < BTREE_MEMBERS; idx++) {
+        struct cgre_node* found = cgre_tree_search(&tree1, members[idx].key);
+        if (found != ((idx & 1) ? NULL : &(members[idx]))) {
+            return 32;
+        }
+    }
+    if (cgre_tree_delete(&tree1, members[1].key) != NULL ||
+            tree1.count != BTREE_MEMBERS / 2) {
+        return 64;
+    }
+    for (cgre_uint_t idx = 0; idx < BTREE_MEMBERS; idx += 2) {
+        cgre_tree_delete(&tree1, members[idx].key);
+    }
+    // An emptied tree takes members again
+    if (tree1.count != 0 || cgre_tree_search(&tree1, members[0].key) != NULL ||
+            cgre_tree_insert(&tree1, &(members[3])) != &(members[3]) ||
+            cgre_tree_search(&tree1, members[3].key) != &(members[3])) {
+        return 128;
+    }
+    cgre_node_set_uninitialize(&tree1);
+    free(members);
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+#define BUILD_MEMBERS 200000
+
+int cgre_tree_build_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_tree_build_tests()
+    );
+}
+
+/*
+ * Black height of a subtree, or -1 when it breaks ordering, has a red child
+ * under a red parent or unequal black heights.
+ */
+cgre_int_t black_height(struct cgre_node* node, cgre_uint_t low,
+        cgre_uint_t high)
+{
+    if (node == NULL) {
+        return 1;
+    }
+    if (node->key < low || node->key > high) {
+        return -1;
+    }
+    for (int side = 0; side < 2; side++) {
+        if (node->dir & CGRE_TREE_RED && node->link[side] != NULL &&
+                node->link[side]->dir & CGRE_TREE_RED) {
+            return -1;
+        }
+    }
+    cgre_int_t left = black_height(node->link[0], low, node->key);
+    cgre_int_t right = black_height(node->link[1], node->key, high);
+    if (left < 0 || left != right) {
+        return -1;
+    }
+    return left + (node->dir & CGRE_TREE_BLACK ? 1 : 0);
+}
+
+int cgre_tree_build_mode_tests(cgre_uint_t mode, struct cgre_node* members,
+        struct cgre_node** order, cgre_uint_t count)
+{
+    struct cgre_node_set tree1;
+    struct cgre_node extra1;
+    cgre_node_set_initialize(&tree1);
+    CGRE_NODES_MODE_SET_VALUE(tree1.state, mode);
+    // Scattered keys, the last member repeats the key of the first
+    for (cgre_uint_t idx = 0; idx < count; idx++) {
+        cgre_node_initialize(&(members[idx]),
+                (idx + 1 == count ? 0 : idx) * 2654435761u, NULL);
+        order[idx] = &(members[idx]);
+    }
+    if (cgre_tree_build(&tree1, order, count) != &tree1 ||
+            tree1.count != count - 1) {
+        return 1;
+    }
+    for (cgre_uint_t idx = 1; idx < count; idx++) {
+        if (order[idx - 1]->key >= order[idx]->key && idx + 1 < count) {
+            return 2;
+        }
+    }
+    if (mode != CGRE_TREE_BTREE &&
+            black_height(tree1.link[CGRE_NODE_HEAD], 0, CGRE_UINT_MAX) < 0) {
+        return 4;
+    }
+    // Either node of the repeated key may be kept
+    for (cgre_uint_t idx = 1; idx + 1 < count; idx++) {
+        if (cgre_tree_search(&tree1, members[idx].key) != &(members[idx])) {
+            return 8;
+        }
+    }
+    // Only empty trees are built
+    if (cgre_tree_build(&tree1, order, 1) != NULL) {
+        return 16;
+    }
+    // A built tree keeps working as usual
+    cgre_node_initialize(&extra1, 5, NULL);
+    if (cgre_tree_insert(&tree1, &extra1) != &extra1 ||
+            cgre_tree_delete(&tree1, members[1].key) != &(members[1]) ||
+            cgre_tree_search(&tree1, 5) != &extra1 ||
+            cgre_tree_lower_bound(&tree1, 1) != &extra1 ||
+            (mode != CGRE_TREE_BTREE &&
+             black_height(tree1.link[CGRE_NODE_HEAD], 0, CGRE_UINT_MAX) < 0)) {
+        return 32;
+    }
+    cgre_node_set_uninitialize(&tree1);
+    return 0;
+}
+
+int cgre_tree_build_tests()
+{
+    struct cgre_node* members = malloc(
+            sizeof(struct cgre_node) * BUILD_MEMBERS);
+    struct cgre_node** order = malloc(
+            sizeof(struct cgre_node*) * BUILD_MEMBERS);
+    struct cgre_node_set tree1;
+    int fail = (members == NULL || order == NULL) ? 64 : 0;
+    // Small trees of every shape
+    for (cgre_uint_t count = 3; !fail && count < 70; count++) {
+        if ((fail = cgre_tree_build_mode_tests(CGRE_TREE_LOCKED, members,
+                        order, count)) == 0) {
+            fail = cgre_tree_build_mode_tests(CGRE_TREE_BTREE, members,
+                    order, count);
+        }
+    }
+    // Large trees sort on threads
+    if (!fail && (fail = cgre_tree_build_mode_tests(CGRE_TREE_LOCKED,
+                    members, order, BUILD_MEMBERS)) == 0) {
+        fail = cgre_tree_build_mode_tests(CGRE_TREE_BTREE, members, order,
+                BUILD_MEMBERS);
+    }
+    // Nothing to build
+    cgre_node_set_initialize(&tree1);
+    if (!fail && (cgre_tree_build(&tree1, NULL, 0) != &tree1 ||
+                tree1.count != 0)) {
+        fail = 128;
+    }
+    cgre_node_set_uninitialize(&tree1);
+    free(members);
+    free(order);
+    return fail;
+}
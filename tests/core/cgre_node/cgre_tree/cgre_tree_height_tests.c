@@ -0,0 +1,117 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <stdlib.h>
+
+#define HEIGHT_MEMBERS 300000
+
+int cgre_tree_height_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_tree_height_tests()
+    );
+}
+
+/*
+ * Black height of a subtree, or -1 when it breaks ordering, has a red child
+ * under a red parent or unequal black heights.
+ */
+cgre_int_t black_height(struct cgre_node* node, cgre_uint_t low,
+        cgre_uint_t high)
+{
+    if (node == NULL) {
+        return 1;
+    }
+    if (node->key < low || node->key > high) {
+        return -1;
+    }
+    for (int side = 0; side < 2; side++) {
+        if (node->dir & CGRE_TREE_RED && node->link[side] != NULL &&
+                node->link[side]->dir & CGRE_TREE_RED) {
+            return -1;
+        }
+    }
+    cgre_int_t left = black_height(node->link[0], low, node->key);
+    cgre_int_t right = black_height(node->link[1], node->key, high);
+    if (left < 0 || left != right) {
+        return -1;
+    }
+    return left + (node->dir & CGRE_TREE_BLACK ? 1 : 0);
+}
+
+int cgre_tree_height_tests()
+{
+    struct cgre_node_set tree1;
+    struct cgre_node* members = malloc(
+            sizeof(struct cgre_node) * HEIGHT_MEMBERS);
+    cgre_node_set_initialize(&tree1);
+    // Check that sorted inserts past 2^18 members stay balanced
+    for (cgre_uint_t idx = 0; idx < HEIGHT_MEMBERS; idx++) {
+        cgre_node_initialize(&(members[idx]), idx, NULL);
+        if (cgre_tree_insert(&tree1, &(members[idx])) != &(members[idx])) {
+            return 1;
+        }
+    }
+    if (tree1.count != HEIGHT_MEMBERS ||
+            black_height(tree1.link[CGRE_NODE_HEAD], 0, CGRE_UINT_MAX) < 0) {
+        return 2;
+    }
+    // Check that deletes keep the tree balanced
+    for (cgre_uint_t idx = 1; idx < HEIGHT_MEMBERS; idx += 2) {
+        if (cgre_tree_delete(&tree1, idx) != &(members[idx])) {
+            return 4;
+        }
+    }
+    // Check that the root itself can be deleted
+    cgre_uint_t key = tree1.link[CGRE_NODE_HEAD]->key;
+    if (cgre_tree_delete(&tree1, key) != &(members[key]) ||
+            cgre_tree_search(&tree1, key) != NULL ||
+            tree1.count != (HEIGHT_MEMBERS >> 1) - 1) {
+        return 4;
+    }
+    if (black_height(tree1.link[CGRE_NODE_HEAD], 0, CGRE_UINT_MAX) < 0) {
+        return 8;
+    }
+    // Check that every remaining member is found
+    cgre_uint_t found = 0;
+    for (cgre_uint_t idx = 0; idx < HEIGHT_MEMBERS; idx++) {
+        if (cgre_tree_search(&tree1, idx) == &(members[idx])) {
+            found++;
+        }
+    }
+    if (found != tree1.count) {
+        return 16;
+    }
+    free(members);
+    return 0;
+}
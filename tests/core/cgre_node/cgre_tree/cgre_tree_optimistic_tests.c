@@ -0,0 +1,112 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+#include <pthread.h>
+
+#define OPTIMISTIC_READERS 4
+#define OPTIMISTIC_ROUNDS 100000
+
+int cgre_tree_optimistic_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_tree_optimistic_tests()
+    );
+}
+
+struct optimistic_reader {
+    struct cgre_node_set* tree;
+    struct cgre_node* first;
+    struct cgre_node* second;
+    int misses;
+};
+
+void* optimistic_read(void* arg)
+{
+    struct optimistic_reader* reader = (struct optimistic_reader*) arg;
+    for (int round = 0; round < OPTIMISTIC_ROUNDS; round++) {
+        struct cgre_node* found = cgre_tree_search(reader->tree, 66);
+        if ((found != reader->first && found != reader->second) ||
+                cgre_tree_search(reader->tree, 55) != NULL) {
+            reader->misses++;
+        }
+    }
+    return NULL;
+}
+
+int cgre_tree_optimistic_tests()
+{
+    struct cgre_node_set tree1;
+    struct cgre_node root1, left1, right1, swap1;
+    struct optimistic_reader readers[OPTIMISTIC_READERS];
+    pthread_t threads[OPTIMISTIC_READERS];
+    cgre_node_set_initialize(&tree1);
+    CGRE_NODES_MODE_SET_VALUE(tree1.state, CGRE_TREE_OPTIMISTIC);
+    cgre_node_initialize(&root1, 44, NULL);
+    cgre_node_initialize(&left1, 33, NULL);
+    cgre_node_initialize(&right1, 66, NULL);
+    cgre_node_initialize(&swap1, 66, NULL);
+    root1.link[0] = &left1;
+    root1.link[1] = &right1;
+    tree1.link[CGRE_NODE_HEAD] = &root1;
+    tree1.count = 3;
+    // Check that lock free searches find members and only members
+    if (cgre_tree_search(&tree1, 44) != &root1 ||
+            cgre_tree_search(&tree1, 33) != &left1 ||
+            cgre_tree_search(&tree1, 66) != &right1 ||
+            cgre_tree_search(&tree1, 55) != NULL) {
+        return 1;
+    }
+    // Check that searches racing a writer never see a torn tree
+    for (int thread = 0; thread < OPTIMISTIC_READERS; thread++) {
+        readers[thread].tree = &tree1;
+        readers[thread].first = &right1;
+        readers[thread].second = &swap1;
+        readers[thread].misses = 0;
+        pthread_create(&(threads[thread]), NULL, optimistic_read,
+                &(readers[thread]));
+    }
+    for (int round = 0; round < OPTIMISTIC_ROUNDS; round++) {
+        cgre_tree_replace(&tree1, (round & 1) ? &right1 : &swap1);
+    }
+    for (int thread = 0; thread < OPTIMISTIC_READERS; thread++) {
+        pthread_join(threads[thread], NULL);
+        if (readers[thread].misses) {
+            return 2;
+        }
+    }
+    // Check that writers leave the sequence even
+    if (tree1.sequence & 1) {
+        return 4;
+    }
+    return 0;
+}
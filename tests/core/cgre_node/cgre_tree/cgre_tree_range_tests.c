@@ -0,0 +1,105 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+
+#define RANGE_MEMBERS 5000
+
+int cgre_tree_range_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_tree_range_tests()
+    );
+}
+
+int cgre_tree_range_mode_tests(cgre_uint_t mode)
+{
+    struct cgre_node_set tree1;
+    struct cgre_node members[RANGE_MEMBERS];
+    struct cgre_node* band[64];
+    cgre_uint_t low, found, seen;
+    cgre_node_set_initialize(&tree1);
+    CGRE_NODES_MODE_SET_VALUE(tree1.state, mode);
+    if (cgre_tree_range(&tree1, 0, 100, band, 64) != 0 ||
+            cgre_tree_lower_bound(&tree1, 0) != NULL) {
+        return 1;
+    }
+    // Keys 0, 3, 6, ... inserted out of order
+    for (cgre_uint_t idx = 0; idx < RANGE_MEMBERS; idx++) {
+        cgre_uint_t key = ((idx * 7919) % RANGE_MEMBERS) * 3;
+        cgre_node_initialize(&(members[idx]), key, NULL);
+        cgre_tree_insert(&tree1, &(members[idx]));
+    }
+    if (cgre_tree_lower_bound(&tree1, 4)->key != 6 ||
+            cgre_tree_lower_bound(&tree1, 6)->key != 6 ||
+            cgre_tree_upper_bound(&tree1, 6)->key != 9 ||
+            cgre_tree_upper_bound(&tree1, (RANGE_MEMBERS - 1) * 3) != NULL ||
+            cgre_tree_upper_bound(&tree1, CGRE_UINT_MAX) != NULL) {
+        return 2;
+    }
+    // Stream a band through a small buffer
+    low = 100;
+    seen = 0;
+    do {
+        found = cgre_tree_range(&tree1, low, 3001, band, 64);
+        for (cgre_uint_t idx = 0; idx < found; idx++) {
+            if (band[idx]->key != 102 + seen * 3) {
+                return 4;
+            }
+            seen++;
+        }
+        if (found > 0) {
+            low = band[found - 1]->key + 1;
+        }
+    } while (found == 64);
+    if (seen != (3000 - 102) / 3 + 1) {
+        return 8;
+    }
+    // Empty and inverted bands
+    if (cgre_tree_range(&tree1, 7, 9, band, 64) != 0 ||
+            cgre_tree_range(&tree1, 9, 9, band, 64) != 0 ||
+            cgre_tree_range(&tree1, 90, 9, band, 64) != 0) {
+        return 16;
+    }
+    cgre_node_set_uninitialize(&tree1);
+    return 0;
+}
+
+int cgre_tree_range_tests()
+{
+    int fail;
+    if ((fail = cgre_tree_range_mode_tests(CGRE_TREE_LOCKED)) ||
+            (fail = cgre_tree_range_mode_tests(CGRE_TREE_BTREE))) {
+        return fail;
+    }
+    return 0;
+}
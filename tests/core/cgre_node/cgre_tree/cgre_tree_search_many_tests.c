@@ -0,0 +1,93 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+
+#define MANY_MEMBERS 1000
+
+int cgre_tree_search_many_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_tree_search_many_tests()
+    );
+}
+
+int cgre_tree_search_many_mode_tests(cgre_uint_t mode)
+{
+    struct cgre_node_set tree1;
+    struct cgre_node members[MANY_MEMBERS];
+    struct cgre_node* found[MANY_MEMBERS * 2 + 3];
+    cgre_uint_t keys[MANY_MEMBERS * 2 + 3];
+    cgre_node_set_initialize(&tree1);
+    CGRE_NODES_MODE_SET_VALUE(tree1.state, mode);
+    // Misses on an empty tree
+    keys[0] = 4;
+    found[0] = &(members[0]);
+    if (cgre_tree_search_many(&tree1, keys, found, 1) != 0 ||
+            found[0] != NULL) {
+        return 1;
+    }
+    // Even keys are members
+    for (cgre_uint_t idx = 0; idx < MANY_MEMBERS; idx++) {
+        cgre_node_initialize(&(members[idx]), idx * 2, NULL);
+        cgre_tree_insert(&tree1, &(members[idx]));
+    }
+    // Ask for every key from the top down, an odd count leaves a short group
+    for (cgre_uint_t idx = 0; idx < MANY_MEMBERS * 2 + 3; idx++) {
+        keys[idx] = MANY_MEMBERS * 2 + 2 - idx;
+    }
+    if (cgre_tree_search_many(&tree1, keys, found, MANY_MEMBERS * 2 + 3) !=
+            MANY_MEMBERS) {
+        return 2;
+    }
+    for (cgre_uint_t idx = 0; idx < MANY_MEMBERS * 2 + 3; idx++) {
+        struct cgre_node* expect = NULL;
+        if ((keys[idx] & 1) == 0 && keys[idx] < MANY_MEMBERS * 2) {
+            expect = &(members[keys[idx] / 2]);
+        }
+        if (found[idx] != expect) {
+            return 4;
+        }
+    }
+    cgre_node_set_uninitialize(&tree1);
+    return 0;
+}
+
+int cgre_tree_search_many_tests()
+{
+    int fail;
+    if ((fail = cgre_tree_search_many_mode_tests(CGRE_TREE_LOCKED)) ||
+            (fail = cgre_tree_search_many_mode_tests(CGRE_TREE_BTREE))) {
+        return fail;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+===============================================================================
+
+This source file is part of CGRE
+    (C Graphics Rendering Engine)
+CGRE is made available under the MIT License.
+
+Copyright (c) 2016-2017 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <cgre/cgre.h>
+
+#define SELECT_MEMBERS 3000
+
+int cgre_tree_select_tests();
+
+int main(int argc, char** argv)
+{
+    return (
+        cgre_tree_select_tests()
+    );
+}
+
+int cgre_tree_select_check(
+        struct cgre_node_set* tree,
+        cgre_uint_t* present)
+{
+    cgre_uint_t sorted[SELECT_MEMBERS];
+    cgre_uint_t live = 0;
+    for (cgre_uint_t idx = 0; idx < SELECT_MEMBERS; idx++) {
+        if (present[idx]) {
+            sorted[live++] = idx;
+        }
+    }
+    // Every index finds the member at that position in key order
+    for (cgre_uint_t idx = 0; idx < live; idx++) {
+        struct cgre_node* found = cgre_tree_select(tree, idx);
+        if (found == NULL || found->key != sorted[idx] * 3) {
+            return 1;
+        }
+    }
+    return cgre_tree_select(tree, live) != NULL;
+}
+
+int cgre_tree_select_mode_tests(cgre_uint_t mode, cgre_uint_t ranked)
+{
+    struct cgre_node_set tree1;
+    struct cgre_node members[SELECT_MEMBERS];
+    cgre_uint_t present[SELECT_MEMBERS] = {0};
+    cgre_node_set_initialize(&tree1);
+    CGRE_NODES_MODE_SET_VALUE(tree1.state, mode);
+    tree1.state |= ranked;
+    if (cgre_tree_select_check(&tree1, present)) {
+        return 1;
+    }
+    // Keys 0, 3, 6, ... inserted out of order
+    for (cgre_uint_t idx = 0; idx < SELECT_MEMBERS; idx++) {
+        cgre_uint_t slot = (idx * 7919) % SELECT_MEMBERS;
+        cgre_node_initialize(&(members[slot]), slot * 3, NULL);
+        cgre_tree_insert(&tree1, &(members[slot]));
+        present[slot] = 1;
+    }
+    if (cgre_tree_select_check(&tree1, present)) {
+        return 2;
+    }
+    // Random deletes and reinserts reach every rebalancing case
+    cgre_uint_t seed = 1;
+    for (cgre_uint_t idx = 1; idx <= 8 * SELECT_MEMBERS; idx++) {
+        seed = seed * 1664525u + 1013904223u;
+        cgre_uint_t slot = (seed >> 8) % SELECT_MEMBERS;
+        if (present[slot]) {
+            cgre_tree_delete(&tree1, slot * 3);
+        } else {
+            cgre_tree_insert(&tree1, &(members[slot]));
+        }
+        present[slot] = !present[slot];
+        if (idx % (2 * SELECT_MEMBERS) == 0 &&
+                cgre_tree_select_check(&tree1, present)) {
+            return 4;
+        }
+    }
+    cgre_node_set_uninitialize(&tree1);
+    return 0;
+}
+
+int cgre_tree_select_tests()
+{
+    struct cgre_node_set tree1;
+    struct cgre_node members[SELECT_MEMBERS];
+    struct cgre_node* nodes[SELECT_MEMBERS];
+    cgre_uint_t present[SELECT_MEMBERS];
+    int fail;
+    if ((fail = cgre_tree_select_mode_tests(CGRE_TREE_LOCKED,
+                    CGRE_TREE_RANKED)) ||
+            (fail = cgre_tree_select_mode_tests(CGRE_TREE_LOCKED, 0)) ||
+            (fail = cgre_tree_select_mode_tests(CGRE_TREE_OPTIMISTIC,
+                    CGRE_TREE_RANKED)) ||
+            (fail = cgre_tree_select_mode_tests(CGRE_TREE_BTREE, 0))) {
+        return fail;
+    }
+    // A built tree is ranked from the start
+    cgre_node_set_initialize(&tree1);
+    tree1.state |= CGRE_TREE_RANKED;
+    for (cgre_uint_t idx = 0; idx < SELECT_MEMBERS; idx++) {
+        cgre_node_initialize(&(members[idx]), idx * 3, NULL);
+        nodes[idx] = &(members[idx]);
+        present[idx] = 1;
+    }
+    if (cgre_tree_build(&tree1, nodes, SELECT_MEMBERS) != &tree1 ||
+            cgre_tree_select_check(&tree1, present)) {
+        return 8;
+    }
+    cgre_node_set_uninitialize(&tree1);
+    return 0;
+}